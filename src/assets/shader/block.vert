@@ -7,11 +7,13 @@ layout(location = 3) in int a_textureMask;
 layout(location = 4) in int a_visibilityMask;
 layout(location = 5) in ivec2 a_ambientInfo;
 
-uniform float u_defaultLightLevel;
-uniform int u_numChunks;
-uniform ivec2 u_minChunkCoords;
-uniform mat4 u_projT;
-uniform mat4 u_viewT;
+layout (std140, binding = 0) uniform FrameUniforms
+{
+    mat4 u_projT;
+    mat4 u_viewT;
+    float u_defaultLightLevel;
+    float u_time;
+};
 
 const int CHUNK_WIDTH = 16;
 const int CHUNK_HEIGHT = 256;
@@ -69,8 +71,10 @@ void main()
     // Game Chunk position Data
     v_blockPos = worldCoords;
     v_chunkPos = chunkPos;
-    // Light Data
-    float lightLevel = clamp(u_defaultLightLevel, 0, 15);
+    // Light Data: the face's sky light follows the time of day, its block light does not.
+    int faceLight = (info.lighting[a_ambientInfo.x] >> (16 + (a_ambientInfo.y & 8))) & 0xff;
+    float skyLight = float(faceLight >> 4) * clamp(u_defaultLightLevel, 0, 15) / 15;
+    float lightLevel = max(skyLight, float(faceLight & 15));
     v_colorScalar = (0.6 * lightLevel / 15) + 0.4;
     // Texture Data
     v_norm = a_norm;
@@ -2,8 +2,13 @@
 
 layout (location = 0) in vec3 a_pos;
 
-uniform mat4 u_projT;
-uniform mat4 u_viewT;
+layout (std140, binding = 0) uniform FrameUniforms
+{
+    mat4 u_projT;
+    mat4 u_viewT;
+    float u_defaultLightLevel;
+    float u_time;
+};
 uniform mat4 u_modelT;
 
 void main()
@@ -3,6 +3,7 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include "entity.hpp"
 #include "../../helpers/helpers.hpp"
 
@@ -10,20 +11,38 @@
 namespace Craft
 {
     Entity::Entity(
-            Engine::Timer* timer,
+            EntityStore* entities,
             long double x, long double y, long double z,
             Coordinate2D<int> chunkPos,
             long double front, long double back, long double left, long double right,
-            std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords
+            long double height,
+            ChunkBlockMaps* coords
     )
-            : timer{timer}
-            , coords{coords}
-            , entityX{x}
+            : entityX{x}
             , entityY{y}
             , entityZ{z}
-            , entityBounds{front, back, left, right}
             , originChunk{chunkPos.x, chunkPos.z}
-    {}
+            , entities{entities}
+            , entityBounds{front, back, left, right}
+            , entityHeight{height}
+            , coords{coords}
+    {
+        // The entity collides with the blocks itself, so the store's systems only move it vertically.
+        entityId = entities->createEntity(
+            glm::vec3{(float) getWorldX(), (float) (entityY - entityHeight), (float) getWorldZ()},
+            (float) std::max({front, back, left, right}), (float) entityHeight, MovementState::FLYING, 0
+        );
+    }
+    Entity::~Entity()
+    {
+        entities->destroyEntity(entityId);
+    }
+    void Entity::syncToStore()
+    {
+        entities->setPosition(
+            entityId, glm::vec3{(float) getWorldX(), (float) (entityY - entityHeight), (float) getWorldZ()}
+        );
+    }
 
 
     bool Entity::blockBelowEntity(float angle) {
@@ -36,7 +55,8 @@ namespace Craft
         {
             // If we are falling we return false to keep falling and if we are
             // not then we return true to not start falling.
-            return vertMovement != EntityVertMovementType::FALLING && vertMovement != EntityVertMovementType::FLYING;
+            MovementState movement = getMovement();
+            return movement != MovementState::FALLING && movement != MovementState::FLYING;
         }
         long double rotatedX = ((cos(-angle) * (originBlockZ - entityZ)) + (sin(-angle) * (originBlockX - entityX)) + entityX);
         long double rotatedZ = ((-sin(-angle) * (originBlockZ - entityZ)) + (cos(-angle) * (originBlockX - entityX)) + entityZ);
@@ -50,6 +70,13 @@ namespace Craft
                         {originBlockX, originBlockZ - 1},
                         {originBlockX - 1, originBlockZ - 1},
                 };
+        // Nothing can be below the entity if every column's highest block is beneath its feet.
+        bool columnReachesFeet = false;
+        for (Coordinate2D<int> coord: blocksToCheck)
+        {
+            columnReachesFeet |= highestBlock(getBlockInfo({coord.x, blockY, coord.z}, originChunk), coords) >= blockY;
+        }
+        if (!columnReachesFeet) return false;
         if (
                 rotatedX <= entityX + entityBounds.left &&
                 rotatedX >= entityX - entityBounds.right &&
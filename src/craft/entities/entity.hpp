@@ -9,8 +9,8 @@
 #include <mutex>
 
 #include "../misc/coordinate.hpp"
+#include "entityStore.hpp"
 #include "../worldGeneration/block.hpp"
-#include "../../helpers/timer.hpp"
 #include "../../setup/window.hpp"
 #include "../../setup/program.hpp"
 #include "../misc/globals.hpp"
@@ -19,30 +19,31 @@
 
 namespace Craft
 {
+    /**
+     * An entity with its own collision against the exact blocks around it. Its row of the EntityStore holds its
+     * vertical movement, which the store's systems step along with every other entity, while the entity keeps the
+     * chunk relative position its collision works in and copies it to and from its row.
+     */
     class Entity
     {
     public:
         Entity(
-            Engine::Timer* timer,
+            EntityStore* entities,
             long double x, long double y, long double z,
             Coordinate2D<int> chunkPos,
             long double front, long double back, long double left, long double right,
-            std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords
+            long double height,
+            ChunkBlockMaps* coords
         );
-        ~Entity() = default;
+        ~Entity();
+        Entity(const Entity&) = delete;
+        Entity& operator=(const Entity&) = delete;
         /// The entity's X, Y, and Z coordinates.
         long double entityX,
                     entityY,
                     entityZ;
         /// The origin chunk of this entity.
         Coordinate2D<int> originChunk;
-        /// An enum denoting the various vertical movements.
-        enum class EntityVertMovementType {
-            JUMPING,
-            FALLING,
-            STATIONARY,
-            FLYING
-        };
         /// A struct holding the entity bounds.
         struct EntityBounds{
             long double front;
@@ -59,22 +60,16 @@ namespace Craft
             return (long double) (originChunk.z * 16) + entityZ;
         }
     protected:
-        /// The game timer.
-        Engine::Timer* timer;
-        /// The type of vertical movement the player is experiencing.
-        EntityVertMovementType vertMovement{EntityVertMovementType::FLYING};
+        /// The components of every entity.
+        EntityStore* entities;
+        /// The entity's row of the store.
+        EntityId entityId;
         /// The bounds of the given entity.
         EntityBounds entityBounds;
-        /**
-         * The value of the players initial jump value. Integer since you can only jump from a block.
-         *
-         * NOTE: Will eventually change as stairs and other blocks will have decimal solid surfaces.
-         */
-        float initialJumpHeight{-1};
-        /// The initial fall height of the player. Used for falling with a displacement.
-        long double initialFallHeight{-1};
+        /// The distance from the entity's feet to entityY, the top of its bounds.
+        long double entityHeight;
         /// A mapping of chunk coords to a block placement bitmap for collision.
-        std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords;
+        ChunkBlockMaps* coords;
         /**
          * A function for telling if the players coordinates are on top of a block.
          *
@@ -109,32 +104,6 @@ namespace Craft
          * @return:           A Coordinate2D holding the x and z correction if colliding with another block.
          */
         Coordinate2D<long double> entityCollidedAtCorner(int xDirection, int zDirection);
-        /**
-         * Calculate the Y displacement overtime when falling.
-         *
-         * Equation found at:  https://minecraft.fandom.com/wiki/Transportation#:~:text=Falling%20speed%20is%20more%20complex,from%20%22above%20the%20sky%22.
-         *
-         * @return The current displacement.
-         */
-        inline float calcFallDisplacement()
-        {
-            float elapsedFallTime = timer->lapStopWatch();
-            float x = (elapsedFallTime / 1000);
-            return 392.0f * (0.5f - 0.2f * x - ( 0.5f * pow(49.0f / 50.0f, 20.0f * x)));
-        }
-        /**
-         * An equation that calculates the player's displacement when jumping.
-         *
-         * Allows player to jump 1.25 height in .325 seconds smoothly. Something I just randomly chose.
-         *
-         * @return: The current displacement.
-         */
-        inline float calcJumpDisplacement()
-        {
-            float elapsedFallTime = timer->lapStopWatch();
-            float x = (elapsedFallTime / 1000);
-            return -pow(1.8f, -13.0f * (x - 0.045f)) + 1.4f;
-        }
         /**
          * Calculate the X value given an angle of rotation.
          *
@@ -174,13 +143,24 @@ namespace Craft
             long double z = z1 - z2;
             return sqrt((x * x) + (z * z));
         }
-        /// Helper function to start the falling workflow.
-        inline void startFalling()
+        /// Retrieve the vertical movement of the entity.
+        [[nodiscard]] inline MovementState getMovement() const { return entities->getMovement(entityId); }
+        /**
+         * Start a vertical movement of the entity.
+         *
+         * @param movement: The new vertical movement.
+         * @param startY:   The height of the entity's feet a jump or fall starts from.
+         */
+        inline void startMovement(MovementState movement, long double startY)
         {
-            timer->startStopWatch();
-            vertMovement = EntityVertMovementType::FALLING;
-            initialFallHeight = entityY;
+            entities->startMovement(entityId, movement, (float) startY);
         }
+        /// Helper function to start the falling workflow.
+        inline void startFalling() { startMovement(MovementState::FALLING, entityY - entityHeight); }
+        /// Copy the entity's position to its row of the store.
+        void syncToStore();
+        /// Take the height the store's systems moved the entity to.
+        inline void syncFromStore() { entityY = (long double) entities->getPosition(entityId).y + entityHeight; }
     };
 }
 
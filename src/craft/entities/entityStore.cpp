@@ -0,0 +1,284 @@
+#include <immintrin.h>
+#include <cmath>
+
+#include "entityStore.hpp"
+
+namespace Craft
+{
+    /// The rate of the exponential of the fall curve, 20 * ln(49 / 50).
+    const float FALL_EXP_RATE = -0.404054146f;
+    /// The rate of the exponential of the jump curve, -13 * ln(1.8).
+    const float JUMP_EXP_RATE = -7.641226644f;
+    /// How far the far sides of a bounding box are pulled in, so a box flush against a column does not stand on it.
+    const float FOOTPRINT_INSET = (float) EPSILON;
+
+    /**
+     * Calculate e^x of every lane, accurate to a few float ulps.
+     *
+     * The power is split into 2^n * e^r with |r| <= ln(2) / 2, e^r is a polynomial and 2^n is built in the exponent
+     * bits. Constants from the Cephes library's expf.
+     */
+    static inline __m256 _mm256_exp_ps(__m256 x)
+    {
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f)), _mm256_set1_ps(88.3762626647949f));
+        __m256 n = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f)));
+        // Subtract n * ln(2) in two parts so r keeps its precision.
+        __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+        r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+        __m256 poly = _mm256_set1_ps(1.9875691500E-4f);
+        poly = _mm256_fmadd_ps(poly, r, _mm256_set1_ps(1.3981999507E-3f));
+        poly = _mm256_fmadd_ps(poly, r, _mm256_set1_ps(8.3334519073E-3f));
+        poly = _mm256_fmadd_ps(poly, r, _mm256_set1_ps(4.1665795894E-2f));
+        poly = _mm256_fmadd_ps(poly, r, _mm256_set1_ps(1.6666665459E-1f));
+        poly = _mm256_fmadd_ps(poly, r, _mm256_set1_ps(5.0000001201E-1f));
+        poly = _mm256_fmadd_ps(poly, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+        __m256i power = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23);
+        return _mm256_mul_ps(poly, _mm256_castsi256_ps(power));
+    }
+    /// Gather the height of the ground at the column holding each lane's point.
+    static inline __m256 _mm256_groundHeight_ps(__m256 x, __m256 z, const EntityGround& ground)
+    {
+        __m256i columnX = _mm256_sub_epi32(_mm256_cvttps_epi32(_mm256_floor_ps(x)), _mm256_set1_epi32(ground.originX));
+        __m256i columnZ = _mm256_sub_epi32(_mm256_cvttps_epi32(_mm256_floor_ps(z)), _mm256_set1_epi32(ground.originZ));
+        __m256i width = _mm256_set1_epi32(ground.width);
+        __m256i below = _mm256_set1_epi32(-1);
+        __m256i inside = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(width, columnX), _mm256_cmpgt_epi32(columnX, below)),
+            _mm256_and_si256(_mm256_cmpgt_epi32(width, columnZ), _mm256_cmpgt_epi32(columnZ, below))
+        );
+        // Lanes outside the square are never loaded and keep the ground at y = 0.
+        __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(columnZ, width), columnX);
+        __m256i heights = _mm256_mask_i32gather_epi32(
+            _mm256_setzero_si256(), (const int*) ground.heights.data(), idx, inside, 4
+        );
+        return _mm256_cvtepi32_ps(heights);
+    }
+    /// Gather the height of the ground under each lane's bounding box, the highest of the columns below its corners.
+    static inline __m256 _mm256_footprintGround_ps(__m256 x, __m256 z, __m256 halfWidth, const EntityGround& ground)
+    {
+        __m256 farSide = _mm256_sub_ps(halfWidth, _mm256_set1_ps(FOOTPRINT_INSET));
+        __m256 minX = _mm256_sub_ps(x, halfWidth), maxX = _mm256_add_ps(x, farSide);
+        __m256 minZ = _mm256_sub_ps(z, halfWidth), maxZ = _mm256_add_ps(z, farSide);
+        return _mm256_max_ps(
+            _mm256_max_ps(_mm256_groundHeight_ps(minX, minZ, ground), _mm256_groundHeight_ps(maxX, minZ, ground)),
+            _mm256_max_ps(_mm256_groundHeight_ps(minX, maxZ, ground), _mm256_groundHeight_ps(maxX, maxZ, ground))
+        );
+    }
+    /// Retrieve the lanes whose movement is the given state, as a float mask.
+    static inline __m256 _mm256_isMovement_ps(__m256i movement, MovementState state)
+    {
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(movement, _mm256_set1_epi32((int32_t) state)));
+    }
+    /// Set the movement of the lanes of a float mask.
+    static inline __m256i _mm256_setMovement_epi32(__m256i movement, MovementState state, __m256 mask)
+    {
+        return _mm256_blendv_epi8(movement, _mm256_set1_epi32((int32_t) state), _mm256_castps_si256(mask));
+    }
+
+    void EntityGround::reset(int newOriginX, int newOriginZ, int newWidth)
+    {
+        originX = newOriginX;
+        originZ = newOriginZ;
+        width = newWidth;
+        heights.assign((size_t) newWidth * newWidth, 0);
+    }
+
+    EntityId EntityStore::createEntity(
+        glm::vec3 position,
+        float newHalfWidth,
+        float newHeight,
+        MovementState newMovement,
+        int32_t newFlags
+    )
+    {
+        EntityId id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = (EntityId) rowOfId.size();
+            rowOfId.push_back(INVALID_ENTITY_ID);
+        }
+        size_t row = numRows++;
+        if (numRows > movement.size()) resizeComponents(movement.size() + ENTITY_LANES);
+        rowOfId[id] = (uint32_t) row;
+        idOfRow.push_back(id);
+        posX[row] = position.x;
+        posY[row] = position.y;
+        posZ[row] = position.z;
+        halfWidth[row] = newHalfWidth;
+        height[row] = newHeight;
+        movement[row] = (int32_t) newMovement;
+        movementStartY[row] = position.y;
+        flags[row] = newFlags;
+        return id;
+    }
+    bool EntityStore::destroyEntity(EntityId id)
+    {
+        if (id >= rowOfId.size() || rowOfId[id] == INVALID_ENTITY_ID) return false;
+        size_t row = rowOfId[id], last = numRows - 1;
+        if (row != last)
+        {
+            copyRow(last, row);
+            EntityId movedId = idOfRow[last];
+            idOfRow[row] = movedId;
+            rowOfId[movedId] = (uint32_t) row;
+        }
+        clearRow(last);
+        idOfRow.pop_back();
+        numRows--;
+        rowOfId[id] = INVALID_ENTITY_ID;
+        freeIds.push_back(id);
+        size_t paddedRows = ((numRows + ENTITY_LANES - 1) / ENTITY_LANES) * ENTITY_LANES;
+        if (paddedRows < movement.size()) resizeComponents(paddedRows);
+        return true;
+    }
+    size_t EntityStore::countWithFlags(int32_t flagMask) const
+    {
+        size_t count = 0;
+        for (size_t row=0; row<numRows; row++)
+        {
+            if ((flags[row] & flagMask) == flagMask) count++;
+        }
+        return count;
+    }
+    void EntityStore::startMovement(EntityId id, MovementState state, float startY)
+    {
+        uint32_t row = rowOfId[id];
+        movement[row] = (int32_t) state;
+        movementMillis[row] = 0.0f;
+        movementStartY[row] = startY;
+    }
+    float EntityStore::getCurveHeight(MovementState state, float startY, float millis)
+    {
+        float seconds = millis / 1000;
+        if (state == MovementState::JUMPING) return startY - powf(1.8f, -13.0f * (seconds - 0.045f)) + 1.4f;
+        return startY + 392.0f * (0.5f - 0.2f * seconds - (0.5f * powf(49.0f / 50.0f, 20.0f * seconds)));
+    }
+    void EntityStore::update(float tickMillis, const EntityGround& ground)
+    {
+        const __m256 dt = _mm256_set1_ps(tickMillis);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256i collideFlag = _mm256_set1_epi32(COLLIDE_WITH_GROUND);
+        for (size_t row=0; row<movement.size(); row+=ENTITY_LANES)
+        {
+            __m256 x = _mm256_loadu_ps(&posX[row]);
+            __m256 y = _mm256_loadu_ps(&posY[row]);
+            __m256 z = _mm256_loadu_ps(&posZ[row]);
+            __m256 vx = _mm256_loadu_ps(&velX[row]);
+            __m256 vz = _mm256_loadu_ps(&velZ[row]);
+            __m256 millis = _mm256_loadu_ps(&movementMillis[row]);
+            __m256 startY = _mm256_loadu_ps(&movementStartY[row]);
+            __m256i state = _mm256_loadu_si256((const __m256i*) &movement[row]);
+
+            // Jumps and falls follow their curves of the seconds since they started.
+            __m256 jumping = _mm256_isMovement_ps(state, MovementState::JUMPING);
+            __m256 falling = _mm256_isMovement_ps(state, MovementState::FALLING);
+            millis = _mm256_blendv_ps(millis, _mm256_add_ps(millis, dt), _mm256_or_ps(jumping, falling));
+            __m256 seconds = _mm256_mul_ps(millis, _mm256_set1_ps(0.001f));
+            __m256 fallPower = _mm256_exp_ps(_mm256_mul_ps(seconds, _mm256_set1_ps(FALL_EXP_RATE)));
+            __m256 fallCurve = _mm256_sub_ps(
+                _mm256_fnmadd_ps(_mm256_set1_ps(0.2f), seconds, _mm256_set1_ps(0.5f)),
+                _mm256_mul_ps(_mm256_set1_ps(0.5f), fallPower)
+            );
+            __m256 jumpPower = _mm256_exp_ps(
+                _mm256_mul_ps(_mm256_sub_ps(seconds, _mm256_set1_ps(0.045f)), _mm256_set1_ps(JUMP_EXP_RATE))
+            );
+            __m256 jumpCurve = _mm256_sub_ps(_mm256_set1_ps(1.4f), jumpPower);
+            y = _mm256_blendv_ps(y, _mm256_fmadd_ps(_mm256_set1_ps(392.0f), fallCurve, startY), falling);
+            y = _mm256_blendv_ps(y, _mm256_add_ps(startY, jumpCurve), jumping);
+            // A jump turns into a fall once it reaches its peak.
+            __m256 peakY = _mm256_add_ps(startY, _mm256_set1_ps(JUMP_HEIGHT));
+            __m256 peaked = _mm256_and_ps(jumping, _mm256_cmp_ps(y, peakY, _CMP_GE_OQ));
+            y = _mm256_blendv_ps(y, peakY, peaked);
+            startY = _mm256_blendv_ps(startY, peakY, peaked);
+            millis = _mm256_blendv_ps(millis, zero, peaked);
+            state = _mm256_setMovement_epi32(state, MovementState::FALLING, peaked);
+            // Flying entities move freely up and down.
+            __m256 flying = _mm256_isMovement_ps(state, MovementState::FLYING);
+            y = _mm256_blendv_ps(y, _mm256_fmadd_ps(_mm256_loadu_ps(&velY[row]), dt, y), flying);
+
+            __m256 nextX = _mm256_fmadd_ps(vx, dt, x);
+            __m256 nextZ = _mm256_fmadd_ps(vz, dt, z);
+            __m256i entityFlags = _mm256_loadu_si256((const __m256i*) &flags[row]);
+            __m256 colliding = _mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(_mm256_and_si256(entityFlags, collideFlag), collideFlag)
+            );
+            if (_mm256_movemask_ps(colliding) != 0)
+            {
+                __m256 width = _mm256_loadu_ps(&halfWidth[row]);
+                __m256 groundY = _mm256_footprintGround_ps(nextX, nextZ, width, ground);
+                // A rise higher than a step is a wall, the entity stays put and turns around.
+                __m256 blocked = _mm256_and_ps(
+                    colliding, _mm256_cmp_ps(groundY, _mm256_add_ps(y, _mm256_set1_ps(MAX_STEP_HEIGHT)), _CMP_GT_OQ)
+                );
+                if (_mm256_movemask_ps(blocked) != 0)
+                {
+                    nextX = _mm256_blendv_ps(nextX, x, blocked);
+                    nextZ = _mm256_blendv_ps(nextZ, z, blocked);
+                    vx = _mm256_blendv_ps(vx, _mm256_sub_ps(zero, vx), blocked);
+                    vz = _mm256_blendv_ps(vz, _mm256_sub_ps(zero, vz), blocked);
+                    groundY = _mm256_blendv_ps(groundY, _mm256_footprintGround_ps(x, z, width, ground), blocked);
+                }
+                // Falling entities land once they reach the ground.
+                falling = _mm256_isMovement_ps(state, MovementState::FALLING);
+                __m256 landed = _mm256_and_ps(_mm256_and_ps(colliding, falling), _mm256_cmp_ps(y, groundY, _CMP_LE_OQ));
+                y = _mm256_blendv_ps(y, groundY, landed);
+                state = _mm256_setMovement_epi32(state, MovementState::STATIONARY, landed);
+                // Standing entities step up onto blocks and fall off edges.
+                __m256 standing = _mm256_and_ps(colliding, _mm256_isMovement_ps(state, MovementState::STATIONARY));
+                y = _mm256_blendv_ps(y, _mm256_max_ps(y, groundY), standing);
+                __m256 unsupported = _mm256_and_ps(
+                    standing, _mm256_cmp_ps(y, _mm256_add_ps(groundY, _mm256_set1_ps(GROUND_TOLERANCE)), _CMP_GT_OQ)
+                );
+                startY = _mm256_blendv_ps(startY, y, unsupported);
+                millis = _mm256_blendv_ps(millis, zero, unsupported);
+                state = _mm256_setMovement_epi32(state, MovementState::FALLING, unsupported);
+            }
+
+            _mm256_storeu_ps(&posX[row], nextX);
+            _mm256_storeu_ps(&posY[row], y);
+            _mm256_storeu_ps(&posZ[row], nextZ);
+            _mm256_storeu_ps(&velX[row], vx);
+            _mm256_storeu_ps(&velZ[row], vz);
+            _mm256_storeu_ps(&movementMillis[row], millis);
+            _mm256_storeu_ps(&movementStartY[row], startY);
+            _mm256_storeu_si256((__m256i*) &movement[row], state);
+        }
+    }
+    std::array<EntityStore::FloatComponent*, EntityStore::NUM_FLOAT_COMPONENTS> EntityStore::getFloatComponents()
+    {
+        return {&posX, &posY, &posZ, &velX, &velY, &velZ, &halfWidth, &height, &movementMillis, &movementStartY};
+    }
+    void EntityStore::resizeComponents(size_t rows)
+    {
+        for (FloatComponent* component: getFloatComponents())
+        {
+            component->resize(rows, 0.0f);
+        }
+        // Padding rows fly without moving, so no system changes them.
+        movement.resize(rows, (int32_t) MovementState::FLYING);
+        flags.resize(rows, 0);
+    }
+    void EntityStore::clearRow(size_t row)
+    {
+        for (FloatComponent* component: getFloatComponents())
+        {
+            (*component)[row] = 0.0f;
+        }
+        movement[row] = (int32_t) MovementState::FLYING;
+        flags[row] = 0;
+    }
+    void EntityStore::copyRow(size_t from, size_t to)
+    {
+        for (FloatComponent* component: getFloatComponents())
+        {
+            (*component)[to] = (*component)[from];
+        }
+        movement[to] = movement[from];
+        flags[to] = flags[from];
+    }
+}
@@ -0,0 +1,208 @@
+#ifndef OPENGLDEMO_ENTITYSTORE_HPP
+#define OPENGLDEMO_ENTITYSTORE_HPP
+
+#include <cstdint>
+#include <vector>
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "../misc/globals.hpp"
+#include "../../helpers/memoryTracker.hpp"
+
+namespace Craft
+{
+    /// Identifies an entity of an EntityStore for as long as it exists, ids of destroyed entities are reused.
+    typedef uint32_t EntityId;
+    /// The id of no entity.
+    const EntityId INVALID_ENTITY_ID = UINT32_MAX;
+    /// The number of entities a system steps at once, one per lane of an AVX2 register.
+    const int ENTITY_LANES = 8;
+    /// The highest rise in the ground an entity walks up onto rather than being stopped by.
+    const float MAX_STEP_HEIGHT = 1.0f;
+    /// How far above the ground a standing entity may be before it starts falling.
+    const float GROUND_TOLERANCE = (float) VERTICAL_TOLERANCE;
+
+    /// The vertical movement of an entity.
+    enum class MovementState : int32_t
+    {
+        JUMPING,
+        FALLING,
+        STATIONARY,
+        FLYING
+    };
+    /// Flags of an entity choosing which systems act on it.
+    enum EntityFlags : int32_t
+    {
+        /// The entity walks on, falls onto and is stopped by the heights of an EntityGround.
+        COLLIDE_WITH_GROUND = 1 << 0
+    };
+
+    /**
+     * The ground entities collide with: the top of each column's highest block within a square of the world. Columns
+     * outside the square, or of chunks that are not loaded, are ground at y = 0.
+     */
+    struct EntityGround
+    {
+        /// The world x and z of the square's column with the lowest coordinates.
+        int originX{0};
+        int originZ{0};
+        /// The number of columns along each side of the square.
+        int width{0};
+        /// The y of the top face of each column, indexed by (z * width) + x relative to the origin.
+        std::vector<int32_t, Engine::TrackedAllocator<int32_t, Engine::WORLD_MEMORY>> heights{};
+        /**
+         * Cover another square, every column starting at y = 0.
+         *
+         * @param newOriginX: The world x of the square's column with the lowest coordinates.
+         * @param newOriginZ: The world z of the square's column with the lowest coordinates.
+         * @param newWidth:   The number of columns along each side of the square.
+         */
+        void reset(int newOriginX, int newOriginZ, int newWidth);
+        /// Retrieve the y of the top face of the column at a world x and z.
+        [[nodiscard]] inline int getHeight(int worldX, int worldZ) const
+        {
+            int x = worldX - originX, z = worldZ - originZ;
+            if (x < 0 || x >= width || z < 0 || z >= width) return 0;
+            return heights[(z * width) + x];
+        }
+    };
+
+    /**
+     * The components of every entity, stored as structure of arrays so the systems step eight entities at a time.
+     *
+     * An entity owns a row of every array: the world position of the bottom center of its bounding box, its velocity
+     * in blocks per millisecond, the half width and height of the box, and its vertical movement. Jumps and falls
+     * follow fixed curves of the time since they started, so each row also keeps that time and the height the
+     * movement started from. Rows are packed, destroying an entity moves the last row into its place, and the arrays
+     * are padded to a multiple of ENTITY_LANES with rows no system moves.
+     */
+    class EntityStore
+    {
+    public:
+        EntityStore() = default;
+        ~EntityStore() = default;
+        /**
+         * Create an entity.
+         *
+         * @param position:  The world position of the bottom center of its bounding box.
+         * @param halfWidth: Half of the width of its bounding box along x and z.
+         * @param height:    The height of its bounding box.
+         * @param movement:  Its vertical movement, starting now.
+         * @param flags:     The EntityFlags choosing which systems act on it.
+         * @return:          The id of the entity.
+         */
+        EntityId createEntity(glm::vec3 position, float halfWidth, float height, MovementState movement, int32_t flags);
+        /**
+         * Destroy an entity, its id may be handed out again.
+         *
+         * @param id: The id of the entity.
+         * @return:   True if the entity existed, else false.
+         */
+        bool destroyEntity(EntityId id);
+        /// Retrieve the number of entities.
+        [[nodiscard]] inline size_t getNumEntities() const { return numRows; }
+        /// Retrieve the number of entities with the given flags.
+        [[nodiscard]] size_t countWithFlags(int32_t flagMask) const;
+        /// Retrieve the world position of the bottom center of an entity's bounding box.
+        [[nodiscard]] inline glm::vec3 getPosition(EntityId id) const
+        {
+            uint32_t row = rowOfId[id];
+            return {posX[row], posY[row], posZ[row]};
+        }
+        /// Move an entity without touching its vertical movement.
+        inline void setPosition(EntityId id, glm::vec3 position)
+        {
+            uint32_t row = rowOfId[id];
+            posX[row] = position.x;
+            posY[row] = position.y;
+            posZ[row] = position.z;
+        }
+        /// Retrieve the velocity of an entity in blocks per millisecond.
+        [[nodiscard]] inline glm::vec3 getVelocity(EntityId id) const
+        {
+            uint32_t row = rowOfId[id];
+            return {velX[row], velY[row], velZ[row]};
+        }
+        /// Set the velocity of an entity in blocks per millisecond. Only flying entities move with the y velocity.
+        inline void setVelocity(EntityId id, glm::vec3 velocity)
+        {
+            uint32_t row = rowOfId[id];
+            velX[row] = velocity.x;
+            velY[row] = velocity.y;
+            velZ[row] = velocity.z;
+        }
+        /// Retrieve the vertical movement of an entity.
+        [[nodiscard]] inline MovementState getMovement(EntityId id) const
+        {
+            return (MovementState) movement[rowOfId[id]];
+        }
+        /**
+         * Start a vertical movement of an entity, restarting the time its jump or fall curve follows.
+         *
+         * @param id:     The id of the entity.
+         * @param state:  The new vertical movement.
+         * @param startY: The height a jump or fall starts from.
+         */
+        void startMovement(EntityId id, MovementState state, float startY);
+        /// Retrieve the EntityFlags of an entity.
+        [[nodiscard]] inline int32_t getFlags(EntityId id) const { return flags[rowOfId[id]]; }
+        /**
+         * Step every entity: jumps and falls follow their curves, flying and walking entities move with their
+         * velocity, and entities colliding with the ground are stopped by walls, step up onto blocks, land and fall
+         * off edges.
+         *
+         * @param tickMillis: The milliseconds since the last update.
+         * @param ground:     The ground entities with COLLIDE_WITH_GROUND collide with.
+         */
+        void update(float tickMillis, const EntityGround& ground);
+        /**
+         * Retrieve the height of a jump or fall after a time, the curves the player's movement always followed.
+         *
+         * @param state:  JUMPING or FALLING.
+         * @param startY: The height the movement started from.
+         * @param millis: The milliseconds since it started.
+         * @return:       The height of the entity.
+         */
+        static float getCurveHeight(MovementState state, float startY, float millis);
+    private:
+        typedef std::vector<float, Engine::TrackedAllocator<float, Engine::WORLD_MEMORY>> FloatComponent;
+        typedef std::vector<int32_t, Engine::TrackedAllocator<int32_t, Engine::WORLD_MEMORY>> IntComponent;
+        /// The world position of the bottom center of each entity's bounding box.
+        FloatComponent posX{}, posY{}, posZ{};
+        /// The velocity of each entity in blocks per millisecond.
+        FloatComponent velX{}, velY{}, velZ{};
+        /// Half of the width of each entity's bounding box along x and z.
+        FloatComponent halfWidth{};
+        /// The height of each entity's bounding box.
+        FloatComponent height{};
+        /// The MovementState of each entity.
+        IntComponent movement{};
+        /// The milliseconds since each entity's vertical movement started.
+        FloatComponent movementMillis{};
+        /// The height each entity's vertical movement started from.
+        FloatComponent movementStartY{};
+        /// The EntityFlags of each entity.
+        IntComponent flags{};
+        /// The number of rows in use, the arrays hold that many rounded up to a multiple of ENTITY_LANES.
+        size_t numRows{0};
+        /// The row of each id, INVALID_ENTITY_ID for ids not in use.
+        std::vector<uint32_t> rowOfId{};
+        /// The id of each row.
+        std::vector<EntityId> idOfRow{};
+        /// The ids of destroyed entities, handed out before new ones.
+        std::vector<EntityId> freeIds{};
+        /// The number of float components.
+        static const size_t NUM_FLOAT_COMPONENTS = 10;
+        /// Retrieve every float component, for working on whole rows.
+        std::array<FloatComponent*, NUM_FLOAT_COMPONENTS> getFloatComponents();
+        /// Resize every component to hold a number of rows, filling new rows with rows no system moves.
+        void resizeComponents(size_t rows);
+        /// Overwrite a row with a row no system moves.
+        void clearRow(size_t row);
+        /// Copy every component of one row into another.
+        void copyRow(size_t from, size_t to);
+    };
+}
+
+#endif //OPENGLDEMO_ENTITYSTORE_HPP
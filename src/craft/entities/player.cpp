@@ -12,30 +12,34 @@ namespace Craft {
 
     Player::Player(
             Engine::Timer *timer,
+            EntityStore *entities,
             Engine::Window *window,
+            Engine::Input *input,
             Engine::Program *blockProgram,
-            Engine::Program *worldProgram,
+            Engine::FrameUniforms *frameUniforms,
             uint32_t width,
             uint32_t height,
-            std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block> *> *coords,
+            ChunkBlockMaps *coords,
             std::mutex* coordsMutex
     )
             : timer{timer}
             , blockProgram{blockProgram}
             , coords{coords}
             , window{window}
+            , input{input}
             , coordsMutex{coordsMutex}
             , Entity
             {
-                    timer,
+                    entities,
                     playerInitialX, playerInitialY, playerInitialZ,
                     Coordinate2D<int>{0, 0},
                     PLAYER_FRONT_BOUND, PLAYER_BACK_BOUND, PLAYER_LEFT_BOUND, PLAYER_RIGHT_BOUND,
+                    PLAYER_HEIGHT,
                     coords
             }
             , camera
             {
-                  window, blockProgram, worldProgram, width, height,
+                  window, frameUniforms, width, height,
                   (float) entityX, (float) entityY, (float) entityZ
             } {}
 
@@ -44,8 +48,17 @@ namespace Craft {
         if (!camera.initCamera()) {
             return false;
         }
+        lookAtBlockUniform = blockProgram->getUniform<glm::ivec3>("u_lookAtBlock");
+        hasLookAtUniform = blockProgram->getUniform<bool>("u_hasLookAt");
 
-        timer->startStopWatch();
+        // Keep the player above the terrain if it reaches the spawn height.
+        {
+            std::lock_guard<std::mutex> lock(*coordsMutex);
+            BlockInfo spawnColumn = getBlockInfo({(int) round(entityX), 0, (int) round(entityZ)}, originChunk);
+            int surface = highestBlock(spawnColumn, coords);
+            if (surface >= 0 && entityY < (long double) surface + 3) entityY = (long double) surface + 3;
+        }
+        syncToStore();
 
         return true;
     }
@@ -111,11 +124,23 @@ namespace Craft {
 
         return blockIntersects;
     }
+    void Player::setPose(glm::vec3 eyePos, float yaw, float pitch)
+    {
+        camera.setOrientation(yaw, pitch);
+        // updatePlayer wraps the position back into [0, 16) and moves the origin chunk.
+        entityX = eyePos.x - (float) (originChunk.x * 16);
+        entityY = eyePos.y + PLAYER_EYE_DIFF;
+        entityZ = eyePos.z - (float) (originChunk.z * 16);
+        startMovement(MovementState::FLYING, entityY - entityHeight);
+        syncToStore();
+    }
     Coordinate2D<int> Player::updatePlayer()
     {
-
+        syncFromStore();
 //        std::cout << Coordinate<int>{(int) entityX + (originChunk.x * 16), (int) entityY - 2, (int) entityZ + (originChunk.z * 16)} << std::endl;
         glm::vec3 cameraPos = glm::vec3{entityX + (originChunk.x * 16), entityY, entityZ + (originChunk.z * 16)};
+        glm::vec2 mouseDelta = input->getMouseDelta();
+        camera.applyMouseDelta(mouseDelta.x, mouseDelta.y);
         glm::vec3 cameraFront = camera.getCameraFront();
 
         float angle = atan2(cameraFront.x, cameraFront.z);
@@ -138,34 +163,34 @@ namespace Craft {
         float walkingSpeed = cameraWalkingSpeedPerMilli * milliSinceLastUpdate;
         glm::vec3 movementVec{0.0f};
         // Move Forward
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_W) == GLFW_PRESS)
+        if (input->isKeyDown(Engine::InputKey::FORWARD))
         {
             movementVec += walkingSpeed * glm::normalize(glm::vec3{cameraFront.x, 0.0f, cameraFront.z});
         }
         // Move back
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_S) == GLFW_PRESS)
+        if (input->isKeyDown(Engine::InputKey::BACKWARD))
         {
             movementVec -= walkingSpeed * glm::normalize(glm::vec3{cameraFront.x, 0.0f, cameraFront.z});
         }
         // Move left
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_A) == GLFW_PRESS)
+        if (input->isKeyDown(Engine::InputKey::LEFT))
         {
             movementVec -= walkingSpeed * glm::normalize(glm::cross(cameraFront, cameraUp));
         }
         // Move right
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_D) == GLFW_PRESS) {
+        if (input->isKeyDown(Engine::InputKey::RIGHT)) {
             movementVec += walkingSpeed * glm::normalize(glm::cross(cameraFront, cameraUp));
         }
         // toggle flying
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_F) == GLFW_PRESS)
+        if (input->isKeyDown(Engine::InputKey::TOGGLE_FLYING))
         {
-            if (vertMovement == EntityVertMovementType::FLYING)
+            if (getMovement() == MovementState::FLYING)
             {
                 startFalling();
             }
             else
             {
-                vertMovement = EntityVertMovementType::FLYING;
+                startMovement(MovementState::FLYING, entityY - entityHeight);
             }
         }
 
@@ -199,30 +224,29 @@ namespace Craft {
         }
 
         // Jump
-        if (glfwGetKey(window->getWindow(), GLFW_KEY_SPACE) == GLFW_PRESS)
+        if (input->isKeyDown(Engine::InputKey::JUMP))
         {
             // Start jumping
-            if (vertMovement == EntityVertMovementType::FLYING)
+            if (getMovement() == MovementState::FLYING)
             {
                 cameraPos.y += 0.01f * milliSinceLastUpdate;
                 entityY = cameraPos.y;
             }
-            else if (vertMovement == EntityVertMovementType::STATIONARY)
+            else if (getMovement() == MovementState::STATIONARY)
             {
-                vertMovement = EntityVertMovementType::JUMPING;
-                initialJumpHeight = (float) floor(entityY);
-                timer->startStopWatch();
+                // Integer since you can only jump from a block, the store moves the player along the jump.
+                startMovement(MovementState::JUMPING, floor(entityY - entityHeight));
             }
         }
         // Move down (will eventually remove, maybe implement crouch.)
         if (
-                vertMovement == EntityVertMovementType::FLYING &&
-                glfwGetKey(window->getWindow(), GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS
+                getMovement() == MovementState::FLYING &&
+                input->isKeyDown(Engine::InputKey::DESCEND)
             )
         {
             if (blockBelowEntity(angle))
             {
-                vertMovement = EntityVertMovementType::STATIONARY;
+                startMovement(MovementState::STATIONARY, entityY - entityHeight);
             }
             else
             {
@@ -231,40 +255,18 @@ namespace Craft {
             }
         }
 
-        if (vertMovement == EntityVertMovementType::JUMPING && entityY < initialJumpHeight + JUMP_HEIGHT)
-        {
-            float newY = initialJumpHeight + calcJumpDisplacement();
-            cameraPos.y = newY;
-            entityY = cameraPos.y;
-        }
-        else if (vertMovement == EntityVertMovementType::JUMPING && entityY >= initialJumpHeight + JUMP_HEIGHT)
-        {
-            // after jumping go into falling.
-            startFalling();
-        }
-
-        if (vertMovement == EntityVertMovementType::FALLING)
+        // The store already moved the player along its jump or fall, only landing needs the exact blocks.
+        if (getMovement() == MovementState::FALLING)
         {
-            bool stopFall = blockBelowEntity(angle);
-            if (stopFall)
+            if (blockBelowEntity(angle))
             {
                 entityY = round(entityY);
-                vertMovement = EntityVertMovementType::STATIONARY;
-            }
-            else
-            {
-                float newY = (float) initialFallHeight + calcFallDisplacement();
-                cameraPos.y = newY;
-                entityY = cameraPos.y;
+                startMovement(MovementState::STATIONARY, entityY - entityHeight);
             }
         }
-        else if (
-                vertMovement != EntityVertMovementType::FLYING &&
-                vertMovement == EntityVertMovementType::STATIONARY
-            )
+        else if (getMovement() == MovementState::STATIONARY)
         {
-            bool stopFall = blockBelowEntity(angle);
-            if (!stopFall)
+            if (!blockBelowEntity(angle))
             {
                 startFalling();
             }
@@ -272,15 +274,14 @@ namespace Craft {
 
         cameraPos.y -= PLAYER_EYE_DIFF;
         performRayAABB(cameraPos, glm::normalize(cameraFront), (int) floor(cameraPos.x), (int) floor(cameraPos.y), (int) floor(cameraPos.z), BlockSideType::NONE, 0);
-        blockProgram->useProgram();
         if (lookAtBlock != nullptr)
         {
-            setiVec3(blockProgram->getProgram(), "u_lookAtBlock", *lookAtBlock);
-            setBool(blockProgram->getProgram(), "u_hasLookAt", true);
+            lookAtBlockUniform.set(*lookAtBlock);
+            hasLookAtUniform.set(true);
         }
         else
         {
-            setBool(blockProgram->getProgram(), "u_hasLookAt", false);
+            hasLookAtUniform.set(false);
         }
         // Update the camera.
         if (!camera.updateCamera(cameraPos, cameraUp)) {
@@ -320,6 +321,7 @@ namespace Craft {
             diff.z = -1;
         }
         originChunk = originChunk + diff;
+        syncToStore();
 
         return diff;
     }
@@ -15,6 +15,7 @@
 #include "../misc/coordinate.hpp"
 #include "../misc/globals.hpp"
 #include "../../setup/camera.hpp"
+#include "../../setup/input.hpp"
 #include "../../setup/window.hpp"
 #include "../../setup/program.hpp"
 #include "../../helpers/timer.hpp"
@@ -26,12 +27,14 @@ namespace Craft
     public:
         Player(
             Engine::Timer* timer,
+            EntityStore* entities,
             Engine::Window* window,
+            Engine::Input* input,
             Engine::Program* blockProgram,
-            Engine::Program* worldProgram,
+            Engine::FrameUniforms* frameUniforms,
             uint32_t width,
             uint32_t height,
-            std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords,
+            ChunkBlockMaps* coords,
             std::mutex* coordsMutex
         );
         /**
@@ -40,8 +43,20 @@ namespace Craft
          * @return True if the camera was initialized, otherwise False.
          */
         bool initPlayer();
-        /// A method for updating the players state.
+        /**
+         * A method for updating the players state. The entity store must have been updated for this tick, as it moves
+         * the player along its jumps and falls.
+         */
         Coordinate2D<int> updatePlayer();
+        /**
+         * Place the player's eyes at a world position looking in a given direction, flying so the next update does
+         * not move it. Used to drive the camera from a script.
+         *
+         * @param eyePos: The world position of the player's eyes.
+         * @param yaw:    The angle in degrees for looking left and right.
+         * @param pitch:  The angle in degrees for looking up and down.
+         */
+        void setPose(glm::vec3 eyePos, float yaw, float pitch);
         /// Retrieve the block located at lookAtBlock on the side that you are looking at.
         Coordinate<int> getNextLookAtBlock() const;
         /// The block the player is looking at.
@@ -62,14 +77,20 @@ namespace Craft
         Engine::Timer* timer;
         /// The program for drawing blocks.
         Engine::Program* blockProgram;
+        /// The block program's handle for the block the player is looking at.
+        Engine::Uniform<glm::ivec3> lookAtBlockUniform{};
+        /// The block program's handle for whether the player is looking at a block.
+        Engine::Uniform<bool> hasLookAtUniform{};
         /// The walking speed of the player. Scientifically proven to be accurate.
         float cameraWalkingSpeedPerMilli{0.004317f};
         /// The vec3 describing the View matrices up direction.
         glm::vec3 cameraUp{glm::vec3(0.0f, 1.0f,  0.0f)};
         /// A mapping of chunk coords to a block placement bitmap for collision.
-        std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords;
+        ChunkBlockMaps* coords;
         /// A pointer to the GLFW window.
         Engine::Window* window;
+        /// The input of the current tick.
+        Engine::Input* input;
         /// The camera of the scene.
         Engine::Camera camera;
         /// A mutex for accessing the coords mapping.
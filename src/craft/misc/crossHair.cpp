@@ -39,23 +39,25 @@ namespace Craft
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
+
+        setUniforms();
     }
 
     void CrossHair::setUniforms()
     {
-        setMat4(program->getProgram(), "u_projT", ortho);
-        setMat4(program->getProgram(), "u_modelT", identity);
+        // The ortho program is only used by the crossHair and none of these change between frames.
+        program->getUniform<glm::mat4>("u_projT").set(ortho);
+        program->getUniform<glm::mat4>("u_modelT").set(identity);
 
         auto windowWidth = (float) window->getWidth();
         auto windowHeight = (float) window->getHeight();
         glm::vec2 screenDim{windowWidth, windowHeight};
-        setVec2(program->getProgram(), "u_screenDimensions", screenDim);
+        program->getUniform<glm::vec2>("u_screenDimensions").set(screenDim);
     }
 
     void CrossHair::drawCrossHair(GLuint frameTexture)
     {
         program->useProgram();
-        setUniforms();
         glBindVertexArray(VAO);
         glDrawArrays(GL_TRIANGLES, 0, (GLint) crossHairVertices.size() / 2);
         glBindVertexArray(0);
@@ -5,6 +5,8 @@
 #ifndef OPENGLDEMO_GLOBALS_HPP
 #define OPENGLDEMO_GLOBALS_HPP
 
+#include "coordinate.hpp"
+
 namespace Craft
 {
     /*  World Information Globals  */
@@ -12,9 +14,27 @@ namespace Craft
     const int CHUNK_HEIGHT = 256;
     const int RENDER_DISTANCE = 2 ;
     const int CHUNK_BASE_HEIGHT = 100;
+    /// The number of solid blocks below air that are grass, the blocks below them are stone.
+    const int GRASS_DEPTH = 3;
     const int VERTICES_PER_BLOCK = 36;
     const int SIDES_PER_BLOCK = 6;
     const int VERTICES_PER_SIDE = 6;
+    /// Build the instance lists and draw commands with compact.comp instead of on the CPU worker threads.
+    const bool GPU_MESHING = false;
+    /// Generate the terrain's occupancy with terrain.comp, falling back to the CPU if the program is unavailable.
+    const bool GPU_TERRAIN = false;
+
+    /*  Chunk Pipeline Globals  */
+    // The main thread time, in milliseconds, each stage of the chunk pipeline may use per frame.
+    const double GENERATE_STAGE_BUDGET_MS = 1.0;
+    const double NEIGHBOR_STAGE_BUDGET_MS = 1.0;
+    const double AMBIENT_STAGE_BUDGET_MS = 1.0;
+    const double MESH_STAGE_BUDGET_MS = 1.0;
+    const double UPLOAD_STAGE_BUDGET_MS = 0.5;
+    // The most queued block edits applied per frame, the rest wait for the next frame.
+    const int MAX_EDITS_PER_FRAME = 64;
+    /// The offsets of a chunk's neighbors, in the order x max, x min, z max, z min of the neighbor masks.
+    const Coordinate2D<int> CHUNK_NEIGHBOR_OFFSETS[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
 
     /*  Player Globals  */
     const long double PLAYER_FRONT_BOUND = 0.15l;
@@ -23,6 +43,7 @@ namespace Craft
     const long double PLAYER_RIGHT_BOUND = 0.3l;
     const float JUMP_HEIGHT = 1.25f;
     const float PLAYER_EYE_DIFF = 0.38f;
+    const long double PLAYER_HEIGHT = 2.0l;
     const float REACH_DISTANCE = 4.5l;
     const long double PLAYER_BOUND = 0.3l;
     const long double PLAYER_BOUND_SQRD = PLAYER_BOUND * PLAYER_BOUND;
@@ -0,0 +1,200 @@
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "textureBundle.hpp"
+
+namespace Craft
+{
+    /// The alignment of the pixel data within the bundle.
+    const uint64_t TEXTURE_BUNDLE_DATA_ALIGNMENT = 64;
+
+    bool stampBundleSource(const std::string& relPath, TextureBundleSource& source)
+    {
+        std::filesystem::path filePath = std::filesystem::current_path().parent_path() / relPath;
+        std::error_code error;
+        auto fileSize = std::filesystem::file_size(filePath, error);
+        if (error) return false;
+        auto writeTime = std::filesystem::last_write_time(filePath, error);
+        if (error) return false;
+
+        std::memset(source.path, 0, sizeof(source.path));
+        std::strncpy(source.path, relPath.c_str(), sizeof(source.path) - 1);
+        source.size = fileSize;
+        source.lastWriteTime = (int64_t) writeTime.time_since_epoch().count();
+        return true;
+    }
+    size_t getBundleLayerSize(const TextureBundleHeader& header, uint32_t mip)
+    {
+        size_t width = std::max(header.width >> mip, 1u);
+        size_t height = std::max(header.height >> mip, 1u);
+        return width * height * 4;
+    }
+    bool writeTextureBundle(
+            const std::filesystem::path& path,
+            TextureBundleHeader header,
+            const std::vector<TextureBundleSource>& sources,
+            const std::vector<TextureBundleMapping>& mappings,
+            const std::vector<unsigned char>& pixels
+        )
+    {
+        header.magic = TEXTURE_BUNDLE_MAGIC;
+        header.version = TEXTURE_BUNDLE_VERSION;
+        header.numSources = (uint32_t) sources.size();
+        header.numMappings = (uint32_t) mappings.size();
+        uint64_t tableEnd = sizeof(TextureBundleHeader) +
+                            sources.size() * sizeof(TextureBundleSource) +
+                            mappings.size() * sizeof(TextureBundleMapping);
+        header.dataOffset = (tableEnd + TEXTURE_BUNDLE_DATA_ALIGNMENT - 1) & ~(TEXTURE_BUNDLE_DATA_ALIGNMENT - 1);
+        header.dataSize = pixels.size();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open texture bundle for writing: " << path << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(sources.data()), (std::streamsize) (sources.size() * sizeof(TextureBundleSource)));
+        file.write(reinterpret_cast<const char*>(mappings.data()), (std::streamsize) (mappings.size() * sizeof(TextureBundleMapping)));
+        std::vector<char> padding(header.dataOffset - tableEnd, 0);
+        file.write(padding.data(), (std::streamsize) padding.size());
+        file.write(reinterpret_cast<const char*>(pixels.data()), (std::streamsize) pixels.size());
+        return file.good();
+    }
+
+    TextureBundle::~TextureBundle()
+    {
+        closeBundle();
+    }
+    bool TextureBundle::openBundle(const std::string& relPath)
+    {
+        closeBundle();
+        std::filesystem::path filePath = std::filesystem::current_path().parent_path() / relPath;
+#ifdef _WIN32
+        HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = (size_t) fileSize.QuadPart;
+#else
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file.
+        close(fd);
+        if (mapped == MAP_FAILED) return false;
+        data = static_cast<const unsigned char*>(mapped);
+        size = (size_t) fileStat.st_size;
+#endif
+        if (data == nullptr || size < sizeof(TextureBundleHeader))
+        {
+            closeBundle();
+            return false;
+        }
+        header = reinterpret_cast<const TextureBundleHeader*>(data);
+        uint64_t tableEnd = sizeof(TextureBundleHeader) +
+                            (uint64_t) header->numSources * sizeof(TextureBundleSource) +
+                            (uint64_t) header->numMappings * sizeof(TextureBundleMapping);
+        if (
+                header->magic != TEXTURE_BUNDLE_MAGIC ||
+                header->version != TEXTURE_BUNDLE_VERSION ||
+                header->numLayers == 0 ||
+                header->numMips == 0 ||
+                header->dataOffset < tableEnd ||
+                header->dataOffset + header->dataSize > size
+            )
+        {
+            std::cerr << "Texture bundle is invalid: " << relPath << std::endl;
+            closeBundle();
+            return false;
+        }
+        if (isStale())
+        {
+            std::cout << "Texture bundle is out of date, rebuild it with chunkcraft-texpack." << std::endl;
+            closeBundle();
+            return false;
+        }
+        return true;
+    }
+    void TextureBundle::closeBundle()
+    {
+#ifdef _WIN32
+        if (data != nullptr) UnmapViewOfFile(data);
+        if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+        if (fileHandle != nullptr) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        if (data != nullptr) munmap(const_cast<unsigned char*>(data), size);
+#endif
+        data = nullptr;
+        header = nullptr;
+        size = 0;
+    }
+    bool TextureBundle::isStale() const
+    {
+        auto sources = reinterpret_cast<const TextureBundleSource*>(data + sizeof(TextureBundleHeader));
+        for (uint32_t idx = 0; idx < header->numSources; idx++)
+        {
+            const TextureBundleSource& source = sources[idx];
+            TextureBundleSource current{};
+            std::string relPath{source.path, strnlen(source.path, sizeof(source.path))};
+            if (
+                    !stampBundleSource(relPath, current) ||
+                    current.size != source.size ||
+                    current.lastWriteTime != source.lastWriteTime
+                )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    const TextureBundleMapping* TextureBundle::getMappings() const
+    {
+        return reinterpret_cast<const TextureBundleMapping*>(
+                data + sizeof(TextureBundleHeader) + header->numSources * sizeof(TextureBundleSource)
+        );
+    }
+    const unsigned char* TextureBundle::getLevel(uint32_t mip) const
+    {
+        size_t offset = header->dataOffset;
+        for (uint32_t level = 0; level < mip; level++)
+        {
+            offset += getBundleLayerSize(*header, level) * header->numLayers;
+        }
+        return data + offset;
+    }
+}
@@ -0,0 +1,156 @@
+#ifndef OPENGLDEMO_TEXTUREBUNDLE_HPP
+#define OPENGLDEMO_TEXTUREBUNDLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace Craft
+{
+    /// The relative path from the project root to the texture mapping the bundle is built from.
+    const char* const TEXTURE_MAPPING_PATH = "src/assets/json/texture_mapping.json";
+    /// The relative path from the project root to the pre-baked texture bundle.
+    const char* const TEXTURE_BUNDLE_PATH = "src/assets/textures.bundle";
+    /// A magic number marking the start of a texture bundle ("CCTB").
+    const uint32_t TEXTURE_BUNDLE_MAGIC = 0x42544343;
+    /// The version of the bundle layout. Bump whenever one of the structs below changes.
+    const uint32_t TEXTURE_BUNDLE_VERSION = 1;
+
+    /**
+     * The header at the start of a texture bundle.
+     *
+     * The header is followed by numSources TextureBundleSource entries, numMappings TextureBundleMapping entries, and
+     * finally at dataOffset the RGBA8 pixels of every mip level. Each level holds all layers back to back, so a level
+     * can be uploaded with a single glTexSubImage3D call.
+     */
+    struct TextureBundleHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        /// The width of the first mip level.
+        uint32_t width;
+        /// The height of the first mip level.
+        uint32_t height;
+        uint32_t numLayers;
+        uint32_t numMips;
+        uint32_t numSources;
+        uint32_t numMappings;
+        /// The offset from the start of the file to the pixel data.
+        uint64_t dataOffset;
+        /// The size of the pixel data in bytes.
+        uint64_t dataSize;
+    };
+    static_assert(sizeof(TextureBundleHeader) == 48, "TextureBundleHeader must not contain implicit padding.");
+
+    /// A file the bundle was built from, used to detect a stale bundle without reading the file.
+    struct TextureBundleSource
+    {
+        /// The relative path from the project root to the file.
+        char path[240];
+        uint64_t size;
+        int64_t lastWriteTime;
+    };
+    static_assert(sizeof(TextureBundleSource) == 256, "TextureBundleSource must not contain implicit padding.");
+
+    /// A single entry of the block-face mapping table.
+    struct TextureBundleMapping
+    {
+        /// The lowercase name of the block type, as used in texture_mapping.json.
+        char blockType[24];
+        /// The face of the block: 0 top, 1 bottom, 2 front, 3 right, 4 back, 5 left.
+        uint32_t face;
+        /// The layer of the texture within the Sampler2DArray.
+        uint32_t layer;
+    };
+    static_assert(sizeof(TextureBundleMapping) == 32, "TextureBundleMapping must not contain implicit padding.");
+
+    /// The names of the block faces in the order of TextureBundleMapping::face.
+    const char* const BLOCK_FACE_NAMES[6] = {"top", "bottom", "front", "right", "back", "left"};
+
+    /**
+     * Retrieve the size and modification time of a source file.
+     *
+     * @param relPath: The relative path from the project root to the file.
+     * @param source:  The entry to fill.
+     * @return:        True if the file exists, else false.
+     */
+    bool stampBundleSource(const std::string& relPath, TextureBundleSource& source);
+    /**
+     * Retrieve the size in bytes of a single layer of the given mip level.
+     *
+     * @param header: The header of the bundle.
+     * @param mip:    The mip level.
+     * @return:       The size of the layer in bytes.
+     */
+    size_t getBundleLayerSize(const TextureBundleHeader& header, uint32_t mip);
+    /**
+     * Write a texture bundle.
+     *
+     * @param path:     The file to write to.
+     * @param header:   The header, the offsets and counts are filled in.
+     * @param sources:  The files the bundle was built from.
+     * @param mappings: The block-face mapping table.
+     * @param pixels:   The pixels of every mip level, laid out as described in TextureBundleHeader.
+     * @return:         True if the bundle was written, else false.
+     */
+    bool writeTextureBundle(
+            const std::filesystem::path& path,
+            TextureBundleHeader header,
+            const std::vector<TextureBundleSource>& sources,
+            const std::vector<TextureBundleMapping>& mappings,
+            const std::vector<unsigned char>& pixels
+        );
+
+    /**
+     * A read only, memory mapped texture bundle.
+     *
+     * The pixel data is uploaded straight from the mapping, so loading a bundle does not decode or copy any images.
+     */
+    class TextureBundle
+    {
+    public:
+        TextureBundle() = default;
+        ~TextureBundle();
+        TextureBundle(const TextureBundle&) = delete;
+        TextureBundle& operator=(const TextureBundle&) = delete;
+        /**
+         * Map the bundle at the given path and validate it against its sources.
+         *
+         * @param relPath: The relative path from the project root to the bundle.
+         * @return:        True if the bundle is mapped and up to date, else false.
+         */
+        bool openBundle(const std::string& relPath);
+        /// Retrieve the header of the bundle.
+        [[nodiscard]] inline const TextureBundleHeader& getHeader() const { return *header; }
+        /// Retrieve the block-face mapping table, getHeader().numMappings entries long.
+        [[nodiscard]] const TextureBundleMapping* getMappings() const;
+        /**
+         * Retrieve the pixels of every layer of the given mip level.
+         *
+         * @param mip: The mip level.
+         * @return:    A pointer into the mapped bundle.
+         */
+        [[nodiscard]] const unsigned char* getLevel(uint32_t mip) const;
+    private:
+        /// The start of the mapped file.
+        const unsigned char* data{nullptr};
+        /// The size of the mapped file.
+        size_t size{0};
+        /// The header at the start of the mapped file.
+        const TextureBundleHeader* header{nullptr};
+#ifdef _WIN32
+        /// The handle of the opened file.
+        void* fileHandle{nullptr};
+        /// The handle of the file mapping.
+        void* mappingHandle{nullptr};
+#endif
+        /// Unmap the bundle.
+        void closeBundle();
+        /// Retrieve whether any of the bundle's sources changed since it was built.
+        [[nodiscard]] bool isStale() const;
+    };
+}
+
+#endif //OPENGLDEMO_TEXTUREBUNDLE_HPP
@@ -3,6 +3,7 @@
 //
 
 #include "textures.hpp"
+#include "textureBundle.hpp"
 #include "glm/glm.hpp"
 #include <mutex>
 
@@ -10,14 +11,9 @@ namespace Craft
 {
     Textures::~Textures()
     {
-        for (const auto& keyValue: textureMapping)
+        if (textureArray != 0)
         {
-            delete keyValue.second.top;
-            delete keyValue.second.bottom;
-            delete keyValue.second.front;
-            delete keyValue.second.right;
-            delete keyValue.second.back;
-            delete keyValue.second.left;
+            glDeleteTextures(1, &textureArray);
         }
     }
     static std::mutex mutex{};
@@ -46,27 +42,77 @@ namespace Craft
         }
     }
     void constructTexture(
-            BlockType blockType,
-            const std::string& blockFace,
+            const std::string& blockType,
+            int blockFace,
             GLuint texLayer,
-            std::unordered_map<BlockType, BlockTexture>& textureMapping
+            BlockRegistry* registry
         )
     {
-        auto data = new textureData{texLayer};
-        std::lock_guard<std::mutex> lock(mutex);
-        BlockTexture& bt = textureMapping[blockType];
-        if (blockFace == "top") bt.top = data;
-        else if (blockFace == "bottom") bt.bottom = data;
-        else if (blockFace == "front") bt.front = data;
-        else if (blockFace == "right") bt.right = data;
-        else if (blockFace == "back") bt.back = data;
-        else if (blockFace == "left") bt.left = data;
+        BlockId id = registry->getId(blockType);
+        if (id == AIR_BLOCK_ID || blockFace < 0 || blockFace >= SIDES_PER_BLOCK)
+        {
+            std::cerr << "Texture mapped to an unknown block face: " << blockType << std::endl;
+            return;
+        }
+        registry->setFaceLayer(id, blockFace, texLayer);
+    }
+    bool Textures::initTexturesFromBundle(BlockRegistry* registry)
+    {
+        TextureBundle bundle{};
+        if (!bundle.openBundle(TEXTURE_BUNDLE_PATH)) return false;
+        const TextureBundleHeader& header = bundle.getHeader();
+
+        glActiveTexture(GL_TEXTURE1);
+        glGenTextures(1, &textureArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+        glTexStorage3D(
+            GL_TEXTURE_2D_ARRAY,
+            (GLsizei) header.numMips,
+            GL_RGBA8,
+            (GLsizei) header.width,
+            (GLsizei) header.height,
+            (GLsizei) header.numLayers
+        );
+        for (uint32_t mip = 0; mip < header.numMips; mip++)
+        {
+            glTexSubImage3D(
+                GL_TEXTURE_2D_ARRAY,
+                (GLint) mip, 0, 0, 0,
+                std::max((GLsizei) header.width >> mip, 1),
+                std::max((GLsizei) header.height >> mip, 1),
+                (GLsizei) header.numLayers,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                bundle.getLevel(mip)
+            );
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        std::cout << "Number of textures: " << header.numLayers << std::endl;
+
+        const TextureBundleMapping* mappings = bundle.getMappings();
+        for (uint32_t idx = 0; idx < header.numMappings; idx++)
+        {
+            const TextureBundleMapping& mapping = mappings[idx];
+            std::string blockType{mapping.blockType, strnlen(mapping.blockType, sizeof(mapping.blockType))};
+            constructTexture(blockType, (int) mapping.face, mapping.layer, registry);
+        }
+        return true;
     }
-    bool Textures::initTextures(GLuint program)
+    bool Textures::initTextures(GLuint program, BlockRegistry* registry)
     {
         std::cout << "Initializing textures." << std::endl;
+        glUseProgram(program);
+        if (initTexturesFromBundle(registry))
+        {
+            std::cout << "Initialized Textures from bundle" << std::endl;
+            glUniform1i(glGetUniformLocation(program, "textures"), 1);
+            return true;
+        }
         std::filesystem::path current_path = std::filesystem::current_path();
-        std::filesystem::path file_path = current_path.parent_path() / "src/assets/json/texture_mapping.json";
+        std::filesystem::path file_path = current_path.parent_path() / TEXTURE_MAPPING_PATH;
         std::ifstream file(file_path);
         // Define the path to the JSON file
         std::unordered_map<std::string, GLuint> createdTexts{};
@@ -84,7 +130,7 @@ namespace Craft
         }
 
         glUseProgram(program);
-        GLuint tex = initTextureFromData(loadResults);
+        textureArray = initTextureFromData(loadResults);
         std::cout << "Initialized Textures" << std::endl;
         glUniform1i(glGetUniformLocation(program, "textures"), 1);
         /// Iterate through Textures
@@ -98,7 +144,8 @@ namespace Craft
                 // Iterate through block faces.
                 for (const auto& blockFace: info.second)
                 {
-                    constructTexture(stringToBlockType[blockType], blockFace, texLayer, textureMapping);
+                    int face = (int) (std::find(BLOCK_FACE_NAMES, BLOCK_FACE_NAMES + SIDES_PER_BLOCK, blockFace) - BLOCK_FACE_NAMES);
+                    constructTexture(blockType, face, texLayer, registry);
                 }
             }
         }
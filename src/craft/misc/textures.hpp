@@ -14,6 +14,7 @@
 using json = nlohmann::json;
 #include "types.hpp"
 #include "../../helpers/helpers.hpp"
+#include "../worldGeneration/blockRegistry.hpp"
 
 namespace Craft
 {
@@ -27,14 +28,24 @@ namespace Craft
          *
          * Textures are defined through the assets/json/texture_mapping.json file.
          * This file allows us to easily manage which files go to which block types and side combinations.
+         * If an up to date bundle built by chunkcraft-texpack exists it is uploaded instead, skipping the JSON parse
+         * and image decoding.
          *
-         * @param program: The program to attach the textures to.
-         * @return:        True if the textures were initialize, else False.
+         * @param program:  The program to attach the textures to.
+         * @param registry: The block registry to record the texture layer of every block face in.
+         * @return:         True if the textures were initialize, else False.
          */
-        bool initTextures(GLuint program);
-        /// A mapping of BlockType enum to a struct containing the block's texture information.
-        std::unordered_map<BlockType, BlockTexture> textureMapping{};
+        bool initTextures(GLuint program, BlockRegistry* registry);
     private:
+        /// The identifier of the 2D array texture.
+        GLuint textureArray{0};
+        /**
+         * Initialize the textures from the pre-baked texture bundle.
+         *
+         * @param registry: The block registry to record the texture layer of every block face in.
+         * @return:         True if the bundle was up to date and uploaded, else False.
+         */
+        bool initTexturesFromBundle(BlockRegistry* registry);
         /**
          * Initialize the image data into a Sampler2DArray object where each layer is a different texture.
          *
@@ -19,6 +19,9 @@ namespace Craft {
         calcSkyColor();
         calcNewAngle();
 
+        modelUniform = worldProgram->getUniform<glm::mat4>("u_modelT");
+        colorUniform = worldProgram->getUniform<glm::vec4>("u_colorMapping");
+
         glGenBuffers(1, &VBO);
         glGenVertexArrays(1, &VAO);
 
@@ -40,7 +43,7 @@ namespace Craft {
         modelMatrix = glm::rotate(modelMatrix, glm::radians(angle), glm::vec3(0, 0, 1));
         modelMatrix = glm::translate(modelMatrix, glm::vec3(SUN_DISTANCE, 0, 0));
         modelMatrix = glm::scale(modelMatrix, glm::vec3(2, SUN_WIDTH, SUN_WIDTH));
-        setMat4(worldProgram->getProgram(), "u_modelT", modelMatrix);
+        modelUniform.set(modelMatrix);
     }
     void Sun::updateSun()
     {
@@ -135,13 +138,13 @@ namespace Craft {
         if (drawSun)
         {
             updateModel(playerX, playerY, playerZ, sunAngle);
-            setVec4(worldProgram->getProgram(), "u_colorMapping", sunColor);
+            colorUniform.set(sunColor);
             glDrawArrays(GL_TRIANGLES, 0, (GLint) solarObjectVertices.size() / 3);
         }
         if (drawMoon)
         {
             updateModel(playerX, playerY, playerZ, moonAngle);
-            setVec4(worldProgram->getProgram(), "u_colorMapping", moonColor);
+            colorUniform.set(moonColor);
             glDrawArrays(GL_TRIANGLES, 0, (GLint) solarObjectVertices.size() / 3);
         }
         glBindVertexArray(0);
@@ -35,6 +35,10 @@ namespace Craft
     private:
         /// A pointer to a generic OpenGL program.
         Engine::Program* worldProgram;
+        /// The world program's handle for the model transformation.
+        Engine::Uniform<glm::mat4> modelUniform{};
+        /// The world program's handle for the solar object's color.
+        Engine::Uniform<glm::vec4> colorUniform{};
         /// The timer for the sun/moon/game (in-game time).
         Engine::Timer clockTimer{};
         /// The time within the game.
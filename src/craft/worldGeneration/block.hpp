@@ -10,38 +10,52 @@
 #include <unordered_set>
 #include <mutex>
 #include <bitset>
+#include <unordered_map>
+#include <vector>
 
 #include "../misc/coordinate.hpp"
 #include "../misc/types.hpp"
 #include "../misc/globals.hpp"
+#include "blockRegistry.hpp"
+#include "chunkColumns.hpp"
+#include "../../helpers/arena.hpp"
+#include "../../helpers/mpscQueue.hpp"
 
 namespace Craft
 {
-    /**
-     * A structure for holding block data.
-     */
-    struct Block
+    /// The blocks of every loaded chunk keyed by the chunk's position, with nodes taken from the world's NodePool.
+    typedef std::unordered_map<
+        Coordinate2D<int>,
+        ChunkColumns*,
+        std::hash<Coordinate2D<int>>,
+        std::equal_to<Coordinate2D<int>>,
+        Engine::PoolAllocator<std::pair<const Coordinate2D<int>, ChunkColumns*>>
+    > ChunkBlockMaps;
+    /// A change of a single block, queued for the world's next update.
+    struct BlockEdit
     {
-        explicit Block(BlockType type)
-            : type{type}
-            , lightLevelDiff{0}
-        {}
-        /// The enum of the block's type.
-        BlockType type{};
-        /// The amount to decrease the light level by (not currently in use).
-        int lightLevelDiff;
+        /// The world position of the block.
+        Coordinate<int> block{};
+        /// The new type of the block, AIR_BLOCK_ID to delete it.
+        BlockId id{AIR_BLOCK_ID};
+    };
+    /// The number of block edits that may wait for the world's next update.
+    const size_t EDIT_QUEUE_CAPACITY = 1024;
+    /// The block edits waiting for the world's next update, pushed by any thread and drained by the main thread.
+    typedef Engine::MpscQueue<BlockEdit, EDIT_QUEUE_CAPACITY> EditQueue;
+    /// A box of blocks copied out of the world, or built elsewhere, to be pasted into the world.
+    struct BlockBuffer
+    {
+        /// The number of blocks along each axis.
+        Coordinate<int> size{};
+        /// The types of the blocks, indexed by getIdx.
+        std::vector<BlockId> blocks{};
+        /// Retrieve the index of a block within blocks given its position relative to the buffer's corner.
+        [[nodiscard]] inline size_t getIdx(int x, int y, int z) const
+        {
+            return (((size_t) y * size.z) + z) * size.x + x;
+        }
     };
-    /**
-     * Appends the information needed when rendering this block.
-     * @param visibility
-     * @param blockIdx
-     * @param currTexture
-     */
-    void appendAllCoordInfo(
-            NeighborInfo* visibility,
-            int blockIdx,
-            BlockTexture currTexture
-    );
 }
 
 #endif //OPENGLDEMO_BLOCK_HPP
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include "nlohmann/json.hpp"
+
+#include "blockRegistry.hpp"
+
+using json = nlohmann::json;
+
+namespace Craft
+{
+    /// The number of bits holding the texture layer of a face within the side data.
+    const int FACE_LAYER_BITS = 3;
+    /// The first bit of the texture layers within the side data.
+    const int FACE_LAYER_OFFSET = 8;
+
+    BlockRegistry::BlockRegistry()
+    {
+        registerBlock("air", false, 0);
+        sideData[AIR_BLOCK_ID] = 0;
+    }
+    bool BlockRegistry::initRegistry()
+    {
+        std::filesystem::path filePath = std::filesystem::current_path().parent_path() / "src/assets/json/blocks.json";
+        std::ifstream file(filePath);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open file: " << filePath << std::endl;
+            return false;
+        }
+        json blocksJSON = json::parse(file);
+        for (auto iter=blocksJSON.begin(); iter!=blocksJSON.end(); iter++)
+        {
+            registerBlock(
+                iter.key(),
+                iter.value().value("opaque", true),
+                (uint8_t) iter.value().value("lightEmission", 0)
+            );
+        }
+        std::cout << "Registered " << names.size() << " block types." << std::endl;
+        return true;
+    }
+    BlockId BlockRegistry::registerBlock(const std::string& name, bool isOpaque, uint8_t emission)
+    {
+        auto nameIter = nameToId.find(name);
+        if (nameIter != nameToId.end())
+        {
+            return nameIter->second;
+        }
+        auto id = (BlockId) names.size();
+        nameToId[name] = id;
+        names.push_back(name);
+        opaque.push_back(isOpaque ? 1 : 0);
+        lightEmission.push_back(std::min<uint8_t>(emission, 15));
+        faceLayers.insert(faceLayers.end(), SIDES_PER_BLOCK, 0);
+        // Bit 0 marks that a block exists at the position.
+        sideData.push_back(1);
+        return id;
+    }
+    BlockId BlockRegistry::getId(const std::string& name) const
+    {
+        auto nameIter = nameToId.find(name);
+        return nameIter == nameToId.end() ? AIR_BLOCK_ID : nameIter->second;
+    }
+    void BlockRegistry::setFaceLayer(BlockId id, int face, uint32_t layer)
+    {
+        if (layer >= (1 << FACE_LAYER_BITS))
+        {
+            std::cerr << "Texture layer " << layer << " of " << names[id] << " does not fit in the side data." << std::endl;
+            return;
+        }
+        faceLayers[(id * SIDES_PER_BLOCK) + face] = (uint8_t) layer;
+        int shift = (face * FACE_LAYER_BITS) + FACE_LAYER_OFFSET;
+        sideData[id] = (sideData[id] & ~(((1 << FACE_LAYER_BITS) - 1) << shift)) | ((int) layer << shift);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef OPENGLDEMO_BLOCKREGISTRY_HPP
+#define OPENGLDEMO_BLOCKREGISTRY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../misc/globals.hpp"
+
+namespace Craft
+{
+    /// A dense identifier of a block type, used to index the BlockRegistry's property tables.
+    typedef uint16_t BlockId;
+    /// The identifier of air, registered before any other block.
+    const BlockId AIR_BLOCK_ID = 0;
+
+    /**
+     * A registry of every block type, storing each property in its own table indexed by BlockId.
+     *
+     * Block types are defined in assets/json/blocks.json, so adding a block only requires a new entry there (and in
+     * texture_mapping.json for its textures). Hot paths resolve the BlockIds they need once, then read the tables
+     * directly.
+     */
+    class BlockRegistry
+    {
+    public:
+        BlockRegistry();
+        ~BlockRegistry() = default;
+        /**
+         * Register every block defined in assets/json/blocks.json.
+         *
+         * @return: True if the definitions were loaded, else False.
+         */
+        bool initRegistry();
+        /**
+         * Register a block type.
+         *
+         * @param name:          The lowercase name of the block.
+         * @param opaque:        Whether the block hides the faces of its neighbors.
+         * @param lightEmission: The light level emitted by the block [0, 15].
+         * @return:              The identifier of the block, or the existing identifier if already registered.
+         */
+        BlockId registerBlock(const std::string& name, bool opaque, uint8_t lightEmission);
+        /**
+         * Retrieve the identifier of a block given its name.
+         *
+         * @param name: The lowercase name of the block.
+         * @return:     The identifier of the block, AIR_BLOCK_ID if no block has the given name.
+         */
+        [[nodiscard]] BlockId getId(const std::string& name) const;
+        /**
+         * Set the texture layer of one of the block's faces.
+         *
+         * @param id:    The identifier of the block.
+         * @param face:  The face of the block: 0 top, 1 bottom, 2 front, 3 right, 4 back, 5 left.
+         * @param layer: The layer of the texture in the Sampler2DArray.
+         */
+        void setFaceLayer(BlockId id, int face, uint32_t layer);
+        /// Retrieve the number of registered blocks, including air.
+        [[nodiscard]] inline size_t getNumBlocks() const { return names.size(); }
+        /// Retrieve the name of a block.
+        [[nodiscard]] inline const std::string& getName(BlockId id) const { return names[id]; }
+        /// Retrieve whether a block hides the faces of its neighbors.
+        [[nodiscard]] inline bool isOpaque(BlockId id) const { return opaque[id] != 0; }
+        /// Retrieve the light level emitted by a block.
+        [[nodiscard]] inline uint8_t getLightEmission(BlockId id) const { return lightEmission[id]; }
+        /// Retrieve the texture layer of one of the block's faces.
+        [[nodiscard]] inline uint8_t getFaceLayer(BlockId id, int face) const { return faceLayers[(id * SIDES_PER_BLOCK) + face]; }
+        /**
+         * Retrieve the block's packed side data: the exists bit and the 3 bit texture layer of every face, laid out
+         * as expected by NeighborInfo::sideData.
+         */
+        [[nodiscard]] inline int getSideData(BlockId id) const { return sideData[id]; }
+    private:
+        /// A mapping of block names to their identifier.
+        std::unordered_map<std::string, BlockId> nameToId{};
+        /// The name of every block.
+        std::vector<std::string> names{};
+        /// Whether every block is opaque.
+        std::vector<uint8_t> opaque{};
+        /// The light level emitted by every block.
+        std::vector<uint8_t> lightEmission{};
+        /// The texture layer of every face of every block, SIDES_PER_BLOCK entries per block.
+        std::vector<uint8_t> faceLayers{};
+        /// The packed side data of every block.
+        std::vector<int> sideData{};
+    };
+}
+
+#endif //OPENGLDEMO_BLOCKREGISTRY_HPP
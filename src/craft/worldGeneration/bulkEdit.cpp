@@ -0,0 +1,118 @@
+#include <cmath>
+#include <algorithm>
+
+#include "bulkEdit.hpp"
+#include "lightEngine.hpp"
+
+namespace Craft
+{
+    /// Retrieve the chunk coordinate holding a world x or z coordinate.
+    static int getChunkCoord(int worldCoord)
+    {
+        return (int) std::floor((float) worldCoord / (float) CHUNK_WIDTH);
+    }
+    void orderCorners(Coordinate<int>& minCorner, Coordinate<int>& maxCorner)
+    {
+        Coordinate<int> first = minCorner;
+        minCorner = {std::min(first.x, maxCorner.x), std::min(first.y, maxCorner.y), std::min(first.z, maxCorner.z)};
+        maxCorner = {std::max(first.x, maxCorner.x), std::max(first.y, maxCorner.y), std::max(first.z, maxCorner.z)};
+    }
+    std::vector<ChunkBox> splitBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner)
+    {
+        Coordinate<int> minCorner = firstCorner;
+        Coordinate<int> maxCorner = secondCorner;
+        orderCorners(minCorner, maxCorner);
+        minCorner.y = std::max(minCorner.y, 0);
+        maxCorner.y = std::min(maxCorner.y, CHUNK_HEIGHT - 1);
+        std::vector<ChunkBox> parts{};
+        if (minCorner.y > maxCorner.y) return parts;
+        for (int chunkZ=getChunkCoord(minCorner.z); chunkZ<=getChunkCoord(maxCorner.z); chunkZ++)
+        {
+            for (int chunkX=getChunkCoord(minCorner.x); chunkX<=getChunkCoord(maxCorner.x); chunkX++)
+            {
+                ChunkBox part{{chunkX, chunkZ}, {}, {}};
+                Coordinate<int> chunkOrigin = part.getOrigin();
+                part.minPos = {
+                    std::max(minCorner.x - chunkOrigin.x, 0), minCorner.y, std::max(minCorner.z - chunkOrigin.z, 0)
+                };
+                part.maxPos = {
+                    std::min(maxCorner.x - chunkOrigin.x, CHUNK_WIDTH - 1),
+                    maxCorner.y,
+                    std::min(maxCorner.z - chunkOrigin.z, CHUNK_WIDTH - 1)
+                };
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+    void copyColumns(
+            const ChunkColumns& columns,
+            Coordinate2D<int> chunkPos,
+            Coordinate<int> minCorner,
+            Coordinate<int> maxCorner,
+            BlockBuffer& out
+        )
+    {
+        int originX = chunkPos.x * CHUNK_WIDTH;
+        int originZ = chunkPos.z * CHUNK_WIDTH;
+        int endZ = std::min(maxCorner.z - originZ, CHUNK_WIDTH - 1);
+        int endX = std::min(maxCorner.x - originX, CHUNK_WIDTH - 1);
+        for (int zIdx=std::max(minCorner.z - originZ, 0); zIdx<=endZ; zIdx++)
+        {
+            for (int xIdx=std::max(minCorner.x - originX, 0); xIdx<=endX; xIdx++)
+            {
+                int yIdx = 0;
+                for (const ColumnRun* run=columns.columnBegin(xIdx, zIdx); run!=columns.columnEnd(xIdx, zIdx); run++)
+                {
+                    for (; yIdx<=run->top; yIdx++)
+                    {
+                        if (yIdx < minCorner.y || yIdx > maxCorner.y) continue;
+                        size_t bufferIdx = out.getIdx(
+                            originX + xIdx - minCorner.x, yIdx - minCorner.y, originZ + zIdx - minCorner.z
+                        );
+                        out.blocks[bufferIdx] = run->id;
+                    }
+                }
+            }
+        }
+    }
+    std::vector<Coordinate2D<int>> getRelitChunks(
+            const std::vector<Coordinate2D<int>>& editedChunks,
+            const std::function<bool(Coordinate2D<int>)>& isLoaded
+        )
+    {
+        // Light never travels further than a chunk, so only the chunks around the edited ones may be affected.
+        std::vector<Coordinate2D<int>> relitChunks = editedChunks;
+        for (const Coordinate2D<int>& chunkPos: editedChunks)
+        {
+            for (int idx=0; idx<LIGHT_NEIGHBORHOOD_CHUNKS; idx++)
+            {
+                Coordinate2D<int> neighborPos = chunkPos + Coordinate2D<int>{(idx % 3) - 1, (idx / 3) - 1};
+                if (std::find(relitChunks.begin(), relitChunks.end(), neighborPos) != relitChunks.end()) continue;
+                if (!isLoaded(neighborPos)) continue;
+                relitChunks.push_back(neighborPos);
+            }
+        }
+        return relitChunks;
+    }
+    std::vector<Coordinate2D<int>> getStaleChunks(
+            const std::vector<Coordinate2D<int>>& editedChunks,
+            const std::vector<uint8_t>& borderMasks,
+            const std::function<bool(Coordinate2D<int>)>& isLoaded
+        )
+    {
+        std::vector<Coordinate2D<int>> staleChunks = editedChunks;
+        for (size_t idx=0; idx<editedChunks.size(); idx++)
+        {
+            for (int neighbor=0; neighbor<4; neighbor++)
+            {
+                if (((borderMasks[idx] >> neighbor) & 1) == 0) continue;
+                Coordinate2D<int> neighborPos = editedChunks[idx] + CHUNK_NEIGHBOR_OFFSETS[neighbor];
+                if (std::find(staleChunks.begin(), staleChunks.end(), neighborPos) != staleChunks.end()) continue;
+                if (!isLoaded(neighborPos)) continue;
+                staleChunks.push_back(neighborPos);
+            }
+        }
+        return staleChunks;
+    }
+}
@@ -0,0 +1,184 @@
+#ifndef OPENGLDEMO_BULKEDIT_HPP
+#define OPENGLDEMO_BULKEDIT_HPP
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+#include "block.hpp"
+#include "chunkColumns.hpp"
+#include "../misc/coordinate.hpp"
+#include "../misc/globals.hpp"
+
+namespace Craft
+{
+    /// The outcome of a bulk edit of a chunk's blocks.
+    struct ChunkEditResult
+    {
+        /// Whether any block of the chunk changed.
+        bool changed{false};
+        /**
+         * The bordering chunks facing a changed block, whose neighbor information is stale. One bit per neighbor in
+         * the order x max, x min, z max, z min.
+         */
+        uint8_t borderMask{0};
+    };
+    /// The part of a bulk edit's box within a single chunk.
+    struct ChunkBox
+    {
+        /// The position of the chunk.
+        Coordinate2D<int> chunkPos;
+        /// The chunk relative corner of the part with the lowest coordinates, inclusive.
+        Coordinate<int> minPos;
+        /// The chunk relative corner of the part with the highest coordinates, inclusive.
+        Coordinate<int> maxPos;
+        /// Retrieve the world position of the chunk's corner with the lowest coordinates.
+        [[nodiscard]] inline Coordinate<int> getOrigin() const
+        {
+            return {chunkPos.x * CHUNK_WIDTH, 0, chunkPos.z * CHUNK_WIDTH};
+        }
+    };
+    /// Order the corners of a box so the first holds its lowest coordinates and the second its highest.
+    void orderCorners(Coordinate<int>& minCorner, Coordinate<int>& maxCorner);
+    /**
+     * Split a box into its parts within each chunk, dropping the blocks above and below the world.
+     *
+     * @param firstCorner:  The world position of a corner of the box, inclusive.
+     * @param secondCorner: The world position of the opposite corner of the box, inclusive.
+     * @return:             The parts of the box, ordered by chunk z then x.
+     */
+    std::vector<ChunkBox> splitBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner);
+    /**
+     * Edit every block within a box of a chunk's columns, rebuilding the columns once for the whole box.
+     *
+     * @param columns:  The blocks of the chunk.
+     * @param minPos:   The chunk relative corner of the box with the lowest coordinates, inclusive.
+     * @param maxPos:   The chunk relative corner of the box with the highest coordinates, inclusive.
+     * @param dense:    Scratch space for BLOCKS_IN_CHUNK block types.
+     * @param edit:     Called with the chunk relative position and type of every block within the box, returns the
+     *                  block's new type.
+     * @param onChange: Called with the index within dense and the new type of every block that changed.
+     * @return:         Whether any block changed and which bordering chunks face the changes.
+     */
+    template<class Edit, class OnChange>
+    ChunkEditResult editColumns(
+            ChunkColumns& columns,
+            Coordinate<int> minPos,
+            Coordinate<int> maxPos,
+            BlockId* dense,
+            Edit&& edit,
+            OnChange&& onChange
+        )
+    {
+        ChunkEditResult result{};
+        columns.toDense(dense);
+        for (int yIdx=minPos.y; yIdx<=maxPos.y; yIdx++)
+        {
+            for (int zIdx=minPos.z; zIdx<=maxPos.z; zIdx++)
+            {
+                for (int xIdx=minPos.x; xIdx<=maxPos.x; xIdx++)
+                {
+                    int blockIdx = (yIdx * CHUNK_SIZE) + (zIdx * CHUNK_WIDTH) + xIdx;
+                    BlockId id = edit(Coordinate<int>{xIdx, yIdx, zIdx}, dense[blockIdx]);
+                    if (id == dense[blockIdx]) continue;
+                    dense[blockIdx] = id;
+                    onChange(blockIdx, id);
+                    result.changed = true;
+                    if (xIdx == CHUNK_WIDTH - 1) result.borderMask |= 1;
+                    if (xIdx == 0) result.borderMask |= 2;
+                    if (zIdx == CHUNK_WIDTH - 1) result.borderMask |= 4;
+                    if (zIdx == 0) result.borderMask |= 8;
+                }
+            }
+        }
+        if (result.changed) columns.fromDense(dense);
+        return result;
+    }
+    /**
+     * Copy the blocks of a chunk within a box into a buffer covering the box.
+     *
+     * @param columns:   The blocks of the chunk.
+     * @param chunkPos:  The position of the chunk.
+     * @param minCorner: The world position of the box's corner with the lowest coordinates.
+     * @param maxCorner: The world position of the box's corner with the highest coordinates.
+     * @param out:       The buffer to write to, already sized to the box.
+     */
+    void copyColumns(
+        const ChunkColumns& columns,
+        Coordinate2D<int> chunkPos,
+        Coordinate<int> minCorner,
+        Coordinate<int> maxCorner,
+        BlockBuffer& out
+    );
+    /**
+     * Retrieve the chunks a bulk edit lights from scratch: the changed chunks, which may have lost light to the old
+     * blocks, and the loaded chunks around them, which may still hold light that came from the old blocks.
+     *
+     * @param editedChunks: The chunks whose blocks changed.
+     * @param isLoaded:     Whether a chunk may be relit.
+     * @return:             Every chunk to relight once, the edited chunks first.
+     */
+    std::vector<Coordinate2D<int>> getRelitChunks(
+        const std::vector<Coordinate2D<int>>& editedChunks,
+        const std::function<bool(Coordinate2D<int>)>& isLoaded
+    );
+    /**
+     * Retrieve the chunks a bulk edit sends back through the pipeline: the changed chunks, and the loaded chunks
+     * facing their changed borders.
+     *
+     * @param editedChunks: The chunks whose blocks changed.
+     * @param borderMasks:  The bordering chunks facing each edited chunk's changes, as in ChunkEditResult.
+     * @param isLoaded:     Whether a chunk may be sent through the pipeline.
+     * @return:             Every stale chunk once, the edited chunks first.
+     */
+    std::vector<Coordinate2D<int>> getStaleChunks(
+        const std::vector<Coordinate2D<int>>& editedChunks,
+        const std::vector<uint8_t>& borderMasks,
+        const std::function<bool(Coordinate2D<int>)>& isLoaded
+    );
+
+    /// A bulk edit setting every block to one type.
+    struct FillEdit
+    {
+        BlockId id;
+        inline BlockId operator()(Coordinate<int>, BlockId) const { return id; }
+    };
+    /// A bulk edit setting every block within a sphere to one type.
+    struct SphereEdit
+    {
+        /// The world position of the sphere's center.
+        Coordinate<int> center;
+        int radiusSquared;
+        BlockId id;
+        inline BlockId operator()(Coordinate<int> blockPos, BlockId current) const
+        {
+            int dx = blockPos.x - center.x;
+            int dy = blockPos.y - center.y;
+            int dz = blockPos.z - center.z;
+            return (dx * dx) + (dy * dy) + (dz * dz) <= radiusSquared ? id : current;
+        }
+    };
+    /// A bulk edit replacing every block of one type with another type.
+    struct ReplaceEdit
+    {
+        BlockId from;
+        BlockId to;
+        inline BlockId operator()(Coordinate<int>, BlockId current) const { return current == from ? to : current; }
+    };
+    /// A bulk edit writing a buffer of blocks, skipping its air unless pasteAir is set.
+    struct PasteEdit
+    {
+        /// The world position of the buffer's corner with the lowest coordinates.
+        Coordinate<int> origin;
+        const BlockBuffer* buffer;
+        bool pasteAir;
+        inline BlockId operator()(Coordinate<int> blockPos, BlockId current) const
+        {
+            size_t bufferIdx = buffer->getIdx(blockPos.x - origin.x, blockPos.y - origin.y, blockPos.z - origin.z);
+            BlockId id = buffer->blocks[bufferIdx];
+            return id == AIR_BLOCK_ID && !pasteAir ? current : id;
+        }
+    };
+}
+
+#endif //OPENGLDEMO_BULKEDIT_HPP
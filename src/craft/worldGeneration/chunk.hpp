@@ -9,8 +9,15 @@
 #include <functional>
 #include <thread>
 #include <bitset>
+#include <atomic>
+#include <mutex>
 
 #include "block.hpp"
+#include "blockRegistry.hpp"
+#include "bulkEdit.hpp"
+#include "densityField.hpp"
+#include "faceExtractor.hpp"
+#include "lightEngine.hpp"
 #include "../misc/coordinate.hpp"
 #include "../misc/globals.hpp"
 #include "../misc/textures.hpp"
@@ -19,39 +26,176 @@
 
 namespace Craft
 {
+    /**
+     * The lifecycle of a chunk.
+     *
+     * A chunk is owned by the stage that moved it into its current state, so only one thread works on a chunk at a
+     * time while independent chunks progress concurrently. The pending states follow the order of the chunk
+     * pipeline: generate, neighbor, ambient occlusion, mesh, upload.
+     */
+    enum class ChunkState : uint8_t
+    {
+        /// The blocks of the chunk are being generated.
+        GENERATING,
+        /// The chunk is waiting for its bordering chunks to generate before the neighbor compute.
+        NEIGHBORS_PENDING,
+        /// The chunk is waiting for the ambient occlusion compute.
+        AMBIENT_PENDING,
+        /// The chunk is waiting to be meshed.
+        MESH_PENDING,
+        /// A worker is building the chunk's instance lists.
+        MESHING,
+        /// The chunk's instance lists are built and its draw commands are waiting to be written.
+        UPLOAD_PENDING,
+        /// The chunk is drawn and may be edited or remeshed.
+        READY,
+        /// The chunk is being removed from the world.
+        UNLOADING
+    };
+    /// The number of chunk states.
+    const int NUM_CHUNK_STATES = (int) ChunkState::UNLOADING + 1;
+    /// The names of the chunk states, indexed by ChunkState.
+    constexpr const char* CHUNK_STATE_NAMES[NUM_CHUNK_STATES] = {
+        "generating", "neighbors pending", "ambient pending", "mesh pending", "meshing", "upload pending", "ready",
+        "unloading"
+    };
     class Chunk
     {
     public:
         Chunk(
             Coordinate2D<int> chunkPos,
-            std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords,
+            ChunkBlockMaps* coords,
             std::mutex* coordsMutex
         );
         ~Chunk();
-        /// Initialize a Chunk found at the x, z coordinates.
-        void initChunk(NeighborInfo* visibility, Textures* textures);
-        /// A bitset for every block in the chunk. Set to true if a block occupies that space, otherwise false.
-        std::unordered_map<Coordinate<int>, Block> blockCoords{0};
         /**
-         * Create a block at the given position.
+         * Initialize a Chunk found at the x, z coordinates.
          *
-         * @param blockPos:   The position at which to create a block.
-         * @param textures:   The textures for all blocks.
          * @param visibility: The neighbor information for the given chunk.
+         * @param registry:   The registry of all block types.
+         * @param grassId:    The block at the surface of the terrain.
+         * @param stoneId:    The block below the surface of the terrain.
+         * @param terrain:    The density field generating the world's terrain, nullptr if the occupancy was already
+         *                    generated on the GPU and given to setOccupancy.
+         */
+        void initChunk(
+            NeighborInfo* visibility,
+            const BlockRegistry* registry,
+            BlockId grassId,
+            BlockId stoneId,
+            DensityField* terrain
+        );
+        /**
+         * Reuse the chunk for another position, emptying it while keeping its storage. The chunk must not be in the
+         * world's maps or referenced by any task.
+         *
+         * @param newChunkPos: The position of the chunk.
          */
-        void createBlock(Coordinate<int> blockPos, Textures* textures, NeighborInfo* visibility);
+        void resetChunk(Coordinate2D<int> newChunkPos);
         /**
-         * Delete a block at the given position.
+         * Set the type of a block, marking every side of a new block visible until the neighbor information is
+         * recalculated.
          *
-         * @param blockPos:   The position at which to delete the block.
+         * @param blockPos:   The chunk relative position of the block.
+         * @param id:         The new type of the block, AIR_BLOCK_ID to delete it.
+         * @param registry:   The registry of all block types.
          * @param visibility: The neighbor information for the given chunk.
+         * @return:           True if the block changed, else false.
          */
-        void deleteBlock(Coordinate<int> blockPos, NeighborInfo* visibility);
-        /// The array of all blocks within this chunk.
-        std::unordered_map<Coordinate<int>, Block> blocksMap{};
+        bool setBlock(Coordinate<int> blockPos, BlockId id, const BlockRegistry* registry, NeighborInfo* visibility);
+        /**
+         * Edit every block within a box of the chunk, rebuilding the columns and occupancy once for the whole box.
+         * The visibility bits of the changed blocks are left for the neighbor compute.
+         *
+         * @param minPos:     The chunk relative corner of the box with the lowest coordinates, inclusive.
+         * @param maxPos:     The chunk relative corner of the box with the highest coordinates, inclusive.
+         * @param registry:   The registry of all block types.
+         * @param visibility: The neighbor information for the given chunk.
+         * @param dense:      Scratch space for BLOCKS_IN_CHUNK block types.
+         * @param edit:       Called with the chunk relative position and type of every block within the box, returns
+         *                    the block's new type.
+         * @return:           Whether any block changed and which bordering chunks face the changes.
+         */
+        template<class Edit>
+        ChunkEditResult editBlocks(
+            Coordinate<int> minPos,
+            Coordinate<int> maxPos,
+            const BlockRegistry* registry,
+            NeighborInfo* visibility,
+            BlockId* dense,
+            Edit&& edit
+        )
+        {
+            std::lock_guard<std::mutex> lock(blocksMutex);
+            int chunkOffset = chunkIdx * BLOCKS_IN_CHUNK;
+            ChunkEditResult result = editColumns(
+                columns, minPos, maxPos, dense, std::forward<Edit>(edit),
+                [&](int blockIdx, BlockId id)
+                {
+                    visibility[chunkOffset + blockIdx].sideData = registry->getSideData(id);
+                }
+            );
+            if (!result.changed) return result;
+            occupancy = ChunkOccupancy{};
+            columns.toOccupancy(occupancy);
+            return result;
+        }
+        /// The blocks of the chunk as runs per column, kept in sync with the occupancy.
+        ChunkColumns columns{};
+        /// The sky and block light of the chunk, written by the world's light engine on the thread owning the chunk.
+        ChunkLight light{};
         // Index of the chunk within arrays. Used a lot within buffer objects
         int chunkIdx;
+        /// Retrieve the 2D coordinate (x and z) of the chunk.
+        [[nodiscard]] inline Coordinate2D<int> getChunkPos() const { return chunkPos; }
+        /// Retrieve the lifecycle state of the chunk.
+        [[nodiscard]] inline ChunkState getState() const { return state.load(std::memory_order_acquire); }
+        /// Set the lifecycle state of the chunk. Only the current owner of the chunk should call this.
+        inline void setState(ChunkState newState) { state.store(newState, std::memory_order_release); }
+        /**
+         * Atomically move the chunk from one state to another, taking ownership of it for the new state.
+         *
+         * @param from: The state the chunk is expected to be in.
+         * @param to:   The state to move the chunk into.
+         * @return:     True if the chunk was in the expected state and was moved, else false.
+         */
+        inline bool transitionState(ChunkState from, ChunkState to)
+        {
+            return state.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+        }
+        /**
+         * The bordering chunks that were generated when the chunk's neighbor information was computed, one bit per
+         * neighbor in the order x max, x min, z max, z min. Only accessed by the main thread.
+         */
+        uint8_t neighborMask{0};
+        /**
+         * Move the chunk into the UNLOADING state unless a worker is generating or meshing it. Never waits, a chunk
+         * that is still in flight is retried once the worker hands it back.
+         *
+         * @return: True if the chunk is UNLOADING, else false.
+         */
+        bool tryBeginUnload();
+        /// Lock the chunk's blocks, used by anything reading columns off of the owning thread.
+        [[nodiscard]] inline std::unique_lock<std::mutex> lockBlocks() { return std::unique_lock<std::mutex>(blocksMutex); }
+        /// Retrieve the row occupancy bitmasks of the chunk. Hold lockBlocks() while reading them off of the owning thread.
+        [[nodiscard]] inline const ChunkOccupancy& getOccupancy() const { return occupancy; }
+        /**
+         * Copy the row occupancy bitmasks of the chunk under its lock.
+         *
+         * @param out: The occupancy to write to.
+         */
+        void copyOccupancy(ChunkOccupancy& out);
+        /**
+         * Set the occupancy of a generating chunk from terrain generated on the GPU, before initChunk.
+         *
+         * @param generated: The occupancy of the chunk.
+         */
+        inline void setOccupancy(const ChunkOccupancy& generated) { occupancy = generated; }
     private:
+        /// The row occupancy bitmasks of the chunk, kept in sync with columns.
+        ChunkOccupancy occupancy{};
+        /// The lifecycle state of the chunk.
+        std::atomic<ChunkState> state{ChunkState::GENERATING};
         /// A mutex for accessing the coords set.
         std::mutex* coordsMutex;
         /// A mutex for creating/accessing blocks
@@ -59,7 +203,7 @@ namespace Craft
         /// The 2D coordinate (x and z) of the chunk.
         Coordinate2D<int> chunkPos;
         /// A pointer to the mapping of chunk coordinate to block coord map.
-        std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*>* coords;
+        ChunkBlockMaps* coords;
     };
 }
 
@@ -0,0 +1,225 @@
+#include <cstring>
+#include <algorithm>
+
+#include "chunkColumns.hpp"
+
+namespace Craft
+{
+    /// The runs reserved for a chunk up front, enough for generated terrain.
+    const size_t RESERVED_RUNS = CHUNK_SIZE * 3;
+
+    /**
+     * Build the runs of a column given the type of each of its blocks.
+     *
+     * @param blocks: CHUNK_HEIGHT block types from y = 0 upwards.
+     * @param stride: The distance between the blocks of two neighboring y positions.
+     * @param out:    Where to write the runs, room for CHUNK_HEIGHT runs.
+     * @return:       The number of runs written.
+     */
+    static int buildRuns(const BlockId* blocks, int stride, ColumnRun* out)
+    {
+        int top = CHUNK_HEIGHT - 1;
+        while (top >= 0 && blocks[top * stride] == AIR_BLOCK_ID) top--;
+        int numRuns = 0;
+        for (int yIdx=0; yIdx<=top; yIdx++)
+        {
+            BlockId id = blocks[yIdx * stride];
+            if (numRuns > 0 && out[numRuns - 1].id == id)
+            {
+                out[numRuns - 1].top = (uint8_t) yIdx;
+                continue;
+            }
+            out[numRuns++] = {id, (uint8_t) yIdx, 0};
+        }
+        return numRuns;
+    }
+
+    ChunkColumns::ChunkColumns()
+    {
+        runs.reserve(RESERVED_RUNS);
+        std::fill(std::begin(heightmap), std::end(heightmap), -1);
+    }
+    void ChunkColumns::clear()
+    {
+        runs.clear();
+        std::fill(std::begin(columnStarts), std::end(columnStarts), 0);
+        std::fill(std::begin(heightmap), std::end(heightmap), -1);
+    }
+    void ChunkColumns::fromTerrain(const ChunkOccupancy& occupancy, BlockId surfaceId, BlockId fillId)
+    {
+        runs.clear();
+        BlockId blocks[CHUNK_HEIGHT];
+        ColumnRun columnRuns[CHUNK_HEIGHT];
+        for (int zIdx=0; zIdx<CHUNK_WIDTH; zIdx++)
+        {
+            for (int xIdx=0; xIdx<CHUNK_WIDTH; xIdx++)
+            {
+                int depth = 0;
+                for (int yIdx=CHUNK_HEIGHT - 1; yIdx>=0; yIdx--)
+                {
+                    if (!occupancy.test(xIdx, yIdx, zIdx))
+                    {
+                        blocks[yIdx] = AIR_BLOCK_ID;
+                        depth = 0;
+                        continue;
+                    }
+                    blocks[yIdx] = depth++ >= GRASS_DEPTH ? fillId : surfaceId;
+                }
+                int column = (zIdx * CHUNK_WIDTH) + xIdx;
+                int numRuns = buildRuns(blocks, 1, columnRuns);
+                columnStarts[column] = (uint32_t) runs.size();
+                runs.insert(runs.end(), columnRuns, columnRuns + numRuns);
+                heightmap[column] = (int16_t) (numRuns == 0 ? -1 : columnRuns[numRuns - 1].top);
+            }
+        }
+        columnStarts[CHUNK_SIZE] = (uint32_t) runs.size();
+    }
+    void ChunkColumns::fromDense(const BlockId* blocks)
+    {
+        runs.clear();
+        ColumnRun columnRuns[CHUNK_HEIGHT];
+        for (int column=0; column<CHUNK_SIZE; column++)
+        {
+            // The dense index of (x, 0, z) is the index of the column.
+            int numRuns = buildRuns(blocks + column, CHUNK_SIZE, columnRuns);
+            columnStarts[column] = (uint32_t) runs.size();
+            runs.insert(runs.end(), columnRuns, columnRuns + numRuns);
+            heightmap[column] = (int16_t) (numRuns == 0 ? -1 : columnRuns[numRuns - 1].top);
+        }
+        columnStarts[CHUNK_SIZE] = (uint32_t) runs.size();
+    }
+    void ChunkColumns::toDense(BlockId* blocks) const
+    {
+        std::fill(blocks, blocks + BLOCKS_IN_CHUNK, AIR_BLOCK_ID);
+        for (int column=0; column<CHUNK_SIZE; column++)
+        {
+            int yIdx = 0;
+            for (uint32_t runIdx=columnStarts[column]; runIdx<columnStarts[column + 1]; runIdx++)
+            {
+                const ColumnRun& run = runs[runIdx];
+                for (; yIdx<=run.top; yIdx++) blocks[(yIdx * CHUNK_SIZE) + column] = run.id;
+            }
+        }
+    }
+    void ChunkColumns::toOccupancy(ChunkOccupancy& occupancy) const
+    {
+        for (int column=0; column<CHUNK_SIZE; column++)
+        {
+            int xIdx = column % CHUNK_WIDTH;
+            int zIdx = column / CHUNK_WIDTH;
+            int yIdx = 0;
+            for (uint32_t runIdx=columnStarts[column]; runIdx<columnStarts[column + 1]; runIdx++)
+            {
+                const ColumnRun& run = runs[runIdx];
+                if (run.id == AIR_BLOCK_ID)
+                {
+                    yIdx = run.top + 1;
+                    continue;
+                }
+                for (; yIdx<=run.top; yIdx++) occupancy.set(xIdx, yIdx, zIdx);
+            }
+        }
+    }
+    BlockId ChunkColumns::getBlock(int x, int y, int z) const
+    {
+        if (y < 0 || y >= CHUNK_HEIGHT) return AIR_BLOCK_ID;
+        for (const ColumnRun* run=columnBegin(x, z); run!=columnEnd(x, z); run++)
+        {
+            if (y <= run->top) return run->id;
+        }
+        return AIR_BLOCK_ID;
+    }
+    bool ChunkColumns::setBlock(int x, int y, int z, BlockId id)
+    {
+        if (y < 0 || y >= CHUNK_HEIGHT || getBlock(x, y, z) == id) return false;
+        // Expand the column, edit it and rebuild its runs in place.
+        BlockId blocks[CHUNK_HEIGHT];
+        std::fill(std::begin(blocks), std::end(blocks), AIR_BLOCK_ID);
+        int yIdx = 0;
+        for (const ColumnRun* run=columnBegin(x, z); run!=columnEnd(x, z); run++)
+        {
+            for (; yIdx<=run->top; yIdx++) blocks[yIdx] = run->id;
+        }
+        blocks[y] = id;
+        ColumnRun columnRuns[CHUNK_HEIGHT];
+        int numRuns = buildRuns(blocks, 1, columnRuns);
+
+        int column = (z * CHUNK_WIDTH) + x;
+        auto begin = (ptrdiff_t) columnStarts[column];
+        auto oldRuns = (ptrdiff_t) (columnStarts[column + 1] - columnStarts[column]);
+        ptrdiff_t delta = numRuns - oldRuns;
+        if (delta > 0)
+        {
+            runs.insert(runs.begin() + begin + oldRuns, (size_t) delta, ColumnRun{});
+        }
+        else if (delta < 0)
+        {
+            runs.erase(runs.begin() + begin + numRuns, runs.begin() + begin + oldRuns);
+        }
+        std::copy(columnRuns, columnRuns + numRuns, runs.begin() + begin);
+        for (int nextColumn=column + 1; nextColumn<=CHUNK_SIZE; nextColumn++)
+        {
+            columnStarts[nextColumn] = (uint32_t) ((ptrdiff_t) columnStarts[nextColumn] + delta);
+        }
+        updateHeight(column);
+        return true;
+    }
+    void ChunkColumns::encode(const std::vector<BlockId>& palette, std::vector<uint8_t>& out) const
+    {
+        for (int column=0; column<CHUNK_SIZE; column++)
+        {
+            auto numRuns = (uint16_t) (columnStarts[column + 1] - columnStarts[column]);
+            size_t countOffset = out.size();
+            out.insert(out.end(), sizeof(numRuns), 0);
+            std::memcpy(out.data() + countOffset, &numRuns, sizeof(numRuns));
+            int start = 0;
+            for (uint32_t runIdx=columnStarts[column]; runIdx<columnStarts[column + 1]; runIdx++)
+            {
+                const ColumnRun& run = runs[runIdx];
+                auto paletteIdx = std::find(palette.begin(), palette.end(), run.id) - palette.begin();
+                out.push_back((uint8_t) paletteIdx);
+                out.push_back((uint8_t) (run.top - start));
+                start = run.top + 1;
+            }
+        }
+    }
+    bool ChunkColumns::decode(const uint8_t* data, size_t size, const std::vector<BlockId>& palette)
+    {
+        runs.clear();
+        size_t offset = 0;
+        for (int column=0; column<CHUNK_SIZE; column++)
+        {
+            columnStarts[column] = (uint32_t) runs.size();
+            uint16_t numRuns = 0;
+            if (offset + sizeof(numRuns) <= size) std::memcpy(&numRuns, data + offset, sizeof(numRuns));
+            offset += sizeof(numRuns);
+            if (offset > size || numRuns > CHUNK_HEIGHT || offset + ((size_t) numRuns * 2) > size)
+            {
+                clear();
+                return false;
+            }
+            int start = 0;
+            for (int runIdx=0; runIdx<numRuns; runIdx++, offset += 2)
+            {
+                uint8_t paletteIdx = data[offset];
+                int top = start + data[offset + 1];
+                if (paletteIdx >= palette.size() || top >= CHUNK_HEIGHT)
+                {
+                    clear();
+                    return false;
+                }
+                runs.push_back({palette[paletteIdx], (uint8_t) top, 0});
+                start = top + 1;
+            }
+            columnStarts[column + 1] = (uint32_t) runs.size();
+            updateHeight(column);
+        }
+        columnStarts[CHUNK_SIZE] = (uint32_t) runs.size();
+        if (offset != size)
+        {
+            clear();
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef OPENGLDEMO_CHUNKCOLUMNS_HPP
+#define OPENGLDEMO_CHUNKCOLUMNS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "blockRegistry.hpp"
+#include "faceExtractor.hpp"
+#include "../misc/globals.hpp"
+#include "../../helpers/memoryTracker.hpp"
+
+namespace Craft
+{
+    /// A run of blocks of a single type within a column, starting where the previous run of the column ends.
+    struct ColumnRun
+    {
+        /// The type of the blocks in the run, AIR_BLOCK_ID for a gap.
+        BlockId id;
+        /// The y position of the highest block of the run.
+        uint8_t top;
+        uint8_t padding;
+    };
+    static_assert(sizeof(ColumnRun) == 4, "ColumnRun must not contain implicit padding.");
+    static_assert(CHUNK_HEIGHT <= 256, "A run's top is stored in a uint8_t.");
+
+    /**
+     * The blocks of a chunk as a list of runs per x/z column.
+     *
+     * Each column's runs start at y = 0 and end at the column's highest block, so the air above the terrain is not
+     * stored and generated terrain needs two or three runs per column. Neighboring runs of a column never share a
+     * type. The columns are kept back to back in a single buffer, in the order of (z * CHUNK_WIDTH) + x.
+     *
+     * A heightmap of each column's highest block is kept alongside the runs and updated by every edit, so surface
+     * queries read a single entry.
+     */
+    class ChunkColumns
+    {
+    public:
+        ChunkColumns();
+        ~ChunkColumns() = default;
+        /// Remove every block, keeping the storage of the runs.
+        void clear();
+        /**
+         * Build the columns of generated terrain, where the top GRASS_DEPTH solid blocks below air are the surface.
+         *
+         * @param occupancy: The occupancy of the chunk.
+         * @param surfaceId: The type of the surface blocks.
+         * @param fillId:    The type of the blocks below the surface.
+         */
+        void fromTerrain(const ChunkOccupancy& occupancy, BlockId surfaceId, BlockId fillId);
+        /**
+         * Build the columns from a dense array of blocks.
+         *
+         * @param blocks: BLOCKS_IN_CHUNK block types indexed by (y * CHUNK_SIZE) + (z * CHUNK_WIDTH) + x.
+         */
+        void fromDense(const BlockId* blocks);
+        /**
+         * Expand the columns into a dense array of blocks.
+         *
+         * @param blocks: BLOCKS_IN_CHUNK block types indexed by (y * CHUNK_SIZE) + (z * CHUNK_WIDTH) + x.
+         */
+        void toDense(BlockId* blocks) const;
+        /**
+         * Set the bits of every block within the columns.
+         *
+         * @param occupancy: The occupancy to write to, expected to be empty.
+         */
+        void toOccupancy(ChunkOccupancy& occupancy) const;
+        /**
+         * Retrieve the type of a block.
+         *
+         * @param x: The chunk relative x position of the block.
+         * @param y: The y position of the block, positions outside of the world are air.
+         * @param z: The chunk relative z position of the block.
+         * @return:  The type of the block, AIR_BLOCK_ID if no block exists.
+         */
+        [[nodiscard]] BlockId getBlock(int x, int y, int z) const;
+        /// Retrieve whether a block exists at the chunk relative position.
+        [[nodiscard]] inline bool blockExists(int x, int y, int z) const { return getBlock(x, y, z) != AIR_BLOCK_ID; }
+        /**
+         * Retrieve the highest block of a column.
+         *
+         * @param x: The chunk relative x position of the column.
+         * @param z: The chunk relative z position of the column.
+         * @return:  The y position of the highest block, -1 if the column is empty.
+         */
+        [[nodiscard]] inline int getTopBlock(int x, int z) const { return heightmap[(z * CHUNK_WIDTH) + x]; }
+        /// Retrieve the highest block of every column, CHUNK_SIZE entries in the order of (z * CHUNK_WIDTH) + x.
+        [[nodiscard]] inline const int16_t* getHeightmap() const { return heightmap; }
+        /**
+         * Set the type of a block, splitting or merging the runs of its column.
+         *
+         * @param x:  The chunk relative x position of the block.
+         * @param y:  The y position of the block.
+         * @param z:  The chunk relative z position of the block.
+         * @param id: The new type of the block, AIR_BLOCK_ID to remove it.
+         * @return:   True if the block changed, else false.
+         */
+        bool setBlock(int x, int y, int z, BlockId id);
+        /// Retrieve the first run of a column.
+        [[nodiscard]] inline const ColumnRun* columnBegin(int x, int z) const { return runs.data() + columnStarts[(z * CHUNK_WIDTH) + x]; }
+        /// Retrieve the end of a column's runs.
+        [[nodiscard]] inline const ColumnRun* columnEnd(int x, int z) const { return runs.data() + columnStarts[(z * CHUNK_WIDTH) + x + 1]; }
+        /// Retrieve the number of runs within the chunk.
+        [[nodiscard]] inline size_t getNumRuns() const { return runs.size(); }
+        /// Retrieve the heap and inline bytes used by the columns.
+        [[nodiscard]] inline size_t getMemoryUsage() const { return sizeof(ChunkColumns) + (runs.capacity() * sizeof(ColumnRun)); }
+        /**
+         * Encode the columns in the layout of a region file's chunk.
+         *
+         * @param palette: The block types of the region's palette, indexed by palette index. Must contain every type
+         *                 within the columns.
+         * @param out:     The buffer the encoded columns are appended to.
+         */
+        void encode(const std::vector<BlockId>& palette, std::vector<uint8_t>& out) const;
+        /**
+         * Decode columns written by encode.
+         *
+         * @param data:    The encoded columns.
+         * @param size:    The size of the encoded columns in bytes.
+         * @param palette: The block types of the region's palette, indexed by palette index.
+         * @return:        True if the columns were decoded, else false and the columns are empty.
+         */
+        bool decode(const uint8_t* data, size_t size, const std::vector<BlockId>& palette);
+    private:
+        /// The runs of every column, back to back.
+        std::vector<ColumnRun, Engine::TrackedAllocator<ColumnRun, Engine::CHUNK_MEMORY>> runs{};
+        /// The index of each column's first run within runs, the last entry is the end of the last column.
+        uint32_t columnStarts[CHUNK_SIZE + 1]{};
+        /// The y position of each column's highest block, -1 for an empty column.
+        int16_t heightmap[CHUNK_SIZE]{};
+        /// Set the heightmap entry of a column from the top of its last run.
+        inline void updateHeight(int column)
+        {
+            heightmap[column] = (int16_t) (columnStarts[column] == columnStarts[column + 1] ? -1 : runs[columnStarts[column + 1] - 1].top);
+        }
+    };
+}
+
+#endif //OPENGLDEMO_CHUNKCOLUMNS_HPP
@@ -0,0 +1,44 @@
+#include "chunkPool.hpp"
+
+namespace Craft
+{
+    ChunkPool::ChunkPool(ChunkBlockMaps* coords, std::mutex* coordsMutex)
+        : coords{coords}
+        , coordsMutex{coordsMutex}
+    {}
+    void ChunkPool::reserve(size_t numChunks)
+    {
+        Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+        std::lock_guard<std::mutex> lock(poolMutex);
+        releasedChunks.reserve(numChunks * 2);
+        while (releasedChunks.size() < numChunks)
+        {
+            releasedChunks.push_back(std::make_shared<Chunk>(Coordinate2D<int>{0, 0}, coords, coordsMutex));
+            numCreated++;
+        }
+    }
+    std::shared_ptr<Chunk> ChunkPool::acquire(Coordinate2D<int> chunkPos)
+    {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            for (size_t idx=0; idx<releasedChunks.size(); idx++)
+            {
+                // Still held by a task that has not finished yet.
+                if (releasedChunks[idx].use_count() != 1) continue;
+                std::shared_ptr<Chunk> chunk = std::move(releasedChunks[idx]);
+                releasedChunks[idx] = std::move(releasedChunks.back());
+                releasedChunks.pop_back();
+                chunk->resetChunk(chunkPos);
+                return chunk;
+            }
+        }
+        Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+        numCreated++;
+        return std::make_shared<Chunk>(chunkPos, coords, coordsMutex);
+    }
+    void ChunkPool::release(std::shared_ptr<Chunk> chunk)
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        releasedChunks.push_back(std::move(chunk));
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef OPENGLDEMO_CHUNKPOOL_HPP
+#define OPENGLDEMO_CHUNKPOOL_HPP
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#include "chunk.hpp"
+
+namespace Craft
+{
+    /**
+     * Recycles Chunk instances, and with them the nodes and buckets of their block maps, so streaming chunks in and
+     * out does not go through the heap once the pool has warmed up.
+     *
+     * A released chunk is only reused once every task holding it has let go of it.
+     */
+    class ChunkPool
+    {
+    public:
+        /**
+         * @param coords:      The mapping of chunk positions to block maps given to every chunk.
+         * @param coordsMutex: The mutex guarding coords.
+         */
+        ChunkPool(ChunkBlockMaps* coords, std::mutex* coordsMutex);
+        ~ChunkPool() = default;
+        /**
+         * Create the given number of chunks up front.
+         *
+         * @param numChunks: The number of free chunks the pool should hold.
+         */
+        void reserve(size_t numChunks);
+        /**
+         * Retrieve an empty chunk in the GENERATING state, recycling a released chunk when one is free.
+         *
+         * @param chunkPos: The position of the chunk.
+         * @return:         The chunk.
+         */
+        std::shared_ptr<Chunk> acquire(Coordinate2D<int> chunkPos);
+        /**
+         * Hand an unloaded chunk back to the pool. The chunk must already be erased from the world's maps.
+         *
+         * @param chunk: The chunk.
+         */
+        void release(std::shared_ptr<Chunk> chunk);
+        /// Retrieve the number of chunks ever created by the pool.
+        [[nodiscard]] inline size_t getNumCreated() const { return numCreated; }
+    private:
+        /// The mapping of chunk positions to block maps given to every chunk.
+        ChunkBlockMaps* coords;
+        /// The mutex guarding coords.
+        std::mutex* coordsMutex;
+        /// Guards releasedChunks, chunks are released by the unload task.
+        std::mutex poolMutex{};
+        /// The chunks handed back to the pool, possibly still held by a finishing task.
+        std::vector<std::shared_ptr<Chunk>> releasedChunks{};
+        /// The number of chunks ever created by the pool.
+        std::atomic<size_t> numCreated{0};
+    };
+}
+
+#endif //OPENGLDEMO_CHUNKPOOL_HPP
@@ -0,0 +1,206 @@
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <immintrin.h>
+
+#include "densityField.hpp"
+#include "../../helpers/arena.hpp"
+
+namespace Craft
+{
+    /// The scale applied to world coordinates before sampling the surface's noise.
+    const float SURFACE_NOISE_SCALE = 1.0f / 7.0f;
+    /// The number of blocks the surface varies by.
+    const float SURFACE_HEIGHT_RANGE = 7.0f;
+
+    /// Lattice points queued for sampling, evaluated one __m256 at a time.
+    struct SampleBatch
+    {
+        alignas(32) float x[8]{};
+        alignas(32) float y[8]{};
+        alignas(32) float z[8]{};
+        /// The entry each queued sample is written to.
+        int targets[8]{};
+        int count{0};
+    };
+
+    /**
+     * Retrieve the index of a lattice point.
+     *
+     * @param x: The index of the point along x.
+     * @param y: The index of the point along y.
+     * @param z: The index of the point along z.
+     * @return:  The index of the point within the lattice.
+     */
+    static inline int latticeIdx(int x, int y, int z)
+    {
+        return (((y * DENSITY_LATTICE_XZ) + z) * DENSITY_LATTICE_XZ) + x;
+    }
+    /// Bilinearly interpolate between the four corners of a lattice cell's face.
+    static inline float bilerp(float c00, float c10, float c01, float c11, float tx, float tz)
+    {
+        float low = c00 + ((c10 - c00) * tx);
+        float high = c01 + ((c11 - c01) * tx);
+        return low + ((high - low) * tz);
+    }
+
+    DensityField::DensityField(uint32_t seed, NoiseBackend backend)
+        : noise(seed, backend)
+    {
+        // The surface keeps the parameters of the original heightmap generator.
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(1, 100);
+        surfaceAmplitude = (float) dis(gen) / 10.0f;
+        surfaceFrequency = (float) dis(gen) / 100.0f;
+    }
+    void DensityField::sampleLattice(Coordinate2D<int> chunkPos, float* density)
+    {
+        const int chunkBaseX = chunkPos.x * CHUNK_WIDTH;
+        const int chunkBaseZ = chunkPos.z * CHUNK_WIDTH;
+        SampleBatch batch{};
+
+        // The height of the surface at every lattice column.
+        float surface[DENSITY_LATTICE_XZ * DENSITY_LATTICE_XZ];
+        auto flushSurface = [&]()
+        {
+            __m256 heights = noise.__m256_fractalNoise2D_ps(
+                    _mm256_load_ps(batch.x), _mm256_load_ps(batch.z), 10, 0.25f, surfaceAmplitude, surfaceFrequency
+                );
+            heights = _mm256_fmadd_ps(heights, _mm256_set1_ps(SURFACE_HEIGHT_RANGE), _mm256_set1_ps(CHUNK_BASE_HEIGHT));
+            alignas(32) float results[8];
+            _mm256_store_ps(results, heights);
+            for (int lane=0; lane<batch.count; lane++)
+            {
+                surface[batch.targets[lane]] = results[lane];
+            }
+            batch.count = 0;
+        };
+        for (int z=0; z<DENSITY_LATTICE_XZ; z++)
+        {
+            for (int x=0; x<DENSITY_LATTICE_XZ; x++)
+            {
+                batch.x[batch.count] = (float) (chunkBaseX + (x * DENSITY_STEP_XZ)) * SURFACE_NOISE_SCALE;
+                batch.z[batch.count] = (float) (chunkBaseZ + (z * DENSITY_STEP_XZ)) * SURFACE_NOISE_SCALE;
+                batch.targets[batch.count++] = (z * DENSITY_LATTICE_XZ) + x;
+                if (batch.count == 8) flushSurface();
+            }
+        }
+        if (batch.count > 0) flushSurface();
+
+        // Points outside of the band around the surface are decided by their depth alone, only sample noise inside it.
+        auto flushNoise = [&]()
+        {
+            __m256 offsets = noise.__m256_fractalNoise_ps(
+                    _mm256_load_ps(batch.x), _mm256_load_ps(batch.y), _mm256_load_ps(batch.z),
+                    DENSITY_NOISE_OCTAVES, 0.5f, 1.0f, 1.0f
+                );
+            // Clamp so the noise can never move a point further than the band.
+            offsets = _mm256_min_ps(_mm256_max_ps(offsets, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+            alignas(32) float results[8];
+            _mm256_store_ps(results, _mm256_mul_ps(offsets, _mm256_set1_ps(DENSITY_NOISE_AMPLITUDE)));
+            for (int lane=0; lane<batch.count; lane++)
+            {
+                density[batch.targets[lane]] += results[lane];
+            }
+            batch.count = 0;
+        };
+        for (int y=0; y<DENSITY_LATTICE_Y; y++)
+        {
+            auto worldY = (float) (y * DENSITY_STEP_Y);
+            for (int z=0; z<DENSITY_LATTICE_XZ; z++)
+            {
+                for (int x=0; x<DENSITY_LATTICE_XZ; x++)
+                {
+                    int idx = latticeIdx(x, y, z);
+                    density[idx] = surface[(z * DENSITY_LATTICE_XZ) + x] - worldY;
+                    if (std::abs(density[idx]) > DENSITY_NOISE_AMPLITUDE) continue;
+                    batch.x[batch.count] = (float) (chunkBaseX + (x * DENSITY_STEP_XZ)) * DENSITY_NOISE_SCALE;
+                    batch.y[batch.count] = worldY * DENSITY_NOISE_SCALE;
+                    batch.z[batch.count] = (float) (chunkBaseZ + (z * DENSITY_STEP_XZ)) * DENSITY_NOISE_SCALE;
+                    batch.targets[batch.count++] = idx;
+                    if (batch.count == 8) flushNoise();
+                }
+            }
+        }
+        if (batch.count > 0) flushNoise();
+    }
+    void DensityField::generate(Coordinate2D<int> chunkPos, ChunkOccupancy& occupancy)
+    {
+        // The lattice lives in the worker's arena, reset by the task generating the chunk.
+        float* density = Engine::getWorkerArena().allocate<float>(DENSITY_LATTICE_POINTS);
+        sampleLattice(chunkPos, density);
+
+        const __m256 yWeights = _mm256_mul_ps(
+                _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f),
+                _mm256_set1_ps(1.0f / DENSITY_STEP_Y)
+            );
+        const float xzWeight = 1.0f / DENSITY_STEP_XZ;
+        const uint16_t cellRowMask = (1u << DENSITY_STEP_XZ) - 1;
+        for (int cellY=0; cellY<DENSITY_LATTICE_Y - 1; cellY++)
+        {
+            for (int cellZ=0; cellZ<DENSITY_LATTICE_XZ - 1; cellZ++)
+            {
+                for (int cellX=0; cellX<DENSITY_LATTICE_XZ - 1; cellX++)
+                {
+                    // The corners of the cell, bottom face then top face, each ordered x then z.
+                    float corners[8] = {
+                        density[latticeIdx(cellX, cellY, cellZ)],
+                        density[latticeIdx(cellX + 1, cellY, cellZ)],
+                        density[latticeIdx(cellX, cellY, cellZ + 1)],
+                        density[latticeIdx(cellX + 1, cellY, cellZ + 1)],
+                        density[latticeIdx(cellX, cellY + 1, cellZ)],
+                        density[latticeIdx(cellX + 1, cellY + 1, cellZ)],
+                        density[latticeIdx(cellX, cellY + 1, cellZ + 1)],
+                        density[latticeIdx(cellX + 1, cellY + 1, cellZ + 1)]
+                    };
+                    int numSolidCorners = 0;
+                    for (float corner: corners)
+                    {
+                        numSolidCorners += corner > 0.0f ? 1 : 0;
+                    }
+                    // Interpolation cannot leave the range of the corners, so a cell of one sign is uniform.
+                    if (numSolidCorners == 0) continue;
+                    int baseX = cellX * DENSITY_STEP_XZ;
+                    int baseY = cellY * DENSITY_STEP_Y;
+                    int baseZ = cellZ * DENSITY_STEP_XZ;
+                    if (numSolidCorners == 8)
+                    {
+                        auto rowMask = (uint16_t) (cellRowMask << baseX);
+                        for (int y=baseY; y<baseY + DENSITY_STEP_Y; y++)
+                        {
+                            for (int z=baseZ; z<baseZ + DENSITY_STEP_XZ; z++)
+                            {
+                                occupancy.rows[(y * CHUNK_WIDTH) + z] |= rowMask;
+                            }
+                        }
+                        continue;
+                    }
+                    // Interpolate a whole column of the cell at once.
+                    for (int z=0; z<DENSITY_STEP_XZ; z++)
+                    {
+                        float tz = (float) z * xzWeight;
+                        for (int x=0; x<DENSITY_STEP_XZ; x++)
+                        {
+                            float tx = (float) x * xzWeight;
+                            float bottom = bilerp(corners[0], corners[1], corners[2], corners[3], tx, tz);
+                            float top = bilerp(corners[4], corners[5], corners[6], corners[7], tx, tz);
+                            __m256 column = _mm256_fmadd_ps(
+                                    _mm256_set1_ps(top - bottom), yWeights, _mm256_set1_ps(bottom)
+                                );
+                            auto solidMask = (uint32_t) _mm256_movemask_ps(
+                                    _mm256_cmp_ps(column, _mm256_setzero_ps(), _CMP_GT_OQ)
+                                );
+                            auto rowBit = (uint16_t) (1u << (baseX + x));
+                            while (solidMask != 0)
+                            {
+                                int y = baseY + (int) _tzcnt_u32(solidMask);
+                                occupancy.rows[(y * CHUNK_WIDTH) + baseZ + z] |= rowBit;
+                                solidMask &= solidMask - 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef OPENGLDEMO_DENSITYFIELD_HPP
+#define OPENGLDEMO_DENSITYFIELD_HPP
+
+#include <cstdint>
+
+#include "faceExtractor.hpp"
+#include "../misc/coordinate.hpp"
+#include "../misc/globals.hpp"
+#include "../../helpers/noise.hpp"
+
+namespace Craft
+{
+    /// The spacing of the density lattice along x and z, in blocks.
+    const int DENSITY_STEP_XZ = 4;
+    /// The spacing of the density lattice along y, in blocks. A cell's column of blocks fills one __m256.
+    const int DENSITY_STEP_Y = 8;
+    /// The number of lattice points along x and z within a chunk, including the border shared with the next chunk.
+    constexpr int DENSITY_LATTICE_XZ = (CHUNK_WIDTH / DENSITY_STEP_XZ) + 1;
+    /// The number of lattice points along y, including the top of the world.
+    constexpr int DENSITY_LATTICE_Y = (CHUNK_HEIGHT / DENSITY_STEP_Y) + 1;
+    /// The number of lattice points within a chunk.
+    constexpr int DENSITY_LATTICE_POINTS = DENSITY_LATTICE_XZ * DENSITY_LATTICE_Y * DENSITY_LATTICE_XZ;
+    /// The largest change, in blocks, the 3D noise may make to the surface. Also the depth of the band it is sampled in.
+    const float DENSITY_NOISE_AMPLITUDE = 24.0f;
+    /// The scale applied to world coordinates before sampling the 3D noise.
+    const float DENSITY_NOISE_SCALE = 1.0f / 12.0f;
+    /// The number of octaves of the 3D noise.
+    const int DENSITY_NOISE_OCTAVES = 3;
+    static_assert(CHUNK_WIDTH % DENSITY_STEP_XZ == 0 && CHUNK_HEIGHT % DENSITY_STEP_Y == 0,
+                  "The density lattice must tile the chunk.");
+    static_assert(DENSITY_STEP_Y == 8, "A lattice cell is interpolated along y one __m256 at a time.");
+
+    /**
+     * Generates terrain from a 3D density field, where a block is solid if the density at its position is positive.
+     *
+     * The density is the distance below the heightmap surface plus 3D fractal noise, which carves overhangs and caves
+     * around the surface. It is only sampled on a coarse lattice and trilinearly interpolated in between. The noise
+     * cannot move a lattice point further than DENSITY_NOISE_AMPLITUDE from the surface, so it is only sampled within
+     * that band, and lattice cells whose corners are all solid or all air are filled without interpolating.
+     */
+    class DensityField
+    {
+    public:
+        /**
+         * Create a density field.
+         *
+         * @param seed:    The seed of the noise.
+         * @param backend: The noise kernel the field is sampled with.
+         */
+        explicit DensityField(uint32_t seed, NoiseBackend backend = NoiseBackend::PERLIN);
+        ~DensityField() = default;
+        /**
+         * Fill the occupancy of a chunk from the density field.
+         *
+         * @param chunkPos:  The position of the chunk.
+         * @param occupancy: The occupancy of the chunk, expected to be empty.
+         */
+        void generate(Coordinate2D<int> chunkPos, ChunkOccupancy& occupancy);
+        /// Retrieve the noise kernel the field is sampled with.
+        [[nodiscard]] inline NoiseBackend getBackend() const { return noise.getBackend(); }
+        /// Retrieve the noise the field is sampled from.
+        [[nodiscard]] inline const Noise& getNoise() const { return noise; }
+        /// Retrieve the amplitude of the surface's fractal noise.
+        [[nodiscard]] inline float getSurfaceAmplitude() const { return surfaceAmplitude; }
+        /// Retrieve the frequency of the surface's fractal noise.
+        [[nodiscard]] inline float getSurfaceFrequency() const { return surfaceFrequency; }
+    private:
+        /// The noise the surface and the 3D noise are sampled from.
+        Noise noise;
+        /// The amplitude of the surface's fractal noise.
+        float surfaceAmplitude;
+        /// The frequency of the surface's fractal noise.
+        float surfaceFrequency;
+        /**
+         * Sample the density on every lattice point of a chunk.
+         *
+         * @param chunkPos: The position of the chunk.
+         * @param density:  Where to write the density, DENSITY_LATTICE_POINTS entries indexed by latticeIdx.
+         */
+        void sampleLattice(Coordinate2D<int> chunkPos, float* density);
+    };
+}
+
+#endif //OPENGLDEMO_DENSITYFIELD_HPP
@@ -0,0 +1,73 @@
+#include <immintrin.h>
+
+#include "faceExtractor.hpp"
+
+namespace Craft
+{
+    /**
+     * Append the blocks of a row whose face is visible to a side's instance list.
+     *
+     * @param mask:    The visible faces of the row, bit x set for the block at x.
+     * @param rowBase: The index of the row's first block within the block SSBO.
+     * @param output:  The instance list of the side.
+     * @param count:   The number of instances within the list, updated.
+     */
+    static inline void appendRow(uint32_t mask, int rowBase, int* output, int& count)
+    {
+        int idx = count;
+        count += (int) _mm_popcnt_u32(mask);
+        while (mask != 0)
+        {
+            output[idx++] = rowBase + (int) _tzcnt_u32(mask);
+            mask &= mask - 1;
+        }
+    }
+    void extractFaces(
+            const ChunkOccupancy& occupancy,
+            const ChunkNeighborOccupancy& neighbors,
+            int chunkOffset,
+            int* output,
+            ptrdiff_t sideStride,
+            int* counts
+        )
+    {
+        const uint32_t rowMask = (1u << CHUNK_WIDTH) - 1;
+        const uint16_t* rows = occupancy.rows;
+        for (int side = 0; side < SIDES_PER_BLOCK; side++)
+        {
+            counts[side] = 0;
+        }
+
+        for (int y = 0; y < CHUNK_HEIGHT; y++)
+        {
+            for (int z = 0; z < CHUNK_WIDTH; z++)
+            {
+                int rowIdx = (y * CHUNK_WIDTH) + z;
+                uint32_t row = rows[rowIdx];
+                if (row == 0) continue;
+
+                // The occupancy of the block on the other side of each face, aligned to the row's bits.
+                uint32_t above = y < CHUNK_HEIGHT - 1 ? rows[rowIdx + CHUNK_WIDTH] : 0;
+                uint32_t below = y > 0 ? rows[rowIdx - CHUNK_WIDTH] : rowMask;
+                uint32_t right = row >> 1;
+                if (neighbors.xMax != nullptr) right |= (neighbors.xMax->rows[rowIdx] & 1u) << (CHUNK_WIDTH - 1);
+                uint32_t left = (row << 1) & rowMask;
+                if (neighbors.xMin != nullptr) left |= neighbors.xMin->rows[rowIdx] >> (CHUNK_WIDTH - 1);
+                uint32_t front = z < CHUNK_WIDTH - 1
+                                 ? rows[rowIdx + 1]
+                                 : neighbors.zMax != nullptr ? neighbors.zMax->rows[y * CHUNK_WIDTH] : 0;
+                uint32_t back = z > 0
+                                ? rows[rowIdx - 1]
+                                : neighbors.zMin != nullptr ? neighbors.zMin->rows[rowIdx + CHUNK_WIDTH - 1] : 0;
+
+                int rowBase = chunkOffset + (y * CHUNK_SIZE) + (z * CHUNK_WIDTH);
+                appendRow(row & ~above, rowBase, output, counts[0]);
+                appendRow(row & ~below, rowBase, output + sideStride, counts[1]);
+                appendRow(row & ~right, rowBase, output + (2 * sideStride), counts[2]);
+                appendRow(row & ~left, rowBase, output + (3 * sideStride), counts[3]);
+                appendRow(row & ~front, rowBase, output + (4 * sideStride), counts[4]);
+                appendRow(row & ~back, rowBase, output + (5 * sideStride), counts[5]);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef OPENGLDEMO_FACEEXTRACTOR_HPP
+#define OPENGLDEMO_FACEEXTRACTOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "../misc/globals.hpp"
+
+namespace Craft
+{
+    /**
+     * The occupancy of a chunk stored as one bitmask per row of blocks along the x axis.
+     *
+     * Bit x of rows[(y * CHUNK_WIDTH) + z] is set if a block exists at the chunk relative position (x, y, z), so the
+     * faces of a whole row can be culled with a handful of shifts and masks.
+     */
+    struct ChunkOccupancy
+    {
+        uint16_t rows[CHUNK_HEIGHT * CHUNK_WIDTH]{};
+
+        inline void set(int x, int y, int z) { rows[(y * CHUNK_WIDTH) + z] |= (uint16_t) (1u << x); }
+        inline void clear(int x, int y, int z) { rows[(y * CHUNK_WIDTH) + z] &= (uint16_t) ~(1u << x); }
+        [[nodiscard]] inline bool test(int x, int y, int z) const { return (rows[(y * CHUNK_WIDTH) + z] >> x) & 1u; }
+    };
+    static_assert(CHUNK_WIDTH == 16, "ChunkOccupancy stores a row of blocks in a uint16_t.");
+
+    /// The occupancy of the chunks bordering a chunk, nullptr where a neighbor is not loaded.
+    struct ChunkNeighborOccupancy
+    {
+        const ChunkOccupancy* xMax{nullptr};
+        const ChunkOccupancy* xMin{nullptr};
+        const ChunkOccupancy* zMax{nullptr};
+        const ChunkOccupancy* zMin{nullptr};
+    };
+
+    /**
+     * Extract the visible faces of a chunk in a single pass over its rows.
+     *
+     * A face is visible if no block exists on the other side of it. Faces bordering an unloaded chunk or the top of
+     * the world are visible, faces at the bottom of the world are not. The sides are ordered as in the block vertex
+     * data: y_max, y_min, x_max, x_min, z_max, z_min.
+     *
+     * @param occupancy:   The occupancy of the chunk.
+     * @param neighbors:   The occupancy of the bordering chunks.
+     * @param chunkOffset: The index of the chunk's first block within the block SSBO, added to every instance.
+     * @param output:      Where to write the instances of side 0, side N is written at output + N * sideStride.
+     * @param sideStride:  The distance between the instance lists of two sides.
+     * @param counts:      The number of instances written per side, SIDES_PER_BLOCK entries.
+     */
+    void extractFaces(
+            const ChunkOccupancy& occupancy,
+            const ChunkNeighborOccupancy& neighbors,
+            int chunkOffset,
+            int* output,
+            ptrdiff_t sideStride,
+            int* counts
+        );
+}
+
+#endif //OPENGLDEMO_FACEEXTRACTOR_HPP
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#include "gpuTerrain.hpp"
+
+namespace Craft
+{
+    GpuTerrain::GpuTerrain(Engine::Compute* terrainCompute, const DensityField* terrain)
+        : terrainCompute{terrainCompute}
+        , terrain{terrain}
+    {}
+    GpuTerrain::~GpuTerrain()
+    {
+        if (batchFence != nullptr) glDeleteSync(batchFence);
+        glDeleteBuffers(1, &paramsSSBO);
+        glDeleteBuffers(1, &occupancySSBO);
+    }
+    bool GpuTerrain::initGpuTerrain()
+    {
+        GLint linked = GL_FALSE;
+        if (terrainCompute != nullptr && terrainCompute->getProgram() != 0)
+        {
+            glGetProgramiv(terrainCompute->getProgram(), GL_LINK_STATUS, &linked);
+        }
+        if (linked != GL_TRUE)
+        {
+            std::cerr << "Terrain compute program is unavailable, generating terrain on the CPU." << std::endl;
+            return false;
+        }
+        const GLbitfield writeFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLbitfield readFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const auto occupancyBytes = (GLsizeiptr) (GPU_TERRAIN_BATCH * sizeof(ChunkOccupancy));
+        glGenBuffers(1, &paramsSSBO);
+        glGenBuffers(1, &occupancySSBO);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, paramsSSBO);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(GpuTerrainParams), nullptr, writeFlags);
+        paramsPointer = (GpuTerrainParams*) glMapBufferRange(
+                GL_SHADER_STORAGE_BUFFER, 0, sizeof(GpuTerrainParams), writeFlags
+            );
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, occupancySSBO);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, occupancyBytes, nullptr, readFlags);
+        occupancyPointer = (const uint32_t*) glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, occupancyBytes, readFlags);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        if (paramsPointer == nullptr || occupancyPointer == nullptr)
+        {
+            std::cerr << "Failed to map the terrain buffers, generating terrain on the CPU." << std::endl;
+            return false;
+        }
+
+        const Noise& noise = terrain->getNoise();
+        std::memcpy(paramsPointer->permutation, noise.getPermutation().data(), sizeof(paramsPointer->permutation));
+        terrainCompute->useCompute();
+        terrainCompute->getUniform<float>("u_surfaceAmplitude").set(terrain->getSurfaceAmplitude());
+        terrainCompute->getUniform<float>("u_surfaceFrequency").set(terrain->getSurfaceFrequency());
+        terrainCompute->getUniform<int>("u_backend").set((int) noise.getBackend());
+        terrainCompute->getUniform<int>("u_seed").set((int) noise.getSeed());
+        return true;
+    }
+    bool GpuTerrain::dispatch(const std::vector<Coordinate2D<int>>& chunkPositions)
+    {
+        if (failed || isBusy() || chunkPositions.empty()) return false;
+        batchSize = std::min(chunkPositions.size(), (size_t) GPU_TERRAIN_BATCH);
+        std::memcpy(paramsPointer->chunkPositions, chunkPositions.data(), batchSize * sizeof(Coordinate2D<int>));
+
+        terrainCompute->useCompute();
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_TERRAIN_PARAMS_BINDING, paramsSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_TERRAIN_OCCUPANCY_BINDING, occupancySSBO);
+        glDispatchCompute((GLuint) batchSize, 1, 1);
+        // Make the writes visible through the persistent mapping once the fence signals.
+        glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+        batchFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // Submit the dispatch now so polling without GL_SYNC_FLUSH_COMMANDS_BIT sees the fence signal.
+        glFlush();
+        batchFinished = false;
+        return true;
+    }
+    bool GpuTerrain::pollBatch(bool wait)
+    {
+        if (!isBusy()) return false;
+        if (batchFinished) return true;
+        GLbitfield flags = wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0;
+        // Wait a second at a time, as glClientWaitSync does not accept GL_TIMEOUT_IGNORED.
+        GLuint64 timeout = wait ? 1000000000 : 0;
+        GLenum result = glClientWaitSync(batchFence, flags, timeout);
+        while (wait && result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(batchFence, flags, timeout);
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            std::cerr << "Failed to wait on the terrain batch, dropping its " << batchSize << " chunks." << std::endl;
+            glDeleteSync(batchFence);
+            batchFence = nullptr;
+            batchSize = 0;
+            failed = true;
+            return false;
+        }
+        if (result == GL_TIMEOUT_EXPIRED) return false;
+        glDeleteSync(batchFence);
+        batchFence = nullptr;
+        batchFinished = true;
+        return true;
+    }
+    void GpuTerrain::readOccupancy(size_t batchIdx, ChunkOccupancy& out) const
+    {
+        std::memcpy(out.rows, occupancyPointer + (batchIdx * GPU_TERRAIN_WORDS_PER_CHUNK), sizeof(ChunkOccupancy));
+    }
+    void GpuTerrain::releaseBatch()
+    {
+        batchSize = 0;
+        batchFinished = false;
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef OPENGLDEMO_GPUTERRAIN_HPP
+#define OPENGLDEMO_GPUTERRAIN_HPP
+
+#include <glad/glad.h>
+#include <vector>
+
+#include "densityField.hpp"
+#include "faceExtractor.hpp"
+#include "../misc/coordinate.hpp"
+#include "../misc/globals.hpp"
+#include "../../setup/compute.hpp"
+
+namespace Craft
+{
+    /// The most chunks whose terrain is generated by a single dispatch of terrain.comp.
+    const int GPU_TERRAIN_BATCH = 16;
+    /// The number of words of packed occupancy rows terrain.comp writes per chunk, two rows per word.
+    constexpr int GPU_TERRAIN_WORDS_PER_CHUNK = (CHUNK_HEIGHT * CHUNK_WIDTH) / 2;
+    /// The binding of the buffer holding the permutation table and the positions of the batch.
+    const GLuint GPU_TERRAIN_PARAMS_BINDING = 4;
+    /// The binding of the buffer terrain.comp writes the occupancy of the batch to.
+    const GLuint GPU_TERRAIN_OCCUPANCY_BINDING = 5;
+    static_assert(sizeof(ChunkOccupancy) == GPU_TERRAIN_WORDS_PER_CHUNK * sizeof(uint32_t),
+                  "terrain.comp writes ChunkOccupancy's rows as packed words.");
+
+    /// The layout of terrain.comp's parameter buffer.
+    struct GpuTerrainParams
+    {
+        int permutation[512];
+        Coordinate2D<int> chunkPositions[GPU_TERRAIN_BATCH];
+    };
+
+    /**
+     * Generates the occupancy of a batch of chunks with terrain.comp, sampling the same density field as the CPU.
+     *
+     * The GPU takes the place of DensityField::generate: the chunks' blocks are still built from the occupancy on the
+     * workers. One batch is in flight at a time and is polled with a fence, so dispatching never stalls the frame.
+     * The CPU density field remains the fallback if the compute program is unavailable.
+     */
+    class GpuTerrain
+    {
+    public:
+        /**
+         * @param terrainCompute: The compute program running terrain.comp.
+         * @param terrain:        The CPU density field whose parameters the GPU mirrors.
+         */
+        GpuTerrain(Engine::Compute* terrainCompute, const DensityField* terrain);
+        ~GpuTerrain();
+        /**
+         * Create the buffers and upload the density field's parameters.
+         *
+         * @return: True if terrain can be generated on the GPU, else false and the CPU density field should be used.
+         */
+        bool initGpuTerrain();
+        /**
+         * Dispatch terrain.comp for a batch of chunks.
+         *
+         * @param chunkPositions: The positions of the chunks, at most GPU_TERRAIN_BATCH.
+         * @return:               True if the batch was dispatched, false if another batch is still in flight or
+         *                        waiting on a batch failed.
+         */
+        bool dispatch(const std::vector<Coordinate2D<int>>& chunkPositions);
+        /**
+         * Check whether the batch in flight has finished. If waiting on its fence fails the batch is dropped and
+         * hasFailed is set, as the batch would never be seen to finish.
+         *
+         * @param wait: Whether to block until it finishes.
+         * @return:     True if a batch has finished and its occupancy may be read, else false.
+         */
+        bool pollBatch(bool wait = false);
+        /**
+         * Copy a chunk's occupancy out of the finished batch.
+         *
+         * @param batchIdx: The index of the chunk within the positions given to dispatch.
+         * @param out:      The occupancy to write to.
+         */
+        void readOccupancy(size_t batchIdx, ChunkOccupancy& out) const;
+        /// Release the finished batch so another may be dispatched.
+        void releaseBatch();
+        /// Retrieve whether a batch has been dispatched and not yet released.
+        [[nodiscard]] inline bool isBusy() const { return batchSize != 0; }
+        /// Retrieve whether waiting on a batch failed, after which terrain must be generated on the CPU.
+        [[nodiscard]] inline bool hasFailed() const { return failed; }
+    private:
+        /// The compute program running terrain.comp.
+        Engine::Compute* terrainCompute;
+        /// The CPU density field whose parameters the GPU mirrors.
+        const DensityField* terrain;
+        /// The buffer holding the permutation table and the positions of the batch.
+        GLuint paramsSSBO{0};
+        /// The buffer terrain.comp writes the occupancy of the batch to.
+        GLuint occupancySSBO{0};
+        /// The persistently mapped parameters.
+        GpuTerrainParams* paramsPointer{nullptr};
+        /// The persistently mapped occupancy of the batch.
+        const uint32_t* occupancyPointer{nullptr};
+        /// Signalled once the GPU has finished the batch in flight.
+        GLsync batchFence{nullptr};
+        /// The number of chunks in the batch in flight.
+        size_t batchSize{0};
+        /// Whether the batch in flight has finished.
+        bool batchFinished{false};
+        /// Whether waiting on a batch failed.
+        bool failed{false};
+    };
+}
+
+#endif //OPENGLDEMO_GPUTERRAIN_HPP
@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <cstring>
+
+#include "lightEngine.hpp"
+
+namespace Craft
+{
+    /// A block within a LightNeighborhood, the index of its chunk in the upper 16 bits and of the block in the lower.
+    typedef uint32_t LightNode;
+    /// A block whose light was removed, and the level it had.
+    typedef std::pair<LightNode, int> LightRemoval;
+    /// The flood fill queues, accounted to the chunks they light.
+    typedef std::vector<LightNode, Engine::TrackedAllocator<LightNode, Engine::CHUNK_MEMORY>> LightAddQueue;
+    typedef std::vector<LightRemoval, Engine::TrackedAllocator<LightRemoval, Engine::CHUNK_MEMORY>> LightRemoveQueue;
+    /// The offsets of a block's neighbors, in the order x max, x min, y max, y min, z max, z min.
+    static const int DIRECTION_OFFSETS[SIDES_PER_BLOCK][3] = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+    };
+    /// The direction full sky light falls in without dimming.
+    const int DOWN_DIRECTION = 3;
+    /// The channels in the order they are propagated.
+    const LightChannel LIGHT_CHANNELS[2] = {LightChannel::SKY, LightChannel::BLOCK};
+
+    static inline LightNode makeNode(int chunk, int blockIdx) { return ((uint32_t) chunk << 16) | (uint32_t) blockIdx; }
+    static inline int getNodeChunk(LightNode node) { return (int) (node >> 16); }
+    static inline int getNodeBlock(LightNode node) { return (int) (node & 0xffff); }
+    static inline int getBlockIdx(int x, int y, int z) { return (y * CHUNK_SIZE) + (z * CHUNK_WIDTH) + x; }
+
+    /**
+     * The queues of the flood fills run by a thread. They are emptied but never freed, so lighting every generated
+     * chunk and edit reuses the same storage rather than growing new queues on the heap.
+     */
+    struct LightQueues
+    {
+        /// The blocks whose light spreads to their neighbors.
+        LightAddQueue add{};
+        /// The blocks whose light was removed, and the level they had.
+        LightRemoveQueue remove{};
+    };
+    /// Retrieve the calling thread's flood fill queues. A thread runs a single LightPropagation at a time.
+    static LightQueues& getThreadLightQueues()
+    {
+        static thread_local LightQueues queues{};
+        return queues;
+    }
+
+    /// A single flood fill over a neighborhood using its thread's queues, and the chunks it changed.
+    class LightPropagation
+    {
+    public:
+        LightPropagation(const LightNeighborhood& neighborhood, const BlockRegistry* registry)
+            : neighborhood{neighborhood}
+            , registry{registry}
+            , addQueue{getThreadLightQueues().add}
+            , removeQueue{getThreadLightQueues().remove}
+        {
+            addQueue.clear();
+            removeQueue.clear();
+        }
+        [[nodiscard]] inline int get(LightChannel channel, LightNode node) const
+        {
+            return neighborhood.light[getNodeChunk(node)]->get(channel, getNodeBlock(node));
+        }
+        /// Set the light of a block, marking its chunk and any chunk whose faces border it as changed.
+        void set(LightChannel channel, LightNode node, int level)
+        {
+            int chunk = getNodeChunk(node);
+            int blockIdx = getNodeBlock(node);
+            neighborhood.light[chunk]->set(channel, blockIdx, level);
+            int x = blockIdx % CHUNK_WIDTH;
+            int z = (blockIdx / CHUNK_WIDTH) % CHUNK_WIDTH;
+            changed |= (uint16_t) (1 << chunk);
+            if (x == 0 && chunk % 3 > 0) changed |= (uint16_t) (1 << (chunk - 1));
+            if (x == CHUNK_WIDTH - 1 && chunk % 3 < 2) changed |= (uint16_t) (1 << (chunk + 1));
+            if (z == 0 && chunk / 3 > 0) changed |= (uint16_t) (1 << (chunk - 3));
+            if (z == CHUNK_WIDTH - 1 && chunk / 3 < 2) changed |= (uint16_t) (1 << (chunk + 3));
+        }
+        /**
+         * Find the neighbor of a block.
+         *
+         * @param node:      The block.
+         * @param direction: The index of the neighbor within DIRECTION_OFFSETS.
+         * @param out:       Set to the neighbor.
+         * @return:          False if the neighbor is outside of the world, the neighborhood or a loaded chunk.
+         */
+        bool step(LightNode node, int direction, LightNode& out) const
+        {
+            int chunk = getNodeChunk(node);
+            int blockIdx = getNodeBlock(node);
+            int x = (blockIdx % CHUNK_WIDTH) + DIRECTION_OFFSETS[direction][0];
+            int y = (blockIdx / CHUNK_SIZE) + DIRECTION_OFFSETS[direction][1];
+            int z = ((blockIdx / CHUNK_WIDTH) % CHUNK_WIDTH) + DIRECTION_OFFSETS[direction][2];
+            if (y < 0 || y >= CHUNK_HEIGHT) return false;
+            int chunkX = chunk % 3;
+            int chunkZ = chunk / 3;
+            if (x < 0) { x += CHUNK_WIDTH; chunkX--; }
+            else if (x >= CHUNK_WIDTH) { x -= CHUNK_WIDTH; chunkX++; }
+            if (z < 0) { z += CHUNK_WIDTH; chunkZ--; }
+            else if (z >= CHUNK_WIDTH) { z -= CHUNK_WIDTH; chunkZ++; }
+            if (chunkX < 0 || chunkX > 2 || chunkZ < 0 || chunkZ > 2) return false;
+            int nextChunk = (chunkZ * 3) + chunkX;
+            if (neighborhood.light[nextChunk] == nullptr) return false;
+            out = makeNode(nextChunk, getBlockIdx(x, y, z));
+            return true;
+        }
+        [[nodiscard]] inline BlockId getBlock(LightNode node) const
+        {
+            int blockIdx = getNodeBlock(node);
+            return neighborhood.columns[getNodeChunk(node)]->getBlock(
+                blockIdx % CHUNK_WIDTH, blockIdx / CHUNK_SIZE, (blockIdx / CHUNK_WIDTH) % CHUNK_WIDTH
+            );
+        }
+        [[nodiscard]] inline bool isOpaque(LightNode node) const { return registry->isOpaque(getBlock(node)); }
+        inline void queueAdd(LightNode node) { addQueue.push_back(node); }
+        inline void queueRemove(LightNode node, int level) { removeQueue.push_back({node, level}); }
+        /// Empty the removal queue of a channel, then its add queue.
+        void run(LightChannel channel)
+        {
+            for (size_t head=0; head<removeQueue.size(); head++)
+            {
+                auto [node, level] = removeQueue[head];
+                for (int direction=0; direction<SIDES_PER_BLOCK; direction++)
+                {
+                    LightNode next;
+                    if (!step(node, direction, next)) continue;
+                    int nextLevel = get(channel, next);
+                    if (nextLevel == 0) continue;
+                    bool fallingSky = channel == LightChannel::SKY && direction == DOWN_DIRECTION && level == MAX_LIGHT_LEVEL;
+                    if (nextLevel < level || (fallingSky && nextLevel == MAX_LIGHT_LEVEL))
+                    {
+                        // The neighbor was lit through the removed light, an emitter keeps its own light.
+                        int emission = channel == LightChannel::BLOCK ? registry->getLightEmission(getBlock(next)) : 0;
+                        set(channel, next, emission);
+                        queueRemove(next, nextLevel);
+                        if (emission > 0) queueAdd(next);
+                    }
+                    else
+                    {
+                        // The neighbor is lit from elsewhere, it fills the removed area back in.
+                        queueAdd(next);
+                    }
+                }
+            }
+            removeQueue.clear();
+            for (size_t head=0; head<addQueue.size(); head++)
+            {
+                LightNode node = addQueue[head];
+                int level = get(channel, node);
+                if (level <= 1) continue;
+                for (int direction=0; direction<SIDES_PER_BLOCK; direction++)
+                {
+                    LightNode next;
+                    if (!step(node, direction, next) || isOpaque(next)) continue;
+                    bool fallingSky = channel == LightChannel::SKY && direction == DOWN_DIRECTION && level == MAX_LIGHT_LEVEL;
+                    int nextLevel = fallingSky ? MAX_LIGHT_LEVEL : level - 1;
+                    if (get(channel, next) >= nextLevel) continue;
+                    set(channel, next, nextLevel);
+                    queueAdd(next);
+                }
+            }
+            addQueue.clear();
+        }
+        /// A bitmask of the chunks whose light or faces changed, bit N for neighborhood index N.
+        uint16_t changed{0};
+    private:
+        const LightNeighborhood& neighborhood;
+        const BlockRegistry* registry;
+        LightAddQueue& addQueue;
+        LightRemoveQueue& removeQueue;
+    };
+
+    /// Set one channel of a packed light byte.
+    static inline uint8_t packLight(uint8_t packed, LightChannel channel, int level)
+    {
+        return channel == LightChannel::SKY ? (uint8_t) ((packed & 0x0f) | (level << 4)) :
+                                              (uint8_t) ((packed & 0xf0) | level);
+    }
+
+    void ChunkLight::clear()
+    {
+        for (LightSection& section: sections)
+        {
+            section.uniform = 0;
+            section.levels.clear();
+        }
+    }
+    void ChunkLight::fillSections(int firstSection, LightChannel channel, int level)
+    {
+        for (int sectionIdx=firstSection; sectionIdx<LIGHT_SECTIONS; sectionIdx++)
+        {
+            LightSection& section = sections[sectionIdx];
+            section.uniform = packLight(section.uniform, channel, level);
+            for (uint8_t& packed: section.levels)
+            {
+                packed = packLight(packed, channel, level);
+            }
+        }
+    }
+    void ChunkLight::compact()
+    {
+        for (LightSection& section: sections)
+        {
+            if (section.levels.empty())
+            {
+                section.levels.shrink_to_fit();
+                continue;
+            }
+            uint8_t first = section.levels[0];
+            bool uniform = std::all_of(
+                section.levels.begin(), section.levels.end(), [first](uint8_t packed) { return packed == first; }
+            );
+            if (!uniform) continue;
+            section.uniform = first;
+            section.levels.clear();
+            section.levels.shrink_to_fit();
+        }
+    }
+    void ChunkLight::copyTo(uint8_t* out) const
+    {
+        for (int sectionIdx=0; sectionIdx<LIGHT_SECTIONS; sectionIdx++)
+        {
+            const LightSection& section = sections[sectionIdx];
+            uint8_t* sectionOut = out + (sectionIdx * BLOCKS_IN_LIGHT_SECTION);
+            if (section.levels.empty())
+            {
+                std::memset(sectionOut, section.uniform, BLOCKS_IN_LIGHT_SECTION);
+            }
+            else
+            {
+                std::memcpy(sectionOut, section.levels.data(), BLOCKS_IN_LIGHT_SECTION);
+            }
+        }
+    }
+    bool ChunkLight::operator==(const ChunkLight& other) const
+    {
+        for (int blockIdx=0; blockIdx<BLOCKS_IN_CHUNK; blockIdx++)
+        {
+            if (getPacked(blockIdx) != other.getPacked(blockIdx)) return false;
+        }
+        return true;
+    }
+    size_t ChunkLight::getMemoryUsage() const
+    {
+        size_t bytes = sizeof(ChunkLight);
+        for (const LightSection& section: sections)
+        {
+            bytes += section.levels.capacity();
+        }
+        return bytes;
+    }
+
+    LightEngine::LightEngine(const BlockRegistry* registry)
+        : registry{registry}
+    {}
+    void LightEngine::lightChunk(const ChunkColumns& columns, ChunkLight& light) const
+    {
+        light.clear();
+        LightNeighborhood neighborhood{};
+        neighborhood.columns[LIGHT_CENTER_CHUNK] = &columns;
+        neighborhood.light[LIGHT_CENTER_CHUNK] = &light;
+        LightPropagation propagation(neighborhood, registry);
+
+        // The sections above every column are all sky, so they are filled without storing a byte per block.
+        const int16_t* heightmap = columns.getHeightmap();
+        int highestTop = *std::max_element(heightmap, heightmap + CHUNK_SIZE);
+        int skySection = (highestTop + LIGHT_SECTION_HEIGHT) / LIGHT_SECTION_HEIGHT;
+        light.fillSections(skySection, LightChannel::SKY, MAX_LIGHT_LEVEL);
+
+        // The sky lights every column down to its highest block, and spreads sideways wherever a neighboring column
+        // is taller and may have air under its highest block.
+        for (int zIdx=0; zIdx<CHUNK_WIDTH; zIdx++)
+        {
+            for (int xIdx=0; xIdx<CHUNK_WIDTH; xIdx++)
+            {
+                int top = columns.getTopBlock(xIdx, zIdx);
+                for (int yIdx=top + 1; yIdx<skySection * LIGHT_SECTION_HEIGHT; yIdx++)
+                {
+                    light.set(LightChannel::SKY, getBlockIdx(xIdx, yIdx, zIdx), MAX_LIGHT_LEVEL);
+                }
+                int neighborTop = -1;
+                if (xIdx > 0) neighborTop = std::max(neighborTop, columns.getTopBlock(xIdx - 1, zIdx));
+                if (xIdx < CHUNK_WIDTH - 1) neighborTop = std::max(neighborTop, columns.getTopBlock(xIdx + 1, zIdx));
+                if (zIdx > 0) neighborTop = std::max(neighborTop, columns.getTopBlock(xIdx, zIdx - 1));
+                if (zIdx < CHUNK_WIDTH - 1) neighborTop = std::max(neighborTop, columns.getTopBlock(xIdx, zIdx + 1));
+                for (int yIdx=top + 1; yIdx<=neighborTop; yIdx++)
+                {
+                    propagation.queueAdd(makeNode(LIGHT_CENTER_CHUNK, getBlockIdx(xIdx, yIdx, zIdx)));
+                }
+            }
+        }
+        propagation.run(LightChannel::SKY);
+
+        for (int zIdx=0; zIdx<CHUNK_WIDTH; zIdx++)
+        {
+            for (int xIdx=0; xIdx<CHUNK_WIDTH; xIdx++)
+            {
+                int yIdx = 0;
+                for (const ColumnRun* run=columns.columnBegin(xIdx, zIdx); run!=columns.columnEnd(xIdx, zIdx); run++)
+                {
+                    int emission = registry->getLightEmission(run->id);
+                    for (; yIdx<=run->top; yIdx++)
+                    {
+                        if (emission == 0) continue;
+                        int blockIdx = getBlockIdx(xIdx, yIdx, zIdx);
+                        light.set(LightChannel::BLOCK, blockIdx, emission);
+                        propagation.queueAdd(makeNode(LIGHT_CENTER_CHUNK, blockIdx));
+                    }
+                }
+            }
+        }
+        propagation.run(LightChannel::BLOCK);
+        light.compact();
+    }
+    uint16_t LightEngine::propagateBorders(const LightNeighborhood& neighborhood) const
+    {
+        LightPropagation propagation(neighborhood, registry);
+        // The neighbors sharing a border with the center: x max, x min, z max, z min.
+        const int borderChunks[4] = {LIGHT_CENTER_CHUNK + 1, LIGHT_CENTER_CHUNK - 1, LIGHT_CENTER_CHUNK + 3, LIGHT_CENTER_CHUNK - 3};
+        for (LightChannel channel: LIGHT_CHANNELS)
+        {
+            for (int border=0; border<4; border++)
+            {
+                int neighbor = borderChunks[border];
+                if (neighborhood.light[neighbor] == nullptr) continue;
+                for (int yIdx=0; yIdx<CHUNK_HEIGHT; yIdx++)
+                {
+                    for (int idx=0; idx<CHUNK_WIDTH; idx++)
+                    {
+                        // The block on the center's side of the border and the block across it.
+                        int centerX = border == 0 ? CHUNK_WIDTH - 1 : border == 1 ? 0 : idx;
+                        int centerZ = border == 2 ? CHUNK_WIDTH - 1 : border == 3 ? 0 : idx;
+                        int otherX = border == 0 ? 0 : border == 1 ? CHUNK_WIDTH - 1 : idx;
+                        int otherZ = border == 2 ? 0 : border == 3 ? CHUNK_WIDTH - 1 : idx;
+                        LightNode centerNode = makeNode(LIGHT_CENTER_CHUNK, getBlockIdx(centerX, yIdx, centerZ));
+                        LightNode otherNode = makeNode(neighbor, getBlockIdx(otherX, yIdx, otherZ));
+                        int centerLevel = propagation.get(channel, centerNode);
+                        int otherLevel = propagation.get(channel, otherNode);
+                        if (centerLevel > otherLevel + 1 && !propagation.isOpaque(otherNode))
+                        {
+                            propagation.queueAdd(centerNode);
+                        }
+                        else if (otherLevel > centerLevel + 1 && !propagation.isOpaque(centerNode))
+                        {
+                            propagation.queueAdd(otherNode);
+                        }
+                    }
+                }
+            }
+            propagation.run(channel);
+        }
+        return propagation.changed;
+    }
+    uint16_t LightEngine::updateBlock(const LightNeighborhood& neighborhood, Coordinate<int> blockPos) const
+    {
+        LightPropagation propagation(neighborhood, registry);
+        LightNode node = makeNode(LIGHT_CENTER_CHUNK, getBlockIdx(blockPos.x, blockPos.y, blockPos.z));
+        BlockId blockId = propagation.getBlock(node);
+        bool opaque = registry->isOpaque(blockId);
+        for (LightChannel channel: LIGHT_CHANNELS)
+        {
+            int oldLevel = propagation.get(channel, node);
+            int ownLevel = channel == LightChannel::BLOCK ? registry->getLightEmission(blockId) : 0;
+            if (oldLevel != ownLevel) propagation.set(channel, node, ownLevel);
+            // Clear whatever was lit through the block, then let the surrounding light back in.
+            if (oldLevel > ownLevel) propagation.queueRemove(node, oldLevel);
+            if (ownLevel > 0) propagation.queueAdd(node);
+            for (int direction=0; !opaque && direction<SIDES_PER_BLOCK; direction++)
+            {
+                LightNode next;
+                if (propagation.step(node, direction, next) && propagation.get(channel, next) > 0)
+                {
+                    propagation.queueAdd(next);
+                }
+            }
+            propagation.run(channel);
+        }
+        return propagation.changed;
+    }
+}
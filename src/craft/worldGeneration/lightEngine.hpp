@@ -0,0 +1,168 @@
+#ifndef OPENGLDEMO_LIGHTENGINE_HPP
+#define OPENGLDEMO_LIGHTENGINE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "blockRegistry.hpp"
+#include "chunkColumns.hpp"
+#include "../misc/coordinate.hpp"
+#include "../misc/globals.hpp"
+#include "../../helpers/memoryTracker.hpp"
+
+namespace Craft
+{
+    /// The highest light level of either channel.
+    const int MAX_LIGHT_LEVEL = 15;
+    /// The channels of light: sky light falls from above the terrain, block light is emitted by blocks.
+    enum class LightChannel : uint8_t
+    {
+        SKY,
+        BLOCK
+    };
+    /// The number of chunks within a LightNeighborhood, a 3x3 square.
+    const int LIGHT_NEIGHBORHOOD_CHUNKS = 9;
+    /// The index of the center chunk within a LightNeighborhood.
+    const int LIGHT_CENTER_CHUNK = 4;
+    /// The height of the sections a chunk's light is stored in.
+    const int LIGHT_SECTION_HEIGHT = 16;
+    /// The number of light sections within a chunk.
+    constexpr int LIGHT_SECTIONS = CHUNK_HEIGHT / LIGHT_SECTION_HEIGHT;
+    /// The number of blocks within a light section.
+    constexpr int BLOCKS_IN_LIGHT_SECTION = LIGHT_SECTION_HEIGHT * CHUNK_SIZE;
+
+    /**
+     * The light of a chunk's blocks, a byte per block holding its sky light in the high nibble and its block light in
+     * the low nibble. Opaque blocks only hold the light they emit.
+     *
+     * The light is stored in sections of LIGHT_SECTION_HEIGHT layers. Most sections of generated terrain are all sky
+     * or all rock, so a section whose blocks share one light only stores that byte.
+     */
+    class ChunkLight
+    {
+    public:
+        ChunkLight() = default;
+        ~ChunkLight() = default;
+        /// Darken every block, keeping the storage of the sections for the next lighting.
+        void clear();
+        /**
+         * Set one channel of every block from a section upwards.
+         *
+         * @param firstSection: The lowest section to set.
+         * @param channel:      The channel to set.
+         * @param level:        The light level [0, 15].
+         */
+        void fillSections(int firstSection, LightChannel channel, int level);
+        /// Free the storage of every section whose blocks share one light.
+        void compact();
+        /**
+         * Retrieve the light of a block.
+         *
+         * @param channel:  The channel to retrieve.
+         * @param blockIdx: The index of the block, (y * CHUNK_SIZE) + (z * CHUNK_WIDTH) + x.
+         * @return:         The light level [0, 15].
+         */
+        [[nodiscard]] inline int get(LightChannel channel, int blockIdx) const
+        {
+            uint8_t packed = getPacked(blockIdx);
+            return channel == LightChannel::SKY ? packed >> 4 : packed & 0xf;
+        }
+        /// Set the light of a block, as indexed by get.
+        inline void set(LightChannel channel, int blockIdx, int level)
+        {
+            uint8_t packed = getPacked(blockIdx);
+            packed = channel == LightChannel::SKY ? (uint8_t) ((packed & 0x0f) | (level << 4)) :
+                                                    (uint8_t) ((packed & 0xf0) | level);
+            LightSection& section = sections[blockIdx / BLOCKS_IN_LIGHT_SECTION];
+            if (section.levels.empty())
+            {
+                if (packed == section.uniform) return;
+                section.levels.resize(BLOCKS_IN_LIGHT_SECTION, section.uniform);
+            }
+            section.levels[blockIdx % BLOCKS_IN_LIGHT_SECTION] = packed;
+        }
+        /**
+         * Copy the packed light of every block.
+         *
+         * @param out: BLOCKS_IN_CHUNK bytes as laid out in the light SSBO.
+         */
+        void copyTo(uint8_t* out) const;
+        /// Retrieve whether every block holds the same light in both chunks.
+        bool operator==(const ChunkLight& other) const;
+        /// Retrieve the heap and inline bytes used by the light.
+        [[nodiscard]] size_t getMemoryUsage() const;
+    private:
+        /// The light of LIGHT_SECTION_HEIGHT layers of the chunk.
+        struct LightSection
+        {
+            /// The packed light of every block of the section while levels is empty.
+            uint8_t uniform{0};
+            /// The packed light of each block of the section, empty if they all hold uniform.
+            std::vector<uint8_t, Engine::TrackedAllocator<uint8_t, Engine::CHUNK_MEMORY>> levels{};
+        };
+        /// The sections of the chunk from the bottom up.
+        LightSection sections[LIGHT_SECTIONS]{};
+        /// Retrieve the packed light of a block.
+        [[nodiscard]] inline uint8_t getPacked(int blockIdx) const
+        {
+            const LightSection& section = sections[blockIdx / BLOCKS_IN_LIGHT_SECTION];
+            return section.levels.empty() ? section.uniform : section.levels[blockIdx % BLOCKS_IN_LIGHT_SECTION];
+        }
+    };
+
+    /**
+     * A 3x3 square of chunks around the chunk being lit, indexed by ((dz + 1) * 3) + (dx + 1). Light never travels
+     * further than a chunk, so any change to the center chunk stays within it. Missing chunks are nullptr, light does
+     * not enter them.
+     */
+    struct LightNeighborhood
+    {
+        const ChunkColumns* columns[LIGHT_NEIGHBORHOOD_CHUNKS]{};
+        ChunkLight* light[LIGHT_NEIGHBORHOOD_CHUNKS]{};
+    };
+
+    /**
+     * Propagates sky and block light with a breadth first flood fill.
+     *
+     * Light spreads to the transparent blocks around it, losing a level per block, except for full sky light which
+     * falls straight down without dimming. Darkening runs a removal queue first: it clears the light that came from
+     * the changed block and hands the brighter blocks bordering the cleared area to the add queue, which fills the
+     * area back in. The engine holds no state, so any number of threads may light disjoint neighborhoods at once.
+     */
+    class LightEngine
+    {
+    public:
+        /// @param registry: The registry of all block types, used for their opacity and emission.
+        explicit LightEngine(const BlockRegistry* registry);
+        ~LightEngine() = default;
+        /**
+         * Light a freshly generated chunk on its own: sky light fills every column above its highest block and
+         * spreads under overhangs, block light spreads from every emitting block. Light entering from the
+         * neighboring chunks is added later by propagateBorders.
+         *
+         * @param columns: The blocks of the chunk.
+         * @param light:   The light of the chunk, overwritten.
+         */
+        void lightChunk(const ChunkColumns& columns, ChunkLight& light) const;
+        /**
+         * Spread light across the four borders of the center chunk in both directions.
+         *
+         * @param neighborhood: The center chunk and the chunks around it.
+         * @return:             A bitmask of the chunks whose light or faces changed, bit N for neighborhood index N.
+         */
+        uint16_t propagateBorders(const LightNeighborhood& neighborhood) const;
+        /**
+         * Update the light after a block of the center chunk changed, its columns already holding the new block.
+         *
+         * @param neighborhood: The center chunk and the chunks around it.
+         * @param blockPos:     The chunk relative position of the changed block.
+         * @return:             A bitmask of the chunks whose light or faces changed, bit N for neighborhood index N.
+         */
+        uint16_t updateBlock(const LightNeighborhood& neighborhood, Coordinate<int> blockPos) const;
+    private:
+        /// The registry of all block types.
+        const BlockRegistry* registry;
+    };
+}
+
+#endif //OPENGLDEMO_LIGHTENGINE_HPP
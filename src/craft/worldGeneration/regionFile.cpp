@@ -0,0 +1,154 @@
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+#include "regionFile.hpp"
+
+namespace Craft
+{
+    /**
+     * Divide, rounding towards negative infinity.
+     *
+     * @param value:   The dividend.
+     * @param divisor: The divisor, expected to be positive.
+     * @return:        The quotient.
+     */
+    static inline int floorDiv(int value, int divisor)
+    {
+        return (value >= 0 ? value : value - divisor + 1) / divisor;
+    }
+
+    Coordinate2D<int> getRegionPos(Coordinate2D<int> chunkPos)
+    {
+        return {floorDiv(chunkPos.x, REGION_WIDTH), floorDiv(chunkPos.z, REGION_WIDTH)};
+    }
+    int getRegionChunkIdx(Coordinate2D<int> chunkPos)
+    {
+        Coordinate2D<int> regionPos = getRegionPos(chunkPos);
+        int localX = chunkPos.x - (regionPos.x * REGION_WIDTH);
+        int localZ = chunkPos.z - (regionPos.z * REGION_WIDTH);
+        return (localZ * REGION_WIDTH) + localX;
+    }
+    std::filesystem::path getRegionPath(const std::filesystem::path& directory, Coordinate2D<int> regionPos)
+    {
+        return directory / ("r." + std::to_string(regionPos.x) + "." + std::to_string(regionPos.z) + ".ccr");
+    }
+    bool writeRegionFile(
+            const std::filesystem::path& path,
+            RegionFileHeader header,
+            const std::vector<std::string>& palette,
+            const std::vector<std::vector<uint8_t>>& chunks
+        )
+    {
+        if (chunks.size() != REGION_CHUNKS)
+        {
+            std::cerr << "A region must list " << REGION_CHUNKS << " chunks, got " << chunks.size() << "." << std::endl;
+            return false;
+        }
+        std::vector<RegionPaletteEntry> paletteEntries(palette.size());
+        for (size_t idx=0; idx<palette.size(); idx++)
+        {
+            std::memset(paletteEntries[idx].blockType, 0, sizeof(paletteEntries[idx].blockType));
+            std::strncpy(paletteEntries[idx].blockType, palette[idx].c_str(), sizeof(paletteEntries[idx].blockType) - 1);
+        }
+        std::vector<RegionChunkEntry> chunkEntries(REGION_CHUNKS);
+        uint64_t dataSize = 0;
+        header.numChunks = 0;
+        for (int idx=0; idx<REGION_CHUNKS; idx++)
+        {
+            chunkEntries[idx] = {(uint32_t) dataSize, (uint32_t) chunks[idx].size()};
+            dataSize += chunks[idx].size();
+            header.numChunks += chunks[idx].empty() ? 0 : 1;
+        }
+        header.magic = REGION_FILE_MAGIC;
+        header.version = REGION_FILE_VERSION;
+        header.numPalette = (uint32_t) palette.size();
+        header.dataOffset = sizeof(RegionFileHeader) +
+                            paletteEntries.size() * sizeof(RegionPaletteEntry) +
+                            chunkEntries.size() * sizeof(RegionChunkEntry);
+        header.dataSize = dataSize;
+
+        std::filesystem::path partialPath = path;
+        partialPath += ".tmp";
+        {
+            std::ofstream file(partialPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                std::cerr << "Failed to open region for writing: " << partialPath << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(paletteEntries.data()), (std::streamsize) (paletteEntries.size() * sizeof(RegionPaletteEntry)));
+            file.write(reinterpret_cast<const char*>(chunkEntries.data()), (std::streamsize) (chunkEntries.size() * sizeof(RegionChunkEntry)));
+            for (const auto& chunk: chunks)
+            {
+                file.write(reinterpret_cast<const char*>(chunk.data()), (std::streamsize) chunk.size());
+            }
+            if (!file.good())
+            {
+                std::cerr << "Failed to write region: " << partialPath << std::endl;
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(partialPath, path, error);
+        if (error)
+        {
+            std::cerr << "Failed to move region into place: " << path << " (" << error.message() << ")" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    bool readRegionHeader(
+            const std::filesystem::path& path,
+            RegionFileHeader& header,
+            std::vector<RegionChunkEntry>* chunkEntries
+        )
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file.good() || header.magic != REGION_FILE_MAGIC || header.version != REGION_FILE_VERSION)
+        {
+            return false;
+        }
+        std::error_code error;
+        auto fileSize = std::filesystem::file_size(path, error);
+        if (error || fileSize != header.dataOffset + header.dataSize) return false;
+        if (chunkEntries != nullptr)
+        {
+            chunkEntries->resize(REGION_CHUNKS);
+            file.seekg((std::streamoff) (sizeof(RegionFileHeader) + (header.numPalette * sizeof(RegionPaletteEntry))));
+            file.read(reinterpret_cast<char*>(chunkEntries->data()), REGION_CHUNKS * sizeof(RegionChunkEntry));
+        }
+        return file.good();
+    }
+    bool readRegionChunk(
+            const std::filesystem::path& directory,
+            Coordinate2D<int> chunkPos,
+            std::vector<std::string>& palette,
+            std::vector<uint8_t>& columns
+        )
+    {
+        std::filesystem::path path = getRegionPath(directory, getRegionPos(chunkPos));
+        RegionFileHeader header{};
+        std::vector<RegionChunkEntry> chunkEntries{};
+        if (!readRegionHeader(path, header, &chunkEntries)) return false;
+        const RegionChunkEntry& entry = chunkEntries[getRegionChunkIdx(chunkPos)];
+        if (entry.size == 0) return false;
+
+        std::ifstream file(path, std::ios::binary);
+        std::vector<RegionPaletteEntry> paletteEntries(header.numPalette);
+        file.seekg(sizeof(RegionFileHeader));
+        file.read(reinterpret_cast<char*>(paletteEntries.data()), (std::streamsize) (paletteEntries.size() * sizeof(RegionPaletteEntry)));
+        palette.clear();
+        for (const auto& paletteEntry: paletteEntries)
+        {
+            palette.emplace_back(paletteEntry.blockType, strnlen(paletteEntry.blockType, sizeof(paletteEntry.blockType)));
+        }
+        columns.resize(entry.size);
+        file.seekg((std::streamoff) (header.dataOffset + entry.offset));
+        file.read(reinterpret_cast<char*>(columns.data()), entry.size);
+        return file.good();
+    }
+}
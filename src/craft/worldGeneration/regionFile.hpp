@@ -0,0 +1,150 @@
+#ifndef OPENGLDEMO_REGIONFILE_HPP
+#define OPENGLDEMO_REGIONFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "../misc/coordinate.hpp"
+#include "../misc/globals.hpp"
+
+namespace Craft
+{
+    /// The number of chunks along each side of a region.
+    const int REGION_WIDTH = 32;
+    /// The number of chunks within a region.
+    constexpr int REGION_CHUNKS = REGION_WIDTH * REGION_WIDTH;
+    /// A magic number marking the start of a region file ("CCRF").
+    const uint32_t REGION_FILE_MAGIC = 0x46524343;
+    /// The version of the region layout. Bump whenever one of the structs below or the column encoding changes.
+    const uint32_t REGION_FILE_VERSION = 1;
+    /// The palette index of air, always the first entry of a region's palette.
+    const uint8_t REGION_AIR_IDX = 0;
+
+    /**
+     * The header at the start of a region file.
+     *
+     * The header is followed by numPalette RegionPaletteEntry entries, then REGION_CHUNKS RegionChunkEntry entries,
+     * and finally at dataOffset the encoded columns of every chunk within the region.
+     *
+     * A chunk is encoded by ChunkColumns::encode, one column at a time in the order of (z * CHUNK_WIDTH) + x. Each
+     * column is a uint16_t number of runs followed by the runs from y = 0 upwards, each a uint8_t palette index and a
+     * uint8_t length minus one. The air above a column's highest block is not stored.
+     */
+    struct RegionFileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        /// The seed the terrain was generated with.
+        uint32_t seed;
+        /// The NoiseBackend the terrain was generated with.
+        uint32_t noiseBackend;
+        /// The position of the region, in regions.
+        int32_t regionX;
+        int32_t regionZ;
+        /// The number of chunks stored in the region.
+        uint32_t numChunks;
+        uint32_t numPalette;
+        /// The offset from the start of the file to the encoded chunks.
+        uint64_t dataOffset;
+        /// The size of the encoded chunks in bytes.
+        uint64_t dataSize;
+    };
+    static_assert(sizeof(RegionFileHeader) == 48, "RegionFileHeader must not contain implicit padding.");
+
+    /// A block type used by the region, referenced by the runs of its columns.
+    struct RegionPaletteEntry
+    {
+        /// The lowercase name of the block type, as used in blocks.json.
+        char blockType[24];
+    };
+    static_assert(sizeof(RegionPaletteEntry) == 24, "RegionPaletteEntry must not contain implicit padding.");
+
+    /// The location of a chunk's encoded columns within the region.
+    struct RegionChunkEntry
+    {
+        /// The offset from dataOffset to the chunk's columns.
+        uint32_t offset;
+        /// The size of the chunk's columns in bytes, zero if the chunk is not stored.
+        uint32_t size;
+    };
+    static_assert(sizeof(RegionChunkEntry) == 8, "RegionChunkEntry must not contain implicit padding.");
+
+    /// The palette of regions written by chunkcraft-pregen, which encodes terrain using the palette indices as BlockIds.
+    const char* const TERRAIN_PALETTE[3] = {"air", "stone", "grass"};
+    /// The palette index of stone within TERRAIN_PALETTE.
+    const uint8_t TERRAIN_STONE_IDX = 1;
+    /// The palette index of grass within TERRAIN_PALETTE.
+    const uint8_t TERRAIN_GRASS_IDX = 2;
+
+    /**
+     * Retrieve the position of the region containing a chunk.
+     *
+     * @param chunkPos: The position of the chunk.
+     * @return:         The position of the region, in regions.
+     */
+    Coordinate2D<int> getRegionPos(Coordinate2D<int> chunkPos);
+    /**
+     * Retrieve the index of a chunk within its region's chunk table.
+     *
+     * @param chunkPos: The position of the chunk.
+     * @return:         The index of the chunk, (localZ * REGION_WIDTH) + localX.
+     */
+    int getRegionChunkIdx(Coordinate2D<int> chunkPos);
+    /**
+     * Retrieve the path of a region's file.
+     *
+     * @param directory: The directory the world's regions are stored in.
+     * @param regionPos: The position of the region, in regions.
+     * @return:          The path of the region file.
+     */
+    std::filesystem::path getRegionPath(const std::filesystem::path& directory, Coordinate2D<int> regionPos);
+    /**
+     * Write a region file. The file is written next to the path and renamed over it once complete, so an
+     * interrupted write never leaves a truncated region behind.
+     *
+     * @param path:    The file to write to.
+     * @param header:  The header, the counts and offsets are filled in.
+     * @param palette: The names of the block types the columns reference, starting with air.
+     * @param chunks:  The encoded columns of every chunk, REGION_CHUNKS entries indexed by getRegionChunkIdx. An
+     *                 empty entry marks a chunk that is not stored.
+     * @return:        True if the region was written, else false.
+     */
+    bool writeRegionFile(
+            const std::filesystem::path& path,
+            RegionFileHeader header,
+            const std::vector<std::string>& palette,
+            const std::vector<std::vector<uint8_t>>& chunks
+        );
+    /**
+     * Read and validate the header of a region file.
+     *
+     * @param path:         The region file.
+     * @param header:       Set to the header of the region.
+     * @param chunkEntries: If given, set to the region's REGION_CHUNKS chunk table entries.
+     * @return:             True if the file is a complete region of the current version, else false.
+     */
+    bool readRegionHeader(
+            const std::filesystem::path& path,
+            RegionFileHeader& header,
+            std::vector<RegionChunkEntry>* chunkEntries = nullptr
+        );
+    /**
+     * Read the encoded columns of a single chunk from its region file.
+     *
+     * @param directory: The directory the world's regions are stored in.
+     * @param chunkPos:  The position of the chunk.
+     * @param palette:   Set to the names of the block types the columns reference.
+     * @param columns:   Set to the encoded columns of the chunk, to be given to ChunkColumns::decode.
+     * @return:          True if the region stores the chunk, else false.
+     */
+    bool readRegionChunk(
+            const std::filesystem::path& directory,
+            Coordinate2D<int> chunkPos,
+            std::vector<std::string>& palette,
+            std::vector<uint8_t>& columns
+        );
+}
+
+#endif //OPENGLDEMO_REGIONFILE_HPP
@@ -1,4 +1,6 @@
 
+#include <chrono>
+
 #include "world.hpp"
 #include "../misc/globals.hpp"
 
@@ -6,23 +8,46 @@ namespace Craft
 {
     World::World(
             Engine::Window* window,
+            Engine::Input* input,
             Engine::Program* blockProgram,
             Engine::Program* worldProgram,
             Engine::Compute* neighborCompute,
             Engine::Compute* ambientOccCompute,
+            Engine::Compute* compactCompute,
+            Engine::Compute* terrainCompute,
+            Engine::FrameUniforms* frameUniforms,
+            Engine::GpuProfiler* gpuProfiler,
             uint32_t width,
-            uint32_t height
+            uint32_t height,
+            NoiseBackend noiseBackend,
+            std::filesystem::path regionDirectory
     )
-            : coords{}
-            , window{window}
+            : window{window}
+            , input{input}
+            , player{
+                &timer, &entities, window, input, blockProgram, frameUniforms, width, height, &coords, &coordsMutex
+            }
+            , chunks(0, ChunkMap::hasher(), ChunkMap::key_equal(), ChunkMap::allocator_type(&chunkNodes))
+            , terrain{44, noiseBackend}
+            , regionDirectory{std::move(regionDirectory)}
+            , gpuTerrain{terrainCompute, &terrain}
+            , timer()
             , blockProgram{blockProgram}
             , worldProgram{worldProgram}
             , neighborCompute{neighborCompute}
             , ambientOccCompute{ambientOccCompute}
-            , timer()
-            , player{&timer, window, blockProgram, worldProgram, width, height, &coords, &coordsMutex}
+            , compactCompute{compactCompute}
+            , frameUniforms{frameUniforms}
+            , gpuProfiler{gpuProfiler}
+            , coords(0, ChunkBlockMaps::hasher(), ChunkBlockMaps::key_equal(), ChunkBlockMaps::allocator_type(&coordsNodes))
+            , chunkPool{&coords, &coordsMutex}
             , sun{worldProgram}
     {
+        // Chunks briefly outnumber the render distance while the outgoing ones unload.
+        chunks.reserve(2 * TOTAL_MAX_CHUNKS);
+        coords.reserve(2 * TOTAL_MAX_CHUNKS);
+        // Game time advances by the duration of each input tick, so replayed input keeps its timing.
+        timer.useManualClock();
         updateChunkBounds();
     }
     World::~World()
@@ -42,11 +67,17 @@ namespace Craft
             glBindBuffer(GL_SHADER_STORAGE_BUFFER, idxSSBO);
             glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
         }
+        if (lightSSBOPointer)
+        {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, lightSSBO);
+            glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+        }
         if (drawCommandBufferPointer)
         {
             glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBO);
             glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
         }
+        Engine::trackExternalMemory(Engine::RENDER_MEMORY, -(int64_t) mappedBufferBytes);
 
         delete textures;
         delete userPointer;
@@ -65,6 +96,10 @@ namespace Craft
             glBindBuffer(GL_SHADER_STORAGE_BUFFER, idxSSBO);
             glDeleteVertexArrays(1, &(idxSSBO));
         }
+        if (lightSSBO != 0)
+        {
+            glDeleteBuffers(1, &lightSSBO);
+        }
 
         if (VBO != 0)
         {
@@ -97,7 +132,11 @@ namespace Craft
         for (int side=0; side<SIDES_PER_BLOCK; side++)
         {
             BlockInfo otherBlock = getBlockInfo(info.block + blockOffsets[side], info.chunk);
-            int chunkIdx = chunks[otherBlock.chunk]->chunkIdx;
+            std::shared_ptr<Chunk> chunk = findChunk(otherBlock.chunk);
+            if (chunk == nullptr) continue;
+            // Hold the chunk's lock so a worker meshing it does not race on its instance count.
+            auto lock = chunk->lockBlocks();
+            int chunkIdx = chunk->chunkIdx;
             int chunkOffset = chunkIdx * BLOCKS_IN_CHUNK;
             int blockIdx = chunkOffset + (otherBlock.block.y * CHUNK_SIZE) + (otherBlock.block.z * CHUNK_WIDTH) + otherBlock.block.x;
             int sideOffset = side * TOTAL_MAX_CHUNKS;
@@ -113,10 +152,13 @@ namespace Craft
     }
     void World::updateNeighborsCreatedBlock(BlockInfo info)
     {
+        std::shared_ptr<Chunk> chunk = findChunk(info.chunk);
+        if (chunk == nullptr) return;
+        auto lock = chunk->lockBlocks();
         // Construct neighbor info:
         for (int side=0; side<SIDES_PER_BLOCK; side++)
         {
-            int chunkIdx = chunks[info.chunk]->chunkIdx;
+            int chunkIdx = chunk->chunkIdx;
             int chunkOffset = chunkIdx * BLOCKS_IN_CHUNK;
             int blockIdx = chunkOffset + (info.block.y * CHUNK_SIZE) + (info.block.z * CHUNK_WIDTH) + info.block.x;
             int sideOffset = side * TOTAL_MAX_CHUNKS;
@@ -130,82 +172,344 @@ namespace Craft
             }
         }
     }
-    void World::appendAdditionalAffectedChunks(BlockInfo info)
+    void World::remeshEditedChunks(const std::vector<Coordinate2D<int>>& chunkPositions)
+    {
+        std::vector<std::shared_ptr<Chunk>> editedChunks{};
+        for (const auto& chunkPos: chunkPositions)
+        {
+            std::shared_ptr<Chunk> chunk = findChunk(chunkPos);
+            if (chunk == nullptr) continue;
+            if (chunk->transitionState(ChunkState::READY, ChunkState::MESHING))
+            {
+                editedChunks.push_back(chunk);
+            }
+            else if (chunk->getState() != ChunkState::NEIGHBORS_PENDING && chunk->getState() != ChunkState::UNLOADING)
+            {
+                // A chunk past its neighbor stage is sent back through the pipeline once it is uploaded, a chunk
+                // waiting for its neighbors picks up the edit at the neighbor stage.
+                chunk->neighborMask = 0;
+            }
+        }
+        if (editedChunks.empty()) return;
+        gpuProfiler->beginPass(Engine::NEIGHBOR_PASS);
+        neighborCompute->useCompute();
+        for (const auto& chunk: editedChunks)
+        {
+            neighborChunkPosUniform.set(chunk->getChunkPos());
+            glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
+        }
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        gpuProfiler->endPass();
+        compactInstanceIdxs(editedChunks);
+        for (const auto& chunk: editedChunks)
+        {
+            chunk->transitionState(ChunkState::MESHING, ChunkState::READY);
+        }
+    }
+    void World::appendAdditionalAffectedChunks(BlockInfo info, std::vector<Coordinate2D<int>>& affectedChunks)
     {
+        auto appendChunk = [&affectedChunks](Coordinate2D<int> chunkPos)
+        {
+            if (std::find(affectedChunks.begin(), affectedChunks.end(), chunkPos) != affectedChunks.end()) return;
+            affectedChunks.push_back(chunkPos);
+        };
+        appendChunk(info.chunk);
         if (info.block.x == 0)
         {
-            Coordinate2D<int> newChunk {info.chunk.x-1, info.chunk.z};
-            chunksToUpdateAmbientInfo.push_back(newChunk);
+            appendChunk({info.chunk.x-1, info.chunk.z});
         }
         else if (info.block.x == 15)
         {
-            Coordinate2D<int> newChunk {info.chunk.x+1, info.chunk.z};
-            chunksToUpdateAmbientInfo.push_back(newChunk);
+            appendChunk({info.chunk.x+1, info.chunk.z});
         }
         if (info.block.z == 0)
         {
-            Coordinate2D<int> newChunk {info.chunk.x, info.chunk.z-1};
-            chunksToUpdateAmbientInfo.push_back(newChunk);
+            appendChunk({info.chunk.x, info.chunk.z-1});
         }
         else if (info.block.z == 15)
         {
-            Coordinate2D<int> newChunk {info.chunk.x, info.chunk.z+1};
-            chunksToUpdateAmbientInfo.push_back(newChunk);
+            appendChunk({info.chunk.x, info.chunk.z+1});
+        }
+    }
+    /// Retrieve whether a chunk in the given state may be edited by the player.
+    static bool isChunkEditable(ChunkState state)
+    {
+        return state != ChunkState::GENERATING && state != ChunkState::UNLOADING;
+    }
+    void World::queueClickEdits()
+    {
+        if (player.lookAtBlock == nullptr) return;
+        bool queued = true;
+        if (input->wasPressed(Engine::InputButton::LEFT))
+        {
+            queued = editQueue.push({*player.lookAtBlock, AIR_BLOCK_ID});
+        }
+        if (input->wasPressed(Engine::InputButton::RIGHT) && !player.playerIntersectsBlock())
+        {
+            queued = editQueue.push({player.getNextLookAtBlock(), stoneId}) && queued;
+        }
+        if (!queued)
+        {
+            std::cerr << "The edit queue is full, dropping a click." << std::endl;
         }
     }
-    void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+    void World::applyQueuedEdits()
     {
-        auto userPointerData = static_cast<GLFWUserPointer*>(glfwGetWindowUserPointer(window));
-        World* world = userPointerData->world;
-        if (world == nullptr) return;
-        std::unordered_set<Coordinate2D<int>> chunksToUpdate{};
-        std::cout << "Mouse clicked." << std::endl;
-        if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
+        // A later edit of the same block replaces the earlier one, so each block is written once.
+        editBatch.clear();
+        BlockEdit edit{};
+        while ((int) editBatch.size() < MAX_EDITS_PER_FRAME && editQueue.pop(edit))
+        {
+            auto queued = std::find_if(
+                editBatch.begin(),
+                editBatch.end(),
+                [&edit](const BlockEdit& other) { return other.block == edit.block; }
+            );
+            if (queued != editBatch.end())
+            {
+                queued->id = edit.id;
+                continue;
+            }
+            editBatch.push_back(edit);
+        }
+        if (editBatch.empty()) return;
+
+        std::vector<Coordinate2D<int>> affectedChunks{};
+        for (const auto& blockEdit: editBatch)
         {
-            // Handle left mouse button press
-            if (world->player.lookAtBlock != nullptr)
+            BlockInfo info = calcBlockData(blockEdit.block);
+            std::shared_ptr<Chunk> chunk = findChunk(info.chunk);
+            if (chunk == nullptr || !isChunkEditable(chunk->getState())) continue;
+            if (!chunk->setBlock(info.block, blockEdit.id, &blockRegistry, blockSSBOPointer)) continue;
+            if (!GPU_MESHING)
             {
-                Coordinate<int> blockToDelete = *world->player.lookAtBlock;
-                BlockInfo info = calcBlockData(blockToDelete);
-                auto chunkIter = world->chunks.find(info.chunk);
-                if (chunkIter != world->chunks.end())
+                // Draw the faces the edit uncovered or added right away, the chunk is not remeshed.
+                if (blockEdit.id == AIR_BLOCK_ID)
                 {
-                    world->chunksToUpdateAmbientInfo.push_back(info.chunk);
-                    world->appendAdditionalAffectedChunks(info);
-                    world->calcAmbientOcclusionInfo();
-                    world->updateNeighbors(info);
-                    chunkIter->second->deleteBlock(info.block, world->blockSSBOPointer);
+                    updateNeighbors(info);
+                }
+                else
+                {
+                    updateNeighborsCreatedBlock(info);
                 }
             }
+            relightEditedBlock(info);
+            appendAdditionalAffectedChunks(info, affectedChunks);
+        }
+        if (affectedChunks.empty()) return;
+        if (GPU_MESHING)
+        {
+            remeshEditedChunks(affectedChunks);
+        }
+        // The ambient occlusion of the whole batch is recalculated by the pipeline later this frame.
+        std::lock_guard<std::mutex> lock(chunkAmbientMutex);
+        chunksToUpdateAmbientInfo.insert(chunksToUpdateAmbientInfo.end(), affectedChunks.begin(), affectedChunks.end());
+    }
+    LightNeighborhood World::getLightNeighborhood(
+            Coordinate2D<int> chunkPos,
+            std::shared_ptr<Chunk> (&neighborhoodChunks)[LIGHT_NEIGHBORHOOD_CHUNKS]
+        )
+    {
+        LightNeighborhood neighborhood{};
+        for (int idx=0; idx<LIGHT_NEIGHBORHOOD_CHUNKS; idx++)
+        {
+            Coordinate2D<int> neighborPos{chunkPos.x + (idx % 3) - 1, chunkPos.z + (idx / 3) - 1};
+            std::shared_ptr<Chunk> neighborChunk = findChunk(neighborPos);
+            // A generating chunk's light belongs to its worker, it takes in the light around it at its neighbor stage.
+            if (neighborChunk == nullptr || !isChunkEditable(neighborChunk->getState())) continue;
+            neighborhoodChunks[idx] = neighborChunk;
+            neighborhood.columns[idx] = &neighborChunk->columns;
+            neighborhood.light[idx] = &neighborChunk->light;
+        }
+        return neighborhood;
+    }
+    void World::publishLight(const std::shared_ptr<Chunk> (&neighborhoodChunks)[LIGHT_NEIGHBORHOOD_CHUNKS], uint16_t changed)
+    {
+        std::lock_guard<std::mutex> lock(chunkAmbientMutex);
+        for (int idx=0; idx<LIGHT_NEIGHBORHOOD_CHUNKS; idx++)
+        {
+            if (((changed >> idx) & 1) == 0 || neighborhoodChunks[idx] == nullptr) continue;
+            const std::shared_ptr<Chunk>& chunk = neighborhoodChunks[idx];
+            chunk->light.copyTo(lightSSBOPointer + (chunk->chunkIdx * BLOCKS_IN_CHUNK));
+            chunksToUpdateAmbientInfo.push_back(chunk->getChunkPos());
+        }
+    }
+    void World::relightBorders(const std::shared_ptr<Chunk>& chunk)
+    {
+        std::shared_ptr<Chunk> neighborhoodChunks[LIGHT_NEIGHBORHOOD_CHUNKS];
+        LightNeighborhood neighborhood = getLightNeighborhood(chunk->getChunkPos(), neighborhoodChunks);
+        if (neighborhood.light[LIGHT_CENTER_CHUNK] == nullptr) return;
+        publishLight(neighborhoodChunks, lightEngine.propagateBorders(neighborhood));
+    }
+    void World::relightEditedBlock(BlockInfo info)
+    {
+        std::shared_ptr<Chunk> neighborhoodChunks[LIGHT_NEIGHBORHOOD_CHUNKS];
+        LightNeighborhood neighborhood = getLightNeighborhood(info.chunk, neighborhoodChunks);
+        if (neighborhood.light[LIGHT_CENTER_CHUNK] == nullptr) return;
+        publishLight(neighborhoodChunks, lightEngine.updateBlock(neighborhood, info.block));
+    }
+    template<class Edit>
+    int World::editBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner, const Edit& edit)
+    {
+        // Each chunk is edited by its own task, the chunks' locks keep the workers meshing them out.
+        std::vector<std::shared_ptr<Chunk>> boxChunks{};
+        std::vector<std::future<ChunkEditResult>> edits{};
+        for (const ChunkBox& part: splitBox(firstCorner, secondCorner))
+        {
+            std::shared_ptr<Chunk> chunk = findChunk(part.chunkPos);
+            if (chunk == nullptr || !isChunkEditable(chunk->getState())) continue;
+            boxChunks.push_back(chunk);
+            edits.emplace_back(pool.enqueue([this, chunk, part, &edit]()
+            {
+                Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+                Engine::BumpArena& arena = Engine::getWorkerArena();
+                arena.reset();
+                BlockId* dense = arena.allocate<BlockId>(BLOCKS_IN_CHUNK);
+                Coordinate<int> chunkOrigin = part.getOrigin();
+                ChunkEditResult result = chunk->editBlocks(
+                    part.minPos, part.maxPos, &blockRegistry, blockSSBOPointer, dense,
+                    [&](Coordinate<int> blockPos, BlockId id) { return edit(blockPos + chunkOrigin, id); }
+                );
+                // The light around the chunk is spread back in by finishBulkEdit.
+                if (result.changed) lightEngine.lightChunk(chunk->columns, chunk->light);
+                return result;
+            }));
+        }
+
+        std::vector<Coordinate2D<int>> editedChunks{};
+        std::vector<uint8_t> borderMasks{};
+        for (size_t idx=0; idx<edits.size(); idx++)
+        {
+            ChunkEditResult result = edits[idx].get();
+            if (!result.changed) continue;
+            editedChunks.push_back(boxChunks[idx]->getChunkPos());
+            borderMasks.push_back(result.borderMask);
+        }
+        if (!editedChunks.empty()) finishBulkEdit(editedChunks, borderMasks);
+        return (int) editedChunks.size();
+    }
+    void World::finishBulkEdit(
+            const std::vector<Coordinate2D<int>>& editedChunks,
+            const std::vector<uint8_t>& borderMasks
+        )
+    {
+        auto isLoaded = [this](Coordinate2D<int> chunkPos)
+        {
+            std::shared_ptr<Chunk> chunk = findChunk(chunkPos);
+            return chunk != nullptr && isChunkEditable(chunk->getState());
+        };
+        // The chunks around the edited ones are lit from scratch as well before spreading light across the borders.
+        std::vector<Coordinate2D<int>> relitChunks = getRelitChunks(editedChunks, isLoaded);
+        std::vector<std::future<void>> relights{};
+        for (size_t idx=editedChunks.size(); idx<relitChunks.size(); idx++)
+        {
+            std::shared_ptr<Chunk> neighborChunk = findChunk(relitChunks[idx]);
+            if (neighborChunk == nullptr) continue;
+            relights.emplace_back(pool.enqueue([this, neighborChunk]()
+            {
+                Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+                lightEngine.lightChunk(neighborChunk->columns, neighborChunk->light);
+            }));
+        }
+        for (auto& relight: relights)
+        {
+            relight.wait();
+        }
+        for (const Coordinate2D<int>& chunkPos: relitChunks)
+        {
+            std::shared_ptr<Chunk> neighborhoodChunks[LIGHT_NEIGHBORHOOD_CHUNKS];
+            LightNeighborhood neighborhood = getLightNeighborhood(chunkPos, neighborhoodChunks);
+            if (neighborhood.light[LIGHT_CENTER_CHUNK] == nullptr) continue;
+            // The chunk was relit, so its light is published even if none crosses its borders.
+            publishLight(neighborhoodChunks, lightEngine.propagateBorders(neighborhood) | (1 << LIGHT_CENTER_CHUNK));
         }
-        else if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS)
+
+        std::vector<Coordinate2D<int>> staleChunks = getStaleChunks(editedChunks, borderMasks, isLoaded);
         {
-            // add block
-            if (world->player.lookAtBlock != nullptr && !world->player.playerIntersectsBlock())
+            // The stale chunks repack their faces at the ambient stage, once their neighbor information is rebuilt.
+            std::lock_guard<std::mutex> lock(chunkAmbientMutex);
+            for (const Coordinate2D<int>& chunkPos: staleChunks)
             {
-                Coordinate<int> blockToCreate = world->player.getNextLookAtBlock();
-                BlockInfo info = calcBlockData(blockToCreate);
-                auto chunkIter = world->chunks.find(info.chunk);
-                if (chunkIter != world->chunks.end())
+                auto queued = std::remove(chunksToUpdateAmbientInfo.begin(), chunksToUpdateAmbientInfo.end(), chunkPos);
+                chunksToUpdateAmbientInfo.erase(queued, chunksToUpdateAmbientInfo.end());
+            }
+        }
+        for (const Coordinate2D<int>& chunkPos: staleChunks)
+        {
+            std::shared_ptr<Chunk> chunk = findChunk(chunkPos);
+            if (chunk == nullptr) continue;
+            if (chunk->transitionState(ChunkState::READY, ChunkState::NEIGHBORS_PENDING))
+            {
+                pipelineChunks.push_back(chunk);
+            }
+            else if (chunk->getState() != ChunkState::NEIGHBORS_PENDING)
+            {
+                // A chunk past its neighbor stage is sent back through the pipeline once it is uploaded.
+                chunk->neighborMask = 0;
+            }
+        }
+    }
+    int World::fillBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockId id)
+    {
+        return editBox(firstCorner, secondCorner, FillEdit{id});
+    }
+    int World::fillSphere(Coordinate<int> center, int radius, BlockId id)
+    {
+        if (radius < 0) return 0;
+        return editBox(
+            center + Coordinate<int>{-radius, -radius, -radius},
+            center + Coordinate<int>{radius, radius, radius},
+            SphereEdit{center, radius * radius, id}
+        );
+    }
+    int World::replaceBlocks(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockId from, BlockId to)
+    {
+        return editBox(firstCorner, secondCorner, ReplaceEdit{from, to});
+    }
+    bool World::copyBlocks(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockBuffer& out)
+    {
+        Coordinate<int> minCorner = firstCorner;
+        Coordinate<int> maxCorner = secondCorner;
+        orderCorners(minCorner, maxCorner);
+        out.size = {maxCorner.x - minCorner.x + 1, maxCorner.y - minCorner.y + 1, maxCorner.z - minCorner.z + 1};
+        out.blocks.assign((size_t) out.size.x * out.size.y * out.size.z, AIR_BLOCK_ID);
+        Coordinate2D<int> minChunk = calcBlockData(minCorner).chunk;
+        Coordinate2D<int> maxChunk = calcBlockData(maxCorner).chunk;
+        bool complete = true;
+        for (int chunkZ=minChunk.z; chunkZ<=maxChunk.z; chunkZ++)
+        {
+            for (int chunkX=minChunk.x; chunkX<=maxChunk.x; chunkX++)
+            {
+                std::shared_ptr<Chunk> chunk = findChunk({chunkX, chunkZ});
+                if (chunk == nullptr || !isChunkEditable(chunk->getState()))
                 {
-                    chunkIter->second->createBlock(info.block, world->textures, world->blockSSBOPointer);
-                    world->chunksToUpdateAmbientInfo.push_back(info.chunk);
-                    world->appendAdditionalAffectedChunks(info);
-                    world->calcAmbientOcclusionInfo();
-                    world->updateNeighborsCreatedBlock(info);
+                    complete = false;
+                    continue;
                 }
+                auto blocksLock = chunk->lockBlocks();
+                copyColumns(chunk->columns, {chunkX, chunkZ}, minCorner, maxCorner, out);
             }
         }
-        else if (action == GLFW_RELEASE)
+        return complete;
+    }
+    int World::pasteBlocks(Coordinate<int> origin, const BlockBuffer& buffer, bool pasteAir)
+    {
+        const Coordinate<int>& size = buffer.size;
+        if (size.x <= 0 || size.y <= 0 || size.z <= 0 || buffer.blocks.size() != (size_t) size.x * size.y * size.z)
         {
-            std::cout << "Mouse button released." << std::endl;
-            // Handle mouse button release
+            std::cerr << "The block buffer does not match its size." << std::endl;
+            return 0;
         }
+        return editBox(
+            origin,
+            origin + Coordinate<int>{size.x - 1, size.y - 1, size.z - 1},
+            PasteEdit{origin, &buffer, pasteAir}
+        );
     }
     void World::initBuffers()
     {
         // Init VAO, SSBO, and VBOs
-        instanceCount = new int[SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS];
+        instanceCount = new int[SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS]{};
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &InstanceVBO);
@@ -213,6 +517,7 @@ namespace Craft
         glGenBuffers(1, &chunkSSBO);
         glGenBuffers(1, &blockSSBO);
         glGenBuffers(1, &idxSSBO);
+        glGenBuffers(1, &lightSSBO);
         // Bind VAO
         glBindVertexArray(VAO);
 
@@ -238,6 +543,7 @@ namespace Craft
                 GL_DRAW_INDIRECT_BUFFER, 0, SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS * sizeof(DrawArraysIndirectCommand),
                 GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT
         );
+        memset(drawCommandBufferPointer, 0, SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS * sizeof(DrawArraysIndirectCommand));
 
     // ChunkSSBO Binding and initialization
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, chunkSSBO);
@@ -270,10 +576,28 @@ namespace Craft
                 GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT
         );
         memset(idxSSBOPointer, 0, 6 * BLOCKS_IN_WORLD * sizeof(int));
+    // lightSSBO Binding and initialization
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, lightSSBO);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, BLOCKS_IN_WORLD, nullptr,
+                        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+        lightSSBOPointer = (uint8_t*) glMapBufferRange(
+                GL_SHADER_STORAGE_BUFFER, 0, BLOCKS_IN_WORLD,
+                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT
+        );
+        memset(lightSSBOPointer, 0, BLOCKS_IN_WORLD);
+        mappedBufferBytes = (SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS * sizeof(DrawArraysIndirectCommand))
+                            + (TOTAL_MAX_CHUNKS * sizeof(Coordinate2D<int>))
+                            + (BLOCKS_IN_WORLD * sizeof(NeighborInfo))
+                            + (6 * BLOCKS_IN_WORLD * sizeof(int))
+                            + BLOCKS_IN_WORLD;
+        Engine::trackExternalMemory(Engine::RENDER_MEMORY, (int64_t) mappedBufferBytes);
 
         int blockInfoIdx = 0;
         int chunkInfoIdx = 1;
         int idxInfoIdx = 2;
+        int drawCommandIdx = 3;
+        int lightInfoIdx = 4;
         // Define the SSBO for the neighbor compute shader.
         neighborCompute->useCompute();
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, blockInfoIdx, blockSSBO);
@@ -287,27 +611,269 @@ namespace Craft
         // Define the SSBO for the ambient occlusion compute shader.
         ambientOccCompute->useCompute();
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, blockInfoIdx, blockSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, lightInfoIdx, lightSSBO);
+
+        // Define the SSBOs for the compaction compute shader, which writes the draw commands directly.
+        compactCompute->useCompute();
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, idxInfoIdx, idxSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, drawCommandIdx, indirectBO);
+
+        // The chunk layout never changes, so only the chunk position is set per dispatch.
+        neighborCompute->getUniform<int>("u_numChunks").set(TOTAL_CHUNK_WIDTH);
+        neighborCompute->getUniform<int>("u_renderDistance").set(RENDER_DISTANCE);
+        neighborChunkPosUniform = neighborCompute->getUniform<glm::ivec2>("u_chunkPos");
+        ambientOccCompute->getUniform<int>("u_numChunks").set(TOTAL_CHUNK_WIDTH);
+        ambientOccCompute->getUniform<int>("u_renderDistance").set(RENDER_DISTANCE);
+        ambientChunkPosUniform = ambientOccCompute->getUniform<glm::ivec2>("u_chunkPos");
+        compactCompute->getUniform<int>("u_numChunks").set(TOTAL_CHUNK_WIDTH);
+        compactCompute->getUniform<int>("u_renderDistance").set(RENDER_DISTANCE);
+        compactChunkPosUniform = compactCompute->getUniform<glm::ivec2>("u_chunkPos");
+        compactResetUniform = compactCompute->getUniform<bool>("u_resetCommands");
+    }
+    std::shared_ptr<Chunk> World::findChunk(Coordinate2D<int> chunkPos)
+    {
+        std::shared_lock<std::shared_mutex> lock(chunkMutex);
+        auto chunkIter = chunks.find(chunkPos);
+        return chunkIter == chunks.end() ? nullptr : chunkIter->second;
+    }
+    int World::getHighestBlock(int worldX, int worldZ)
+    {
+        Coordinate2D<int> chunkPos{(int) floor((float) worldX / CHUNK_WIDTH), (int) floor((float) worldZ / CHUNK_WIDTH)};
+        BlockInfo info{{worldX - (chunkPos.x * CHUNK_WIDTH), 0, worldZ - (chunkPos.z * CHUNK_WIDTH)}, chunkPos};
+        std::lock_guard<std::mutex> lock(coordsMutex);
+        return highestBlock(info, &coords);
+    }
+    void World::updateEntityGround()
+    {
+        int sideChunks = (2 * RENDER_DISTANCE) + 1;
+        Coordinate2D<int> firstChunk{player.originChunk.x - RENDER_DISTANCE, player.originChunk.z - RENDER_DISTANCE};
+        entityGround.reset(firstChunk.x * CHUNK_WIDTH, firstChunk.z * CHUNK_WIDTH, sideChunks * CHUNK_WIDTH);
+        std::lock_guard<std::mutex> lock(coordsMutex);
+        for (int chunkZ=0; chunkZ<sideChunks; chunkZ++)
+        {
+            for (int chunkX=0; chunkX<sideChunks; chunkX++)
+            {
+                auto chunkIter = coords.find(Coordinate2D<int>{firstChunk.x + chunkX, firstChunk.z + chunkZ});
+                if (chunkIter == coords.end()) continue;
+                const int16_t* heightmap = chunkIter->second->getHeightmap();
+                for (int zIdx=0; zIdx<CHUNK_WIDTH; zIdx++)
+                {
+                    int32_t* row = &entityGround.heights[
+                        ((((chunkZ * CHUNK_WIDTH) + zIdx) * entityGround.width) + (chunkX * CHUNK_WIDTH))
+                    ];
+                    // The ground is the top face of the highest block, an empty column's -1 becomes 0.
+                    for (int xIdx=0; xIdx<CHUNK_WIDTH; xIdx++) row[xIdx] = heightmap[(zIdx * CHUNK_WIDTH) + xIdx] + 1;
+                }
+            }
+        }
+    }
+    void World::generateChunk(const std::shared_ptr<Chunk>& chunk, bool occupancyGenerated)
+    {
+        Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+        Engine::getWorkerArena().reset();
+        // The chunk is in the GENERATING state, so this thread owns it until it is handed to the neighbor stage.
+        int chunkIdx = chunk->chunkIdx;
+        memset(blockSSBOPointer + (chunkIdx * BLOCKS_IN_CHUNK), 0, BLOCKS_IN_CHUNK * sizeof(NeighborInfo));
+        for (int side = 0; side < SIDES_PER_BLOCK; side++)
+        {
+            drawCommandBufferPointer[(side * TOTAL_MAX_CHUNKS) + chunkIdx].instanceCount = 0;
+            instanceCount[(side * TOTAL_MAX_CHUNKS) + chunkIdx] = 0;
+        }
+        bool occupancyLoaded = !occupancyGenerated && loadRegionChunk(chunk);
+        chunk->initChunk(
+            blockSSBOPointer, &blockRegistry, grassId, stoneId, occupancyGenerated || occupancyLoaded ? nullptr : &terrain
+        );
+        // The light entering from the bordering chunks is added at the neighbor stage.
+        lightEngine.lightChunk(chunk->columns, chunk->light);
+        chunk->light.copyTo(lightSSBOPointer + (chunkIdx * BLOCKS_IN_CHUNK));
+        chunkSSBOPointer[chunkIdx] = chunk->getChunkPos();
+        chunk->setState(ChunkState::NEIGHBORS_PENDING);
+        {
+            std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+            chunksGenerated.push_back(chunk);
+        }
+        workerChunksInFlight--;
+    }
+    bool World::loadRegionChunk(const std::shared_ptr<Chunk>& chunk)
+    {
+        if (regionDirectory.empty()) return false;
+        Coordinate2D<int> chunkPos = chunk->getChunkPos();
+        // Regions of another seed or noise backend would leave seams against the chunks generated around them.
+        RegionFileHeader header{};
+        if (!readRegionHeader(getRegionPath(regionDirectory, getRegionPos(chunkPos)), header)) return false;
+        if (header.seed != terrain.getNoise().getSeed() || header.noiseBackend != (uint32_t) terrain.getBackend())
+        {
+            return false;
+        }
+        std::vector<std::string> paletteNames{};
+        std::vector<uint8_t> encoded{};
+        if (!readRegionChunk(regionDirectory, chunkPos, paletteNames, encoded)) return false;
+        std::vector<BlockId> palette{};
+        for (const std::string& name: paletteNames)
+        {
+            palette.push_back(blockRegistry.getId(name));
+        }
+        ChunkColumns columns{};
+        if (!columns.decode(encoded.data(), encoded.size(), palette)) return false;
+        // The regions hold generated terrain, so initChunk rebuilds the same columns from the occupancy.
+        ChunkOccupancy occupancy{};
+        columns.toOccupancy(occupancy);
+        chunk->setOccupancy(occupancy);
+        return true;
+    }
+    void World::meshChunk(const std::shared_ptr<Chunk>& chunk)
+    {
+        Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+        int chunkIdx = chunk->chunkIdx;
+        int chunkOffset = chunkIdx * BLOCKS_IN_CHUNK;
+        // Snapshot the bordering chunks first so no two chunk locks are ever held at once.
+        Coordinate2D<int> chunkPos = chunk->getChunkPos();
+        ChunkOccupancy neighborOccupancy[4];
+        ChunkNeighborOccupancy neighbors{};
+        const ChunkOccupancy** neighborSlots[4] = {
+            &neighbors.xMax, &neighbors.xMin, &neighbors.zMax, &neighbors.zMin
+        };
+        for (int neighbor=0; neighbor<4; neighbor++)
+        {
+            std::shared_ptr<Chunk> neighborChunk = findChunk(chunkPos + CHUNK_NEIGHBOR_OFFSETS[neighbor]);
+            if (neighborChunk == nullptr || neighborChunk->getState() == ChunkState::GENERATING) continue;
+            neighborChunk->copyOccupancy(neighborOccupancy[neighbor]);
+            *neighborSlots[neighbor] = &neighborOccupancy[neighbor];
+        }
+        {
+            auto blocksLock = chunk->lockBlocks();
+            int counts[SIDES_PER_BLOCK];
+            extractFaces(
+                chunk->getOccupancy(), neighbors, chunkOffset,
+                idxSSBOPointer + chunkOffset, BLOCKS_IN_WORLD, counts
+            );
+            // The draw commands are written by the upload stage on the main thread.
+            for (int side=0; side<SIDES_PER_BLOCK; side++)
+            {
+                instanceCount[(side * TOTAL_MAX_CHUNKS) + chunkIdx] = counts[side];
+            }
+        }
+        chunk->transitionState(ChunkState::MESHING, ChunkState::UPLOAD_PENDING);
+        workerChunksInFlight--;
+    }
+    uint8_t World::getNeighborMask(Coordinate2D<int> chunkPos)
+    {
+        uint8_t mask = 0;
+        for (int neighbor=0; neighbor<4; neighbor++)
+        {
+            std::shared_ptr<Chunk> neighborChunk = findChunk(chunkPos + CHUNK_NEIGHBOR_OFFSETS[neighbor]);
+            if (neighborChunk == nullptr) continue;
+            ChunkState state = neighborChunk->getState();
+            if (state != ChunkState::GENERATING && state != ChunkState::UNLOADING)
+            {
+                mask |= (uint8_t) (1 << neighbor);
+            }
+        }
+        return mask;
+    }
+    bool World::neighborsGenerated(Coordinate2D<int> chunkPos)
+    {
+        uint8_t mask = getNeighborMask(chunkPos);
+        for (int neighbor=0; neighbor<4; neighbor++)
+        {
+            // Chunks beyond the render distance are never generated, so they are not waited on.
+            if (((mask >> neighbor) & 1) == 0 && isChunkInBounds(chunkPos + CHUNK_NEIGHBOR_OFFSETS[neighbor]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    void World::invalidateNeighbors(Coordinate2D<int> chunkPos)
+    {
+        for (int neighbor=0; neighbor<4; neighbor++)
+        {
+            std::shared_ptr<Chunk> neighborChunk = findChunk(chunkPos + CHUNK_NEIGHBOR_OFFSETS[neighbor]);
+            if (neighborChunk == nullptr) continue;
+            // The new chunk is the neighbor's opposite side: x max <-> x min, z max <-> z min.
+            int oppositeSide = neighbor ^ 1;
+            if (((neighborChunk->neighborMask >> oppositeSide) & 1) == 1) continue;
+            // Chunks still in the pipeline are checked again when they are uploaded.
+            if (neighborChunk->transitionState(ChunkState::READY, ChunkState::NEIGHBORS_PENDING))
+            {
+                pipelineChunks.push_back(neighborChunk);
+            }
+        }
+    }
+    bool World::isChunkInBounds(Coordinate2D<int> chunkPos) const
+    {
+        return chunkPos.x >= chunkStartX && chunkPos.x < chunkEndX && chunkPos.z >= chunkStartZ && chunkPos.z < chunkEndZ;
+    }
+    bool World::isSpawnAreaReady()
+    {
+        Coordinate2D<int> center{chunkStartX + RENDER_DISTANCE, chunkStartZ + RENDER_DISTANCE};
+        for (int x=-1; x<=1; x++)
+        {
+            for (int z=-1; z<=1; z++)
+            {
+                Coordinate2D<int> chunkPos{center.x + x, center.z + z};
+                if (!isChunkInBounds(chunkPos)) continue;
+                std::shared_ptr<Chunk> chunk = findChunk(chunkPos);
+                if (chunk == nullptr || chunk->getState() != ChunkState::READY) return false;
+            }
+        }
+        return true;
     }
-    void World::initChunk(Coordinate2D<int> chunkPos)
+    void World::queueMissingChunks()
     {
+        Coordinate2D<int> center{chunkStartX + RENDER_DISTANCE, chunkStartZ + RENDER_DISTANCE};
+        std::vector<Coordinate2D<int>> missingChunks{};
+        for (int x=chunkStartX; x<chunkEndX; x++)
         {
-            std::lock_guard<std::mutex> lock(chunkMutex);
-            chunks.emplace(chunkPos, std::make_unique<Chunk>(chunkPos, &coords, &coordsMutex));
+            for (int z=chunkStartZ; z<chunkEndZ; z++)
+            {
+                Coordinate2D<int> chunkPos{x, z};
+                if (findChunk(chunkPos) == nullptr)
+                {
+                    missingChunks.push_back(chunkPos);
+                }
+            }
         }
-        chunks[chunkPos]->initChunk(blockSSBOPointer, textures);
-        chunkSSBOPointer[chunks[chunkPos]->chunkIdx] = chunkPos;
+        auto distance = [center](Coordinate2D<int> chunkPos)
+        {
+            return ((chunkPos.x - center.x) * (chunkPos.x - center.x)) + ((chunkPos.z - center.z) * (chunkPos.z - center.z));
+        };
+        std::stable_sort(
+            missingChunks.begin(),
+            missingChunks.end(),
+            [&distance](Coordinate2D<int> a, Coordinate2D<int> b) { return distance(a) < distance(b); }
+        );
+        std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+        chunksToGenerate.insert(chunksToGenerate.end(), missingChunks.begin(), missingChunks.end());
+    }
+    bool World::isPipelineIdle()
+    {
+        std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+        return pipelineChunks.empty() && chunksToGenerate.empty() && chunksGenerated.empty() && workerChunksInFlight == 0;
     }
     bool World::initWorld()
     {
         // init world
-        textures = new Craft::Textures();
-        textures->initTextures(blockProgram->getProgram());
-
-        initBuffers();
+        if (!blockRegistry.initRegistry())
+        {
+            return false;
+        }
+        stoneId = blockRegistry.getId("stone");
+        grassId = blockRegistry.getId("grass");
+        {
+            Engine::MemoryTagScope memoryScope(Engine::TEXTURE_MEMORY);
+            textures = new Craft::Textures();
+            textures->initTextures(blockProgram->getProgram(), &blockRegistry);
+        }
+        {
+            Engine::MemoryTagScope memoryScope(Engine::RENDER_MEMORY);
+            initBuffers();
+        }
         if (
                 blockSSBOPointer == nullptr ||
                 chunkSSBOPointer == nullptr ||
                 idxSSBOPointer == nullptr ||
+                lightSSBOPointer == nullptr ||
                 drawCommandBufferPointer == nullptr
             )
         {
@@ -315,39 +881,24 @@ namespace Craft
             return false;
         }
 
-        for (int x=chunkStartX; x<chunkEndX; x++)
         {
-            futures.emplace_back(
-                pool.enqueue([this, x]()
-                {
-                    for (int z=chunkStartZ; z<chunkEndZ; z++)
-                    {
-                        Coordinate2D<int> chunkPos{x, z};
-                        if (chunks.find(chunkPos) == chunks.end())
-                        {
-                            initChunk(chunkPos);
-                            {
-                                std::lock_guard<std::mutex> lock(chunkNeighborMutex);
-                                chunksToUpdateNeighborInfo.push_back(chunkPos);
-                            }
-                            {
-                                std::lock_guard<std::mutex> lock(chunkAmbientMutex);
-                                chunksToUpdateAmbientInfo.push_back(chunkPos);
-                            }
-                        }
-                    }
-                })
-            );
+            Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+            chunkPool.reserve(TOTAL_MAX_CHUNKS);
         }
-        for (auto& future: futures)
+        if (GPU_TERRAIN)
         {
-            future.get();
+            Engine::MemoryTagScope memoryScope(Engine::RENDER_MEMORY);
+            useGpuTerrain = gpuTerrain.initGpuTerrain();
+            gpuTerrainChunks.reserve(GPU_TERRAIN_BATCH);
+            gpuTerrainPositions.reserve(GPU_TERRAIN_BATCH);
+        }
+        queueMissingChunks();
+        // Only wait for the spawn area, the main loop streams in the rest.
+        while (!isSpawnAreaReady())
+        {
+            advanceChunkPipeline();
+            std::this_thread::yield();
         }
-        futures.clear();
-
-        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
-        calcNeighborInfo();
-        calcAmbientOcclusionInfo();
         if (!player.initPlayer())
         {
             return false;
@@ -358,192 +909,288 @@ namespace Craft
         userPointer = new GLFWUserPointer{};
         userPointer->camera = player.getCamera();
         userPointer->world = this;
-        // Set the mouse button callback
+        userPointer->input = input;
         glfwSetWindowUserPointer(window->getWindow(), userPointer);
-        glfwSetMouseButtonCallback(window->getWindow(), mouse_button_callback);
 
         timer.resetTimer();
         return true;
     }
-    void World::calcNeighborInfo()
+    void World::compactInstanceIdxs(const std::vector<std::shared_ptr<Chunk>>& chunksToCompact)
     {
-        neighborCompute->useCompute();
-        setInt(neighborCompute->getProgram(), "u_numChunks", TOTAL_CHUNK_WIDTH);
-        setInt(neighborCompute->getProgram(), "u_renderDistance", RENDER_DISTANCE);
-        // Dispatch the compute shader
+        if (chunksToCompact.empty()) return;
+        gpuProfiler->beginPass(Engine::COMPACT_PASS);
+        compactCompute->useCompute();
+        compactResetUniform.set(true);
+        for (const auto& chunk: chunksToCompact)
         {
-            std::lock_guard<std::mutex> lock(chunkNeighborMutex);
-            for (const auto& chunkIter: chunksToUpdateNeighborInfo)
-            {
-                setiVec2(neighborCompute->getProgram(), "u_chunkPos", chunkIter);
-                glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
-                chunksToUpdateVBOInfo.push_back(chunkIter);
-            }
-
-            chunksToUpdateNeighborInfo.clear();
+            compactChunkPosUniform.set(chunk->getChunkPos());
+            glDispatchCompute(1, 1, 1);
         }
-        // Make sure the compute shader has finished before using the data
-        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
-        glFinish();
-        updateInstanceIdxVBO();
+        // Every counter must be cleared before any workgroup appends to it.
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        compactResetUniform.set(false);
+        for (const auto& chunk: chunksToCompact)
+        {
+            compactChunkPosUniform.set(chunk->getChunkPos());
+            // One workgroup per layer of the chunk.
+            glDispatchCompute(CHUNK_HEIGHT, 1, 1);
+        }
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+        gpuProfiler->endPass();
     }
     void World::calcAmbientOcclusionInfo()
     {
+        std::lock_guard<std::mutex> lock(chunkAmbientMutex);
+        if (chunksToUpdateAmbientInfo.empty()) return;
+        gpuProfiler->beginPass(Engine::AMBIENT_PASS);
         ambientOccCompute->useCompute();
-        setInt(ambientOccCompute->getProgram(), "u_numChunks", TOTAL_CHUNK_WIDTH);
-        setInt(ambientOccCompute->getProgram(), "u_renderDistance", RENDER_DISTANCE);
+        for (auto chunkIter=chunksToUpdateAmbientInfo.begin(); chunkIter!=chunksToUpdateAmbientInfo.end(); chunkIter++)
         {
-            std::lock_guard<std::mutex> lock(chunkAmbientMutex);
-            for (const auto& chunkIter: chunksToUpdateAmbientInfo)
-            {
-                setiVec2(ambientOccCompute->getProgram(), "u_chunkPos", chunkIter);
-                glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
-            }
-            chunksToUpdateAmbientInfo.clear();
+            // Edits and relighting queue the same chunk several times.
+            if (std::find(chunksToUpdateAmbientInfo.begin(), chunkIter, *chunkIter) != chunkIter) continue;
+            // A slot that is not loaded, or is being reused by a generating chunk, has nothing to update.
+            std::shared_ptr<Chunk> chunk = findChunk(*chunkIter);
+            if (chunk == nullptr || !isChunkEditable(chunk->getState())) continue;
+            ambientChunkPosUniform.set(*chunkIter);
+            glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
         }
+        chunksToUpdateAmbientInfo.clear();
         // Make sure the compute shader has finished before using the data
         glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        gpuProfiler->endPass();
     }
-    void World::updateInstanceIdxVBO()
+    /// Retrieve the milliseconds elapsed since a point in time.
+    static double millisSince(std::chrono::steady_clock::time_point start)
     {
-        std::lock_guard<std::mutex> lock(chunkMutex);
-        if (instanceCount == nullptr) return;
-        for (int side=0; side<SIDES_PER_BLOCK; side++)
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    /// Retrieve whether a pipeline stage has used its time budget for the frame.
+    static bool isStageOverBudget(std::chrono::steady_clock::time_point stageStart, double budgetMs)
+    {
+        return millisSince(stageStart) >= budgetMs;
+    }
+    void World::advanceGpuTerrain()
+    {
+        // The workers build the chunks' blocks from the occupancy of the finished batch.
+        if (gpuTerrain.pollBatch())
         {
-            for (auto& chunk: chunksToUpdateVBOInfo)
+            Engine::MemoryTagScope memoryScope(Engine::CHUNK_MEMORY);
+            ChunkOccupancy generated{};
+            for (size_t batchIdx=0; batchIdx<gpuTerrainChunks.size(); batchIdx++)
             {
-                int sideIdx = (side * TOTAL_MAX_CHUNKS) + chunks[chunk]->chunkIdx;
-                instanceCount[sideIdx] = 0;
+                std::shared_ptr<Chunk> chunk = gpuTerrainChunks[batchIdx];
+                gpuTerrain.readOccupancy(batchIdx, generated);
+                chunk->setOccupancy(generated);
+                workerChunksInFlight++;
+                futures.emplace_back(pool.enqueue([this, chunk]() { generateChunk(chunk, true); }));
             }
+            gpuTerrainChunks.clear();
+            gpuTerrainPositions.clear();
+            gpuTerrain.releaseBatch();
         }
+        else if (gpuTerrain.hasFailed())
         {
-            std::lock_guard<std::mutex> lock(chunkVBOMutex);
-            for (auto& chunkCoord: chunksToUpdateVBOInfo)
+            // The dropped batch's chunks are generated on the CPU, as is every chunk after them.
+            std::cerr << "Falling back to generating terrain on the CPU." << std::endl;
+            useGpuTerrain = false;
+            for (const auto& chunk: gpuTerrainChunks)
             {
-//                for (int side=0; side<SIDES_PER_BLOCK; side++)
-//                {
-                    Chunk* chunk = chunks[chunkCoord].get();
-                    int chunkIdx = chunk->chunkIdx;
-                    int chunkOffset = chunk->chunkIdx * BLOCKS_IN_CHUNK;
-                    futures.emplace_back(
-                        pool.enqueue([this, chunk, chunkOffset, chunkIdx]() {
-
-                            std::lock_guard<std::mutex> lock(chunkMutex);
-                            for (int side=0; side<SIDES_PER_BLOCK; side++)
-                            {
-                                int sideOffset = side * TOTAL_MAX_CHUNKS;
-                                int blockIdx;
-                                for (auto &block: chunk->blocksMap)
-                                {
-                                    blockIdx = chunkOffset + (block.first.y * CHUNK_SIZE) +
-                                               (block.first.z * CHUNK_WIDTH) + block.first.x;
-                                    NeighborInfo info = blockSSBOPointer[blockIdx];
-                                    if ((info.sideData & 1) == 1) {
-                                        int sideShift = side + 1;
-                                        if (((info.sideData >> sideShift) & 1) == 1) {
-                                            int sideIdx = sideOffset + chunkIdx;
-                                            idxSSBOPointer[(side * BLOCKS_IN_WORLD) + chunkOffset +
-                                                           instanceCount[sideIdx]] = blockIdx;
-                                            instanceCount[sideIdx] += 1;
-                                        }
-                                    }
-                                }
-                            }
-
-                            for (int side=0; side<SIDES_PER_BLOCK; side++)
-                            {
-                                int sideOffset = side * TOTAL_MAX_CHUNKS;
-                                // Update Draw Commands:
-                                DrawArraysIndirectCommand currCommand{};
-                                currCommand.first = side * VERTICES_PER_SIDE;
-                                currCommand.count = VERTICES_PER_SIDE;
-                                currCommand.instanceCount = instanceCount[sideOffset + chunkIdx];
-                                currCommand.baseInstance = (side * BLOCKS_IN_WORLD) + chunkOffset;
-                                drawCommandBufferPointer[sideOffset + chunkIdx] = currCommand;
-                            }
-                        })
-                    );
-//                }
+                workerChunksInFlight++;
+                futures.emplace_back(pool.enqueue([this, chunk]() { generateChunk(chunk); }));
             }
-            futures.erase(
-                std::remove_if(
-                    futures.begin(),
-                    futures.end(),
-                    []( const std::future<void>& future )
-                    {
-                        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-                    }
-                ),
-                futures.end()
-            );
-            chunksToUpdateVBOInfo.clear();
+            gpuTerrainChunks.clear();
+            gpuTerrainPositions.clear();
+            return;
         }
-        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
-    }
-    void World::updateChunkBounds()
-    {
-        chunkStartX = (int) player.originChunk.x - (RENDER_DISTANCE);
-        chunkStartZ = (int) player.originChunk.z - (RENDER_DISTANCE);
-        chunkEndX = (int) player.originChunk.x + (RENDER_DISTANCE) + 1;
-        chunkEndZ = (int) player.originChunk.z + (RENDER_DISTANCE) + 1;
+        if (gpuTerrain.isBusy()) return;
+        {
+            std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+            size_t queued = 0;
+            // Queued positions wait while an outgoing chunk still holds the buffer slot they may need.
+            while (
+                    !chunksToUnloadPending &&
+                    queued < chunksToGenerate.size() &&
+                    gpuTerrainPositions.size() < GPU_TERRAIN_BATCH
+                )
+            {
+                Coordinate2D<int> chunkPos = chunksToGenerate[queued++];
+                if (!isChunkInBounds(chunkPos) || findChunk(chunkPos) != nullptr) continue;
+                auto chunk = chunkPool.acquire(chunkPos);
+                {
+                    std::unique_lock<std::shared_mutex> chunksLock(chunkMutex);
+                    chunks.emplace(chunkPos, chunk);
+                }
+                stats.chunksStreamed++;
+                gpuTerrainChunks.push_back(chunk);
+                gpuTerrainPositions.push_back(chunkPos);
+            }
+            chunksToGenerate.erase(chunksToGenerate.begin(), chunksToGenerate.begin() + (long) queued);
+        }
+        if (gpuTerrainPositions.empty()) return;
+        gpuProfiler->beginPass(Engine::TERRAIN_PASS);
+        gpuTerrain.dispatch(gpuTerrainPositions);
+        gpuProfiler->endPass();
     }
-    void World::updateChunksLoaded(Coordinate2D<int> directionDiff)
+    void World::advanceChunkPipeline()
     {
-        updateChunkBounds();
+        unloadOutOfBoundsChunks();
+        {
+            std::vector<std::shared_ptr<Chunk>> generated{};
+            {
+                std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+                generated.swap(chunksGenerated);
+            }
+            for (const auto& chunk: generated)
+            {
+                if (chunk->getState() == ChunkState::UNLOADING) continue;
+                pipelineChunks.push_back(chunk);
+                invalidateNeighbors(chunk->getChunkPos());
+            }
+        }
+        const auto maxWorkerChunks = (int) std::thread::hardware_concurrency();
 
-        futures.emplace_back(
-            pool.enqueue([this, directionDiff]()
+        // Generate: hand the queued positions to the workers, or to terrain.comp first when generating on the GPU.
+        auto stageStart = std::chrono::steady_clock::now();
+        if (useGpuTerrain)
+        {
+            advanceGpuTerrain();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(chunkGenerateMutex);
+            size_t queued = 0;
+            // Queued positions wait while an outgoing chunk still holds the buffer slot they may need.
+            while (
+                    !chunksToUnloadPending &&
+                    queued < chunksToGenerate.size() &&
+                    workerChunksInFlight < maxWorkerChunks &&
+                    !isStageOverBudget(stageStart, GENERATE_STAGE_BUDGET_MS)
+                )
             {
+                Coordinate2D<int> chunkPos = chunksToGenerate[queued++];
+                // The player may have moved on, or the chunk may have been queued twice.
+                if (!isChunkInBounds(chunkPos) || findChunk(chunkPos) != nullptr) continue;
+                auto chunk = chunkPool.acquire(chunkPos);
                 {
-                    std::lock_guard<std::mutex> lock(chunkMutex);
-                    for (auto chunkIter = chunks.begin(); chunkIter != chunks.end(); )
-                    {
-                        if (
-                                chunkIter->first.x < chunkStartX || chunkIter->first.x >= chunkEndX ||
-                                chunkIter->first.z < chunkStartZ || chunkIter->first.z >= chunkEndZ
-                            )
-                        {
-                            coords.erase(chunkIter->first);
-                            chunkIter = chunks.erase(chunkIter);
-                        }
-                        else
-                        {
-                            chunkIter++;
-                        }
-                    }
+                    std::unique_lock<std::shared_mutex> chunksLock(chunkMutex);
+                    chunks.emplace(chunkPos, chunk);
                 }
-                for (int x=chunkStartX; x<chunkEndX; x++)
+                workerChunksInFlight++;
+                stats.chunksStreamed++;
+                futures.emplace_back(pool.enqueue([this, chunk]() { generateChunk(chunk); }));
+            }
+            chunksToGenerate.erase(chunksToGenerate.begin(), chunksToGenerate.begin() + (long) queued);
+        }
+        stats.phaseMillis[GENERATE_PHASE] += millisSince(stageStart);
+
+        // Neighbor: once every bordering chunk is generated.
+        stageStart = std::chrono::steady_clock::now();
+        std::vector<std::shared_ptr<Chunk>> neighborChunks{};
+        for (const auto& chunk: pipelineChunks)
+        {
+            if (isStageOverBudget(stageStart, NEIGHBOR_STAGE_BUDGET_MS)) break;
+            if (chunk->getState() != ChunkState::NEIGHBORS_PENDING || !neighborsGenerated(chunk->getChunkPos())) continue;
+            if (!chunk->transitionState(ChunkState::NEIGHBORS_PENDING, ChunkState::AMBIENT_PENDING)) continue;
+            chunk->neighborMask = getNeighborMask(chunk->getChunkPos());
+            relightBorders(chunk);
+            neighborChunks.push_back(chunk);
+        }
+        // The borders are relit on the CPU before the pass starts, so its timestamps only cover the dispatches.
+        gpuProfiler->beginPass(Engine::NEIGHBOR_PASS);
+        neighborCompute->useCompute();
+        for (const auto& chunk: neighborChunks)
+        {
+            neighborChunkPosUniform.set(chunk->getChunkPos());
+            glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
+        }
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        gpuProfiler->endPass();
+        stats.phaseMillis[NEIGHBOR_PHASE] += millisSince(stageStart);
+
+        // Ambient occlusion.
+        stageStart = std::chrono::steady_clock::now();
+        gpuProfiler->beginPass(Engine::AMBIENT_PASS);
+        ambientOccCompute->useCompute();
+        for (const auto& chunk: pipelineChunks)
+        {
+            if (isStageOverBudget(stageStart, AMBIENT_STAGE_BUDGET_MS)) break;
+            if (!chunk->transitionState(ChunkState::AMBIENT_PENDING, ChunkState::MESH_PENDING)) continue;
+            ambientChunkPosUniform.set(chunk->getChunkPos());
+            glDispatchCompute(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_WIDTH);
+        }
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        gpuProfiler->endPass();
+        // Chunks relit by an edit or a neighbor's border repack their faces.
+        calcAmbientOcclusionInfo();
+        stats.phaseMillis[AMBIENT_PHASE] += millisSince(stageStart);
+
+        // Mesh: on the workers, or with compact.comp when meshing on the GPU.
+        stageStart = std::chrono::steady_clock::now();
+        std::vector<std::shared_ptr<Chunk>> chunksToCompact{};
+        for (const auto& chunk: pipelineChunks)
+        {
+            if (isStageOverBudget(stageStart, MESH_STAGE_BUDGET_MS)) break;
+            if (!GPU_MESHING && workerChunksInFlight >= maxWorkerChunks) break;
+            if (!chunk->transitionState(ChunkState::MESH_PENDING, ChunkState::MESHING)) continue;
+            if (GPU_MESHING)
+            {
+                chunksToCompact.push_back(chunk);
+                continue;
+            }
+            workerChunksInFlight++;
+            futures.emplace_back(pool.enqueue([this, chunk]() { meshChunk(chunk); }));
+        }
+        compactInstanceIdxs(chunksToCompact);
+        for (const auto& chunk: chunksToCompact)
+        {
+            chunk->transitionState(ChunkState::MESHING, ChunkState::UPLOAD_PENDING);
+        }
+        stats.phaseMillis[MESH_PHASE] += millisSince(stageStart);
+
+        // Upload: publish the draw commands of the meshed chunks.
+        stageStart = std::chrono::steady_clock::now();
+        for (const auto& chunk: pipelineChunks)
+        {
+            if (isStageOverBudget(stageStart, UPLOAD_STAGE_BUDGET_MS)) break;
+            if (chunk->getState() != ChunkState::UPLOAD_PENDING) continue;
+            if (!GPU_MESHING)
+            {
+                // compact.comp writes the draw commands itself.
+                auto blocksLock = chunk->lockBlocks();
+                int chunkIdx = chunk->chunkIdx;
+                for (int side=0; side<SIDES_PER_BLOCK; side++)
                 {
-                    for (int z=chunkStartZ; z<chunkEndZ; z++)
-                    {
-                        // Create new Chunks
-                        Coordinate2D<int> chunkPos{x, z};
-                        if (chunks.find(chunkPos) == chunks.end())
-                        {
-                            int chunkIdx = ((findChunkIdx(x) * TOTAL_CHUNK_WIDTH) + findChunkIdx(z));
-                            int chunkOffset = chunkIdx * BLOCKS_IN_CHUNK;
-                            memset(blockSSBOPointer + chunkOffset, 0, BLOCKS_IN_CHUNK * sizeof(NeighborInfo));
-                            for (int side = 0; side < SIDES_PER_BLOCK; side++) {
-                                int idx = (side * TOTAL_MAX_CHUNKS) + chunkIdx;
-                                drawCommandBufferPointer[idx].instanceCount = 0;
-                            }
-                            initChunk(chunkPos);
-                            {
-                                std::lock_guard<std::mutex> lock(chunkNeighborMutex);
-                                chunksToUpdateNeighborInfo.push_back(chunkPos);
-                                chunksToUpdateNeighborInfo.push_back(chunkPos - directionDiff);
-                            }
-                            {
-                                std::lock_guard<std::mutex> lock(chunkAmbientMutex);
-                                chunksToUpdateAmbientInfo.push_back(chunkPos);
-                                chunksToUpdateAmbientInfo.push_back(chunkPos - directionDiff);
-                            }
-                        }
-                    }
+                    int sideOffset = side * TOTAL_MAX_CHUNKS;
+                    DrawArraysIndirectCommand currCommand{};
+                    currCommand.first = side * VERTICES_PER_SIDE;
+                    currCommand.count = VERTICES_PER_SIDE;
+                    currCommand.instanceCount = instanceCount[sideOffset + chunkIdx];
+                    currCommand.baseInstance = (side * BLOCKS_IN_WORLD) + (chunkIdx * BLOCKS_IN_CHUNK);
+                    drawCommandBufferPointer[sideOffset + chunkIdx] = currCommand;
                 }
-            })
-        );
+            }
+            // A neighbor generated after the neighbor stage sends the chunk through the pipeline again.
+            bool isStale = (getNeighborMask(chunk->getChunkPos()) & ~chunk->neighborMask) != 0;
+            chunk->transitionState(
+                ChunkState::UPLOAD_PENDING,
+                isStale ? ChunkState::NEIGHBORS_PENDING : ChunkState::READY
+            );
+        }
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        stats.phaseMillis[UPLOAD_PHASE] += millisSince(stageStart);
 
+        pipelineChunks.erase(
+            std::remove_if(
+                pipelineChunks.begin(),
+                pipelineChunks.end(),
+                [](const std::shared_ptr<Chunk>& chunk)
+                {
+                    ChunkState state = chunk->getState();
+                    return state == ChunkState::READY || state == ChunkState::UNLOADING;
+                }
+            ),
+            pipelineChunks.end()
+        );
         futures.erase(
             std::remove_if(
                 futures.begin(),
@@ -556,39 +1203,144 @@ namespace Craft
             futures.end()
         );
     }
+    void World::updateChunkBounds()
+    {
+        chunkStartX = (int) player.originChunk.x - (RENDER_DISTANCE);
+        chunkStartZ = (int) player.originChunk.z - (RENDER_DISTANCE);
+        chunkEndX = (int) player.originChunk.x + (RENDER_DISTANCE) + 1;
+        chunkEndZ = (int) player.originChunk.z + (RENDER_DISTANCE) + 1;
+    }
+    void World::updateChunksLoaded()
+    {
+        updateChunkBounds();
+        chunksToUnloadPending = true;
+        queueMissingAfterUnload = true;
+    }
+    void World::unloadOutOfBoundsChunks()
+    {
+        if (!chunksToUnloadPending) return;
+        bool chunksInFlight = false;
+        {
+            std::unique_lock<std::shared_mutex> lock(chunkMutex);
+            std::lock_guard<std::mutex> coordsLock(coordsMutex);
+            for (auto chunkIter = chunks.begin(); chunkIter != chunks.end();)
+            {
+                if (isChunkInBounds(chunkIter->first))
+                {
+                    chunkIter++;
+                    continue;
+                }
+                // A chunk a worker is generating or meshing keeps its buffer slot until the worker hands it back, it
+                // is unloaded on a later frame.
+                if (!chunkIter->second->tryBeginUnload())
+                {
+                    chunksInFlight = true;
+                    chunkIter++;
+                    continue;
+                }
+                chunkPool.release(chunkIter->second);
+                coords.erase(chunkIter->first);
+                chunkIter = chunks.erase(chunkIter);
+            }
+        }
+        chunksToUnloadPending = chunksInFlight;
+        if (queueMissingAfterUnload && !chunksInFlight)
+        {
+            // Queue the new chunks once every outgoing chunk is erased, an incoming chunk reuses the buffer slot of
+            // the outgoing chunk TOTAL_CHUNK_WIDTH chunks away.
+            queueMissingAfterUnload = false;
+            queueMissingChunks();
+        }
+    }
     bool World::updateWorld()
     {
+        Engine::MemoryTagScope memoryScope(Engine::WORLD_MEMORY);
+        timer.advanceClock(input->getTickMillis());
+        auto playerStart = std::chrono::steady_clock::now();
+        // Only build the ground when something walks on it, the player collides with the exact blocks.
+        if (entities.countWithFlags(COLLIDE_WITH_GROUND) > 0) updateEntityGround();
+        entities.update(input->getTickMillis(), entityGround);
         Coordinate2D<int> directionDiff = player.updatePlayer();
+        stats.phaseMillis[PLAYER_PHASE] += millisSince(playerStart);
         if (directionDiff == failureCoord) return false;
         if (directionDiff.x != 0 || directionDiff.z != 0)
         {
-            updateChunksLoaded(directionDiff);
+            updateChunksLoaded();
         }
+        queueClickEdits();
+        applyQueuedEdits();
         // update sun position.
         sun.updateSun();
-        // Update Neighbor Info
-        if (chunksToUpdateNeighborInfo.size() >= (2 * TOTAL_CHUNK_WIDTH))
-        {
-            calcNeighborInfo();
-        }
-        if (chunksToUpdateAmbientInfo.size() >= (2 * TOTAL_CHUNK_WIDTH))
+        float x = ((float) sun.getTime().hours * M_PI / 12) + M_PI;
+        float cosX = cos(x);
+        float newLightLevel = (7 * cosX + 5) + 4 * abs(cosX);
+        frameUniforms->setLightLevel(newLightLevel);
+        frameUniforms->setTime(sun.getTime().getFullTime());
+        advanceChunkPipeline();
+        if (!fullRingReported && isPipelineIdle())
         {
-            calcAmbientOcclusionInfo();
+            fullRingReported = true;
+            std::cout << "Time to full render distance: "
+                      << millisSince(startupStart)
+                      << " ms" << std::endl;
         }
         return true;
     }
 
+    WorldLiveStats World::sampleLiveStats()
+    {
+        WorldLiveStats liveStats{};
+        {
+            std::shared_lock<std::shared_mutex> chunksLock(chunkMutex);
+            liveStats.loadedChunks = chunks.size();
+            for (const auto& chunk: chunks)
+            {
+                liveStats.chunksPerState[(int) chunk.second->getState()]++;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> generateLock(chunkGenerateMutex);
+            liveStats.chunksToGenerate = chunksToGenerate.size();
+        }
+        liveStats.instancesDrawn = frameInstancesDrawn;
+        liveStats.poolQueueDepth = pool.getQueueDepth();
+        liveStats.mappedBufferBytes = mappedBufferBytes;
+        return liveStats;
+    }
+    bool World::isSteadyState()
+    {
+        return input->isIdle() && chunksToUpdateAmbientInfo.empty() && isPipelineIdle();
+    }
     bool World::drawWorld() {
+        Engine::MemoryTagScope memoryScope(Engine::RENDER_MEMORY);
+        auto drawStart = std::chrono::steady_clock::now();
         blockProgram->useProgram();
         timer.incFrames();
 
-        float x = ((float) sun.getTime().hours * M_PI / 12) + M_PI;
-        float cosX = cos(x);
-        float newLightLevel = (7 * cosX + 5) + 4 * abs(cosX);
-        setFloat(blockProgram->getProgram(), "u_defaultLightLevel", newLightLevel);
         glBindVertexArray(VAO);
+        gpuProfiler->beginPass(Engine::WORLD_DRAW_PASS);
         glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS, 0);
+        gpuProfiler->endPass();
+        if (!GPU_MESHING)
+        {
+            frameInstancesDrawn = 0;
+            for (int command=0; command<SIDES_PER_BLOCK * TOTAL_MAX_CHUNKS; command++)
+            {
+                frameInstancesDrawn += instanceCount[command];
+            }
+            stats.instancesDrawn += frameInstancesDrawn;
+        }
+        if (!firstFrameReported)
+        {
+            firstFrameReported = true;
+            std::cout << "Time to first frame: "
+                      << millisSince(startupStart)
+                      << " ms" << std::endl;
+        }
+        gpuProfiler->beginPass(Engine::SUN_PASS);
         sun.drawLight((float) player.getWorldX(), (float) player.entityY, (float) player.getWorldZ());
+        gpuProfiler->endPass();
+        stats.phaseMillis[DRAW_PHASE] += millisSince(drawStart);
 //        std::cout << "FPS: " << timer.getFPS() << std::endl;
         return true;
     }
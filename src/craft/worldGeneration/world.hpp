@@ -2,44 +2,118 @@
 #define OPENGLDEMO_WORLD_HPP
 
 #include <unordered_set>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
 
 #include "../../helpers/timer.hpp"
 #include "../../helpers/helpers.hpp"
 #include "../entities/player.hpp"
 #include "chunk.hpp"
+#include "chunkPool.hpp"
+#include "gpuTerrain.hpp"
+#include "regionFile.hpp"
 #include "../../setup/program.hpp"
 #include "../../setup/compute.hpp"
+#include "../../setup/input.hpp"
+#include "../../setup/frameUniforms.hpp"
+#include "../../setup/gpuProfiler.hpp"
 #include "../weather/sun.hpp"
 
 namespace Craft
 {
+    /// The phases of a world update, timed on the main thread.
+    enum WorldPhase
+    {
+        PLAYER_PHASE,
+        GENERATE_PHASE,
+        NEIGHBOR_PHASE,
+        AMBIENT_PHASE,
+        MESH_PHASE,
+        UPLOAD_PHASE,
+        DRAW_PHASE,
+        NUM_WORLD_PHASES
+    };
+    /// The names of the world phases, indexed by WorldPhase.
+    constexpr const char* WORLD_PHASE_NAMES[NUM_WORLD_PHASES] = {
+        "player", "generate", "neighbor", "ambient occlusion", "mesh", "upload", "draw"
+    };
+    /// Statistics gathered by the world since it was created.
+    struct WorldStats
+    {
+        /// The main thread time spent in every phase, in milliseconds.
+        double phaseMillis[NUM_WORLD_PHASES]{};
+        /// The number of chunks handed to the generate stage.
+        uint64_t chunksStreamed{0};
+        /// The number of block sides drawn over every frame. Only counted when meshing on the CPU.
+        uint64_t instancesDrawn{0};
+    };
+    /// A snapshot of the world's streaming and memory counters, shown by the performance overlay.
+    struct WorldLiveStats
+    {
+        /// The number of chunks in the world, in any state.
+        size_t loadedChunks{0};
+        /// The number of chunks waiting for the generate stage.
+        size_t chunksToGenerate{0};
+        /// The number of loaded chunks in each ChunkState.
+        size_t chunksPerState[NUM_CHUNK_STATES]{};
+        /// The number of block sides drawn by the last frame. Only counted when meshing on the CPU.
+        uint64_t instancesDrawn{0};
+        /// The number of tasks waiting for a worker of the thread pool.
+        size_t poolQueueDepth{0};
+        /// The size in bytes of the persistently mapped buffers.
+        size_t mappedBufferBytes{0};
+    };
+    /// The loaded chunks keyed by their position, with nodes taken from the world's NodePool.
+    typedef std::unordered_map<
+        Coordinate2D<int>,
+        std::shared_ptr<Chunk>,
+        std::hash<Coordinate2D<int>>,
+        std::equal_to<Coordinate2D<int>>,
+        Engine::PoolAllocator<std::pair<const Coordinate2D<int>, std::shared_ptr<Chunk>>>
+    > ChunkMap;
     class World
     {
     public:
         World(
             Engine::Window* window,
+            Engine::Input* input,
             Engine::Program* blockProgram,
             Engine::Program* worldProgram,
             Engine::Compute* neighborCompute,
             Engine::Compute* ambientOccCompute,
+            Engine::Compute* compactCompute,
+            Engine::Compute* terrainCompute,
+            Engine::FrameUniforms* frameUniforms,
+            Engine::GpuProfiler* gpuProfiler,
             uint32_t width,
-            uint32_t height
+            uint32_t height,
+            NoiseBackend noiseBackend = NoiseBackend::PERLIN,
+            std::filesystem::path regionDirectory = {}
         );
         ~World();
         /// The Window class that controls the GLFW lifecycle.
         Engine::Window* window;
+        /// The input of the current tick.
+        Engine::Input* input;
+        /**
+         * The components of every entity, the player's included. Stepped once per tick before the player, so it is
+         * declared first.
+         */
+        EntityStore entities{};
         /// The camera object of the application.
         Player player;
-        /// The mapping of 2D coordinates to Chunk*
-        std::unordered_map<Coordinate2D<int>, std::unique_ptr<Chunk>> chunks{};
-        /// Vectors for descibing when we need to update certain aspects of a chunk.
-        std::vector<Coordinate2D<int>> chunksToUpdateNeighborInfo{};
+        /// The storage of the chunks map's nodes.
+        Engine::NodePool chunkNodes{Engine::WORLD_MEMORY};
+        /// The mapping of 2D coordinates to Chunk*. Guarded by chunkMutex, tasks hold their own reference to a chunk.
+        ChunkMap chunks;
+        /// The chunks whose ambient occlusion must be recalculated after a block edit.
         std::vector<Coordinate2D<int>> chunksToUpdateAmbientInfo{};
-        std::vector<Coordinate2D<int>> chunksToUpdateVBOInfo{};
         /**
          * A function for initializing the world.
          *
-         * Setups the textures, initial chunks, etx.
+         * Setups the textures, initial chunks, etx. Only the spawn chunk and its neighbors are loaded before
+         * returning, the rest of the render distance streams in through the pipeline while the game runs.
          *
          * @return
          */
@@ -58,8 +132,23 @@ namespace Craft
         bool drawWorld();
         /// The GLFW user pointer.
         GLFWUserPointer* userPointer;
-        /// The mutex for the multi-threading.
-        std::mutex chunkMutex{};
+        /// Guards the chunks map: shared for lookups, exclusive for inserting and erasing chunks.
+        std::shared_mutex chunkMutex{};
+        /**
+         * Find a loaded chunk.
+         *
+         * @param chunkPos: The position of the chunk.
+         * @return:         The chunk, or nullptr if it is not loaded.
+         */
+        std::shared_ptr<Chunk> findChunk(Coordinate2D<int> chunkPos);
+        /**
+         * Retrieve the highest block of a column from its chunk's heightmap.
+         *
+         * @param worldX: The world x position of the column.
+         * @param worldZ: The world z position of the column.
+         * @return:       The y position of the highest block, -1 if the column is empty or its chunk is not loaded.
+         */
+        int getHighestBlock(int worldX, int worldZ);
         /// A pointer to the block SSBO.
         NeighborInfo* blockSSBOPointer{nullptr};
         /// A pointer to the chunk SSBO.
@@ -68,12 +157,34 @@ namespace Craft
         DrawArraysIndirectCommand * drawCommandBufferPointer{nullptr};
         /// The pointer to the textures object, holding all information on the generated textures.
         Textures* textures{nullptr};
-        /**
-         * Run the compute shader to determine if a block is next to other blocks.
-         *
-         * If the block is next to other blocks, then we will not draw that side. Culling is fun!
-         */
-        void calcNeighborInfo();
+        /// The registry of every block type and its properties.
+        BlockRegistry blockRegistry{};
+        /// The block placed by a right click and generated below the surface, resolved once the registry is loaded.
+        BlockId stoneId{AIR_BLOCK_ID};
+        /// The block generated at the surface, resolved once the registry is loaded.
+        BlockId grassId{AIR_BLOCK_ID};
+        /// Propagates the sky and block light of the chunks.
+        LightEngine lightEngine{&blockRegistry};
+        /// The density field generating the world's terrain, shared by the generation tasks.
+        DensityField terrain;
+        /// The directory of the regions written by chunkcraft-pregen, empty to generate every chunk.
+        std::filesystem::path regionDirectory;
+        /// Generates the terrain's occupancy on the GPU when GPU_TERRAIN is set.
+        GpuTerrain gpuTerrain;
+        /// Whether the terrain is generated with gpuTerrain, false if GPU_TERRAIN is unset or it failed to initialize.
+        bool useGpuTerrain{false};
+        /// The chunks of the batch gpuTerrain is generating, in the order of their positions within the batch.
+        std::vector<std::shared_ptr<Chunk>> gpuTerrainChunks{};
+        /// The positions of the batch gpuTerrain is generating.
+        std::vector<Coordinate2D<int>> gpuTerrainPositions{};
+        /// The statistics gathered by the world.
+        WorldStats stats{};
+        /// Retrieve the frame time statistics of the last FRAME_TIME_WINDOW frames.
+        [[nodiscard]] inline Engine::FrameTimeStats getFrameTimeStats() const { return timer.getFrameTimeStats(); }
+        /// Sample the world's streaming and memory counters. Must be called by the main thread.
+        WorldLiveStats sampleLiveStats();
+        /// Retrieve whether the player is standing still and no chunk is waiting for or moving through the pipeline.
+        bool isSteadyState();
         /**
          * Calculate a blocks ambient occlusion. Super simple voxel based ambient occlusion.
          *
@@ -81,19 +192,44 @@ namespace Craft
          */
         void calcAmbientOcclusionInfo();
         /**
-         * Update the blocks instance data.
+         * Advance the chunks through the pipeline: generate, neighbor, ambient occlusion, mesh, then upload.
          *
-         * The instances to draw are based on each side of a block. If we group sides together, then we can
-         * easily omit a side when we want to cull it.
+         * A chunk enters the neighbor stage once every bordering chunk within the render distance is generated, then
+         * moves through the remaining stages in order. A chunk whose neighbor arrives after its neighbor stage is sent
+         * back through the pipeline once uploaded. Each stage stops taking chunks once it has used its time budget for
+         * the frame, leaving the rest for the next frame. Chunks left outside the render distance are unloaded first.
          */
-        void updateInstanceIdxVBO();
+        void advanceChunkPipeline();
         /**
-         * Given a blocks info (chunkPos and chunk relative block position), append another chunk if the block
-         * is on the edge of the chunk.
+         * The generate stage when generating on the GPU: hand the finished batch of terrain.comp to the workers, then
+         * dispatch the next batch of queued positions.
+         */
+        void advanceGpuTerrain();
+        /**
+         * Build the instance lists and draw commands of chunks on the GPU.
          *
-         * @param info: The info of the block being updated.
+         * Each chunk's draw commands are reset, then compact.comp appends every visible face of the chunk to its
+         * side's instance list using workgroup prefix sums and one atomic per side and workgroup. The neighbor
+         * information of the chunks must already be dispatched, and the caller must own the chunks.
+         *
+         * @param chunksToCompact: The chunks to compact.
          */
-        void appendAdditionalAffectedChunks(BlockInfo info);
+        void compactInstanceIdxs(const std::vector<std::shared_ptr<Chunk>>& chunksToCompact);
+        /**
+         * Recalculate the neighbor information and compact the instance lists of the READY chunks among the given
+         * ones. Used instead of updateNeighbors when meshing on the GPU.
+         *
+         * @param chunkPositions: The positions of the chunks affected by the frame's edits.
+         */
+        void remeshEditedChunks(const std::vector<Coordinate2D<int>>& chunkPositions);
+        /**
+         * Given a blocks info (chunkPos and chunk relative block position), append the block's chunk, and another
+         * chunk if the block is on the edge of the chunk, unless they are already listed.
+         *
+         * @param info:           The info of the block being updated.
+         * @param affectedChunks: The list of chunks to append to.
+         */
+        void appendAdditionalAffectedChunks(BlockInfo info, std::vector<Coordinate2D<int>>& affectedChunks);
         /**
          * Given a blocks info (chunkPos and chunk relative block position), explicitly update the neighbor information
          * to draw specific sides. This ensures that when you delete a block, the correct sides will be drawn
@@ -103,6 +239,74 @@ namespace Craft
          */
         void updateNeighbors(BlockInfo info);
         void updateNeighborsCreatedBlock(BlockInfo info);
+        /**
+         * The single block edits waiting for the next world update. Any thread may push to it, the main thread
+         * applies up to MAX_EDITS_PER_FRAME of them each frame.
+         */
+        EditQueue editQueue{};
+        /**
+         * Queue the edits of the current tick's clicks: left click deletes the block the player is looking at, right
+         * click places stone against the side of it.
+         */
+        void queueClickEdits();
+        /**
+         * Apply the queued edits, up to MAX_EDITS_PER_FRAME per frame.
+         *
+         * Edits of the same block are coalesced, the rest are written straight into their chunks and relit. The
+         * affected chunks then have their faces and ambient occlusion updated once for the whole batch.
+         */
+        void applyQueuedEdits();
+        /**
+         * Set every block within a box.
+         *
+         * Bulk edits write every affected chunk's blocks in parallel on the workers, then send each changed chunk,
+         * and each chunk bordering a changed block, through the pipeline once. Chunks that are not loaded, or are
+         * generating or unloading, are left untouched.
+         *
+         * @param firstCorner:  The world position of a corner of the box, inclusive.
+         * @param secondCorner: The world position of the opposite corner of the box, inclusive.
+         * @param id:           The new type of the blocks, AIR_BLOCK_ID to remove them.
+         * @return:             The number of chunks that changed.
+         */
+        int fillBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockId id);
+        /**
+         * Set every block within a sphere.
+         *
+         * @param center: The world position of the sphere's center.
+         * @param radius: The radius of the sphere in blocks.
+         * @param id:     The new type of the blocks, AIR_BLOCK_ID to remove them.
+         * @return:       The number of chunks that changed.
+         */
+        int fillSphere(Coordinate<int> center, int radius, BlockId id);
+        /**
+         * Replace every block of one type within a box with another type.
+         *
+         * @param firstCorner:  The world position of a corner of the box, inclusive.
+         * @param secondCorner: The world position of the opposite corner of the box, inclusive.
+         * @param from:         The type of the blocks to replace.
+         * @param to:           The type to replace them with.
+         * @return:             The number of chunks that changed.
+         */
+        int replaceBlocks(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockId from, BlockId to);
+        /**
+         * Copy the blocks within a box into a buffer.
+         *
+         * @param firstCorner:  The world position of a corner of the box, inclusive.
+         * @param secondCorner: The world position of the opposite corner of the box, inclusive.
+         * @param out:          The buffer to write to, resized to the box.
+         * @return:             True if every chunk within the box is loaded, else false and the blocks of the missing
+         *                      chunks are air.
+         */
+        bool copyBlocks(Coordinate<int> firstCorner, Coordinate<int> secondCorner, BlockBuffer& out);
+        /**
+         * Paste a buffer of blocks into the world.
+         *
+         * @param origin:   The world position of the buffer's corner with the lowest coordinates.
+         * @param buffer:   The blocks to paste.
+         * @param pasteAir: Whether the air of the buffer removes blocks, else it leaves them alone.
+         * @return:         The number of chunks that changed.
+         */
+        int pasteBlocks(Coordinate<int> origin, const BlockBuffer& buffer, bool pasteAir);
     private:
         /// The Buffers and Array Objects.
         GLuint VAO{0};
@@ -111,9 +315,16 @@ namespace Craft
         GLuint blockSSBO{0};
         GLuint chunkSSBO{0};
         GLuint idxSSBO{0};
+        GLuint lightSSBO{0};
         GLuint indirectBO{0};
         /// A pointer to the idx SSBO - Holds information on which idx within the blockSSBO a given instance pertains to.
         int* idxSSBOPointer{nullptr};
+        /// A pointer to the light SSBO - Holds the packed light of every block, read by the ambient occlusion compute.
+        uint8_t* lightSSBOPointer{nullptr};
+        /// The size in bytes of the persistently mapped buffers.
+        size_t mappedBufferBytes{0};
+        /// The number of block sides drawn by the last frame.
+        uint64_t frameInstancesDrawn{0};
         /// The game timer.
         Engine::Timer timer;
         /// A blockProgram for drawing blocks.
@@ -124,18 +335,46 @@ namespace Craft
         Engine::Compute* neighborCompute;
         /// A blockProgram for our neighbor information compute.
         Engine::Compute* ambientOccCompute;
+        /// A blockProgram for compacting visible faces into the instance lists.
+        Engine::Compute* compactCompute;
+        /// The per-frame uniforms shared by the block and world programs.
+        Engine::FrameUniforms* frameUniforms;
+        /// Times the world's compute dispatches and draws on the GPU.
+        Engine::GpuProfiler* gpuProfiler;
+        /// The neighbor compute's handle for the chunk being dispatched.
+        Engine::Uniform<glm::ivec2> neighborChunkPosUniform{};
+        /// The ambient occlusion compute's handle for the chunk being dispatched.
+        Engine::Uniform<glm::ivec2> ambientChunkPosUniform{};
+        /// The compaction compute's handle for the chunk being dispatched.
+        Engine::Uniform<glm::ivec2> compactChunkPosUniform{};
+        /// The compaction compute's handle for switching between resetting draw commands and compacting.
+        Engine::Uniform<bool> compactResetUniform{};
         /// The pool instance of the chunk.
         ThreadPool pool{std::thread::hardware_concurrency()};
         /// The array of futures to be ran through the thread pool.
-        std::vector<std::future<void>> futures{};
+        std::vector<std::future<void>, Engine::TrackedAllocator<std::future<void>, Engine::TASK_MEMORY>> futures{};
         /// A mutex for access the coords set.
         std::mutex coordsMutex{};
-        /// Mutexes for updating the update vectors of Neighbor, Ambient Occ, and Instance info
-        std::mutex chunkNeighborMutex{};
+        /// The storage of the coords map's nodes.
+        Engine::NodePool coordsNodes{Engine::WORLD_MEMORY};
+        /// A mutex for updating the chunks to update ambient occlusion info for.
         std::mutex chunkAmbientMutex{};
-        std::mutex chunkVBOMutex{};
-        /// The chunks that we need to update neighbor information for.
-        std::vector<Coordinate2D<int>> chunksAdded;
+        /// Guards chunksToGenerate and chunksGenerated.
+        std::mutex chunkGenerateMutex{};
+        /// The positions of the chunks waiting for the generate stage.
+        std::vector<Coordinate2D<int>> chunksToGenerate{};
+        /// The chunks generated by the workers since the last pipeline update.
+        std::vector<std::shared_ptr<Chunk>> chunksGenerated{};
+        /// The edits applied by the current frame, coalesced per block. Only accessed by the main thread.
+        std::vector<BlockEdit> editBatch{};
+        /// The ground the entities colliding with it walk on, covering the chunks within the render distance.
+        EntityGround entityGround{};
+        /// Copy the heightmaps of the chunks within the render distance into entityGround.
+        void updateEntityGround();
+        /// The chunks past the generate stage that are not yet READY. Only accessed by the main thread.
+        std::vector<std::shared_ptr<Chunk>> pipelineChunks{};
+        /// The number of chunks being generated or meshed by the workers.
+        std::atomic<int> workerChunksInFlight{0};
         /// The X coordinate of the first chunk to render (inclusive).
         int chunkStartX;
         /// The Z coordinate of the first chunk to render (inclusive).
@@ -147,26 +386,140 @@ namespace Craft
         /// A Coordinate 2D for catching chunk difference failure and camera update failures.
         Coordinate2D<int> failureCoord{-2, -2};
         /// A mapping of chunk coords to a block position bitmap.
-        std::unordered_map<Coordinate2D<int>, std::unordered_map<Coordinate<int>, Block>*> coords{};
+        ChunkBlockMaps coords;
+        /// Recycles the chunks unloaded by the world.
+        ChunkPool chunkPool;
         /// The sun object for handling the in-game time.
         Sun sun;
         /**
-         * A helper function for initializing a chunk.
+         * Generate the blocks of a chunk on a worker, handing it to the neighbor stage once done.
+         *
+         * @param chunk:              The chunk to generate, in the GENERATING state.
+         * @param occupancyGenerated: Whether the chunk's occupancy was already generated on the GPU.
+         */
+        void generateChunk(const std::shared_ptr<Chunk>& chunk, bool occupancyGenerated = false);
+        /**
+         * Set the occupancy of a generating chunk from its pre-generated region, if one was written for the world's
+         * terrain.
+         *
+         * @param chunk: The chunk to load, in the GENERATING state.
+         * @return:      True if the chunk's occupancy was loaded, else false and the chunk is left untouched.
+         */
+        bool loadRegionChunk(const std::shared_ptr<Chunk>& chunk);
+        /**
+         * Build the instance lists of a chunk on a worker, handing it to the upload stage once done.
+         *
+         * @param chunk: The chunk to mesh, in the MESHING state.
+         */
+        void meshChunk(const std::shared_ptr<Chunk>& chunk);
+        /**
+         * Gather the light neighborhood of a chunk. Chunks that are not loaded, generating or unloading are left out.
+         *
+         * @param chunkPos:           The position of the center chunk.
+         * @param neighborhoodChunks: Set to the chunks of the neighborhood, keeping them alive while it is used.
+         * @return:                   The neighborhood.
+         */
+        LightNeighborhood getLightNeighborhood(
+            Coordinate2D<int> chunkPos,
+            std::shared_ptr<Chunk> (&neighborhoodChunks)[LIGHT_NEIGHBORHOOD_CHUNKS]
+        );
+        /**
+         * Copy the light of the changed chunks of a neighborhood to the light SSBO, and queue the chunks to have
+         * their faces repacked by the ambient occlusion compute.
+         *
+         * @param neighborhoodChunks: The chunks of the neighborhood.
+         * @param changed:            A bitmask of the changed chunks, as returned by the light engine.
+         */
+        void publishLight(const std::shared_ptr<Chunk> (&neighborhoodChunks)[LIGHT_NEIGHBORHOOD_CHUNKS], uint16_t changed);
+        /**
+         * Spread light across the borders of a chunk entering the neighbor stage, its bordering chunks being
+         * generated.
          *
-         * @param x: The x coordinate of the chunks center.
-         * @param z: The z coordinate of the chunks center.
+         * @param chunk: The chunk.
          */
-        void initChunk(Coordinate2D<int> chunkPos);
+        void relightBorders(const std::shared_ptr<Chunk>& chunk);
+        /**
+         * Update the light around an edited block.
+         *
+         * @param info: The info of the block that was edited.
+         */
+        void relightEditedBlock(BlockInfo info);
+        /**
+         * Apply a bulk edit to every block within a box, one task per chunk.
+         *
+         * @tparam Edit:        A function given the world position and type of a block, returning its new type. It is
+         *                      called from several workers at once.
+         * @param firstCorner:  The world position of a corner of the box, inclusive.
+         * @param secondCorner: The world position of the opposite corner of the box, inclusive.
+         * @param edit:         The edit.
+         * @return:             The number of chunks that changed.
+         */
+        template<class Edit>
+        int editBox(Coordinate<int> firstCorner, Coordinate<int> secondCorner, const Edit& edit);
+        /**
+         * Relight the chunks changed by a bulk edit along with the chunks around them, then send the changed chunks,
+         * and the chunks facing their changed borders, through the pipeline once.
+         *
+         * @param editedChunks: The positions of the chunks whose blocks changed, already lit on their own.
+         * @param borderMasks:  The bordering chunks facing each edited chunk's changes, as in ChunkEditResult.
+         */
+        void finishBulkEdit(
+            const std::vector<Coordinate2D<int>>& editedChunks,
+            const std::vector<uint8_t>& borderMasks
+        );
+        /**
+         * Retrieve which bordering chunks of a chunk are generated.
+         *
+         * @param chunkPos: The position of the chunk.
+         * @return:         One bit per neighbor in the order x max, x min, z max, z min.
+         */
+        uint8_t getNeighborMask(Coordinate2D<int> chunkPos);
+        /**
+         * Retrieve whether every bordering chunk of a chunk within the render distance is generated.
+         *
+         * @param chunkPos: The position of the chunk.
+         * @return:         True if the chunk may enter the neighbor stage, else false.
+         */
+        bool neighborsGenerated(Coordinate2D<int> chunkPos);
+        /**
+         * Send READY chunks bordering a newly generated chunk back through the pipeline if they were processed
+         * without it.
+         *
+         * @param chunkPos: The position of the newly generated chunk.
+         */
+        void invalidateNeighbors(Coordinate2D<int> chunkPos);
+        /// Retrieve whether a chunk position is within the render distance.
+        [[nodiscard]] bool isChunkInBounds(Coordinate2D<int> chunkPos) const;
+        /// Retrieve whether no chunk is waiting for or moving through the pipeline.
+        bool isPipelineIdle();
+        /// Retrieve whether the chunk at the center of the render distance and its neighbors are drawn.
+        bool isSpawnAreaReady();
+        /// Queue every chunk within the render distance that is not loaded, nearest to the center first.
+        void queueMissingChunks();
+        /// When the world was created, the start of the startup metrics.
+        std::chrono::steady_clock::time_point startupStart{std::chrono::steady_clock::now()};
+        /// Whether the time to the first frame was reported.
+        bool firstFrameReported{false};
+        /// Whether the time to loading the whole render distance was reported.
+        bool fullRingReported{false};
         /// Calculate the new bounds of the chunks to render.
         void updateChunkBounds();
         /**
          * Update the chunks when a player moves to another chunk.
          *
-         * This means initializing new chunks, calculating neighbor information, and deleting old chunks.
-         *
-         * @param directionDiff: The direction the player is moving.
+         * Moves the render distance, the next advance of the pipeline unloads the chunks outside it and queues the new
+         * chunks for the generate stage.
+         */
+        void updateChunksLoaded();
+        /// Whether chunks outside the render distance may still be loaded. Only accessed by the main thread.
+        bool chunksToUnloadPending{false};
+        /// Whether the chunks of the new render distance are still to be queued. Only accessed by the main thread.
+        bool queueMissingAfterUnload{false};
+        /**
+         * Unload the chunks outside the render distance on the main thread. Chunks a worker is generating or meshing
+         * are skipped and retried on the next advance, so no worker ever waits on another.
          */
-        void updateChunksLoaded(Coordinate2D<int> directionDiff);
+        void unloadOutOfBoundsChunks();
         /// Initialize and map the necessary buffers.
         void initBuffers();
         GLsizei* instanceCount{nullptr};
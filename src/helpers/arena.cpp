@@ -0,0 +1,107 @@
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "arena.hpp"
+
+namespace Engine
+{
+    void* allocatePages(size_t bytes, bool hugePages)
+    {
+#ifdef _WIN32
+        // Large pages require the lock pages in memory privilege, so Windows always uses normal pages.
+        (void) hugePages;
+        return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+        void* pages = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (hugePages)
+        {
+            pages = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (pages == MAP_FAILED)
+        {
+            pages = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (pages == MAP_FAILED) return nullptr;
+#ifdef MADV_HUGEPAGE
+            // Without reserved huge pages, ask for transparent huge pages instead.
+            if (hugePages) madvise(pages, bytes, MADV_HUGEPAGE);
+#endif
+        }
+        return pages;
+#endif
+    }
+    void freePages(void* pages, size_t bytes)
+    {
+        if (pages == nullptr) return;
+#ifdef _WIN32
+        (void) bytes;
+        VirtualFree(pages, 0, MEM_RELEASE);
+#else
+        munmap(pages, bytes);
+#endif
+    }
+
+    NodePool::NodePool(MemoryTag tag)
+        : tag{tag}
+    {}
+    NodePool::~NodePool()
+    {
+        for (void* block: blocks)
+        {
+            freePages(block, NODE_POOL_BLOCK_BYTES);
+        }
+        trackExternalMemory(tag, -(int64_t) getReservedBytes());
+    }
+    void* NodePool::allocate(size_t bytes)
+    {
+        if (nodeSize == 0) nodeSize = roundSize(bytes);
+        if (roundSize(bytes) != nodeSize) return nullptr;
+        if (freeList != nullptr)
+        {
+            void* node = freeList;
+            freeList = *static_cast<void**>(node);
+            return node;
+        }
+        if (blockCursor == nullptr || blockCursor + nodeSize > blockEnd)
+        {
+            void* block = allocatePages(NODE_POOL_BLOCK_BYTES, USE_HUGE_PAGES);
+            if (block == nullptr) throw std::bad_alloc();
+            blocks.push_back(block);
+            trackExternalMemory(tag, (int64_t) NODE_POOL_BLOCK_BYTES);
+            blockCursor = static_cast<char*>(block);
+            blockEnd = blockCursor + NODE_POOL_BLOCK_BYTES;
+        }
+        void* node = blockCursor;
+        blockCursor += nodeSize;
+        return node;
+    }
+    void NodePool::deallocate(void* node)
+    {
+        *static_cast<void**>(node) = freeList;
+        freeList = node;
+    }
+
+    BumpArena::BumpArena(size_t capacity, bool hugePages)
+        : base{static_cast<char*>(allocatePages(capacity, hugePages))}
+        , capacity{capacity}
+    {
+        if (base != nullptr) trackExternalMemory(CHUNK_MEMORY, (int64_t) capacity);
+    }
+    BumpArena::~BumpArena()
+    {
+        if (base == nullptr) return;
+        freePages(base, capacity);
+        trackExternalMemory(CHUNK_MEMORY, -(int64_t) capacity);
+    }
+    BumpArena& getWorkerArena()
+    {
+        static thread_local BumpArena arena{WORKER_ARENA_BYTES, USE_HUGE_PAGES};
+        return arena;
+    }
+}
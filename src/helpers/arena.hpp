@@ -0,0 +1,173 @@
+#ifndef OPENGLDEMO_ARENA_HPP
+#define OPENGLDEMO_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "memoryTracker.hpp"
+
+namespace Engine
+{
+    /// Whether NodePools and BumpArenas request huge pages from the OS, falling back to normal pages if refused.
+    const bool USE_HUGE_PAGES = false;
+    /// The size of every block of pages taken by a NodePool, one huge page.
+    const size_t NODE_POOL_BLOCK_BYTES = 2 * 1024 * 1024;
+    /// The capacity of every worker's arena for transient generation and meshing data.
+    const size_t WORKER_ARENA_BYTES = 2 * 1024 * 1024;
+
+    /**
+     * Map pages directly from the OS, bypassing the heap. The pages are zeroed and only become resident once touched.
+     *
+     * @param bytes:     The number of bytes to map, rounded up to the page size by the OS.
+     * @param hugePages: Whether to request huge pages.
+     * @return:          The pages, or nullptr if the OS refused.
+     */
+    void* allocatePages(size_t bytes, bool hugePages);
+    /**
+     * Unmap pages mapped by allocatePages.
+     *
+     * @param pages: The pages.
+     * @param bytes: The number of bytes passed to allocatePages.
+     */
+    void freePages(void* pages, size_t bytes);
+
+    /**
+     * A free list of fixed size nodes carved out of blocks of pages, used by the hash maps of chunks so clearing and
+     * refilling them recycles their nodes without going through the heap. The node size is set by the first
+     * allocation, so a pool serves the nodes of a single container. Blocks are only returned when the pool is
+     * destroyed. Not thread safe, a pool is guarded by the lock of the container it serves.
+     */
+    class NodePool
+    {
+    public:
+        /// @param tag: The tag to account the pool's pages to.
+        explicit NodePool(MemoryTag tag);
+        ~NodePool();
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+        /**
+         * Allocate a node.
+         *
+         * @param bytes: The size of the node.
+         * @return:      The node, or nullptr if the size does not match the pool's nodes.
+         */
+        void* allocate(size_t bytes);
+        /// Return a node to the pool.
+        void deallocate(void* node);
+        /// Retrieve whether allocations of the given size are served by the pool.
+        [[nodiscard]] inline bool servesSize(size_t bytes) const { return roundSize(bytes) == nodeSize; }
+        /// Retrieve the tag the pool's memory is accounted to.
+        [[nodiscard]] inline MemoryTag getTag() const { return tag; }
+        /// Retrieve the number of bytes of pages held by the pool.
+        [[nodiscard]] inline size_t getReservedBytes() const { return blocks.size() * NODE_POOL_BLOCK_BYTES; }
+    private:
+        /// The tag the pool's pages are accounted to.
+        MemoryTag tag;
+        /// The size of every node, 0 until the first allocation.
+        size_t nodeSize{0};
+        /// The first free node, each free node holding a pointer to the next.
+        void* freeList{nullptr};
+        /// The next unused byte of the newest block, and its end.
+        char* blockCursor{nullptr};
+        char* blockEnd{nullptr};
+        /// The blocks of pages the nodes are carved from.
+        std::vector<void*> blocks{};
+        /// Round a node size up so every node can hold the free list pointer and stays pointer aligned.
+        static inline size_t roundSize(size_t bytes)
+        {
+            return (bytes + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+        }
+    };
+
+    /**
+     * A standard allocator taking single nodes from a NodePool, and anything else (hash map bucket arrays) from the
+     * heap. Default constructed allocators always use the heap.
+     *
+     * @tparam T: The type allocated.
+     */
+    template<class T>
+    class PoolAllocator
+    {
+    public:
+        typedef T value_type;
+
+        PoolAllocator() = default;
+        explicit PoolAllocator(NodePool* pool) : pool{pool} {}
+        template<class U>
+        PoolAllocator(const PoolAllocator<U>& other) : pool{other.pool} {}
+
+        T* allocate(size_t n)
+        {
+            if (pool != nullptr && n == 1 && alignof(T) <= alignof(void*))
+            {
+                void* node = pool->allocate(sizeof(T));
+                if (node != nullptr) return static_cast<T*>(node);
+            }
+            if (pool == nullptr) return static_cast<T*>(::operator new(n * sizeof(T)));
+            MemoryTagScope scope(pool->getTag());
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        void deallocate(T* ptr, size_t n)
+        {
+            if (pool != nullptr && n == 1 && alignof(T) <= alignof(void*) && pool->servesSize(sizeof(T)))
+            {
+                pool->deallocate(ptr);
+                return;
+            }
+            ::operator delete(ptr);
+        }
+        template<class U>
+        bool operator==(const PoolAllocator<U>& other) const { return pool == other.pool; }
+        template<class U>
+        bool operator!=(const PoolAllocator<U>& other) const { return pool != other.pool; }
+
+        /// The pool nodes are taken from, nullptr for the heap.
+        NodePool* pool{nullptr};
+    };
+
+    /**
+     * A linear allocator over a fixed block of pages for transient data. Allocations are released all at once by
+     * reset, so a task resets its thread's arena when it starts.
+     */
+    class BumpArena
+    {
+    public:
+        /**
+         * @param capacity:  The number of bytes the arena may hand out.
+         * @param hugePages: Whether to request huge pages.
+         */
+        BumpArena(size_t capacity, bool hugePages);
+        ~BumpArena();
+        BumpArena(const BumpArena&) = delete;
+        BumpArena& operator=(const BumpArena&) = delete;
+        /**
+         * Allocate an uninitialized array from the arena.
+         *
+         * @tparam T:     The type of the elements.
+         * @param count:  The number of elements.
+         * @return:       The array, or nullptr if the arena is full.
+         */
+        template<class T>
+        T* allocate(size_t count)
+        {
+            auto aligned = (cursor + alignof(T) - 1) & ~(alignof(T) - 1);
+            if (base == nullptr || aligned + (count * sizeof(T)) > capacity) return nullptr;
+            cursor = aligned + (count * sizeof(T));
+            return reinterpret_cast<T*>(base + aligned);
+        }
+        /// Release every allocation.
+        inline void reset() { cursor = 0; }
+    private:
+        /// The pages of the arena.
+        char* base{nullptr};
+        /// The number of bytes of the arena.
+        size_t capacity;
+        /// The offset of the next free byte.
+        size_t cursor{0};
+    };
+    /// Retrieve the calling thread's arena, created with WORKER_ARENA_BYTES on first use.
+    BumpArena& getWorkerArena();
+}
+
+#endif //OPENGLDEMO_ARENA_HPP
@@ -77,67 +77,6 @@ bool endsWith(const std::string& s, const std::string& ending)
 
     return true;
 }
-GLint getLoc( GLuint program, const std::string& name )
-{
-    GLint loc = glGetUniformLocation(program, name.c_str());
-    if (loc == -1)
-    {
-        std::cout << "Failed to find location: " << name << std::endl;
-        return -1;
-    }
-    return loc;
-}
-void setBool(GLuint program, const std::string &name, bool value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform1i(loc, value ? 1 : 0);
-}
-void setInt(GLuint program, const std::string &name, int value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform1i(loc, value);
-}
-void setFloat(GLuint program, const std::string &name, float value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform1f(loc, value);
-}
-void setVec2(GLuint program, const std::string &name, glm::vec2 value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform2fv(loc, 1, glm::value_ptr(value));
-}
-void setiVec2(GLuint program, const std::string &name, glm::ivec2 value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform2iv(loc, 1, glm::value_ptr(value));
-}
-void setVec3(GLuint program, const std::string &name, glm::vec3 value)
-{
-    glUseProgram(program);
-    GLint loc = getLoc(program, name);
-    glUniform3fv(loc, 1, glm::value_ptr(value));
-}
-void setiVec3(GLuint program, const std::string &name, glm::ivec3 value)
-{
-    glUseProgram(program);
-    GLint loc = getLoc(program, name);
-    glUniform3iv(loc, 1, glm::value_ptr(value));
-}
-void setVec4(GLuint program, const std::string &name, glm::vec4 value)
-{
-    GLint loc = getLoc(program, name);
-    glUniform4fv(loc, 1, glm::value_ptr(value));
-}
-bool setMat4(GLuint program, const std::string &name, glm::mat4& value)
-{
-    GLint loc = getLoc(program, name);
-    if (loc == -1) {
-        return false;
-    }
-    glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
-    return true;
-}
 void printMatrix4x4(glm::mat4& mat, const std::string& name)
 {
     std::cout << "\n" << name << " Matrix:" << std::endl;
@@ -182,12 +121,21 @@ Craft::BlockInfo getBlockInfo(Craft::Coordinate<int> block, Craft::Coordinate2D<
 }
 bool blockExists(
         Craft::BlockInfo info,
-        std::unordered_map<Craft::Coordinate2D<int>, std::unordered_map<Craft::Coordinate<int>, Craft::Block>*>* coords
+        Craft::ChunkBlockMaps* coords
     )
 {
     auto chunkIter = coords->find(info.chunk);
     if (chunkIter == coords->end()) return false;
-    return chunkIter->second->find(info.block) != chunkIter->second->end();
+    return chunkIter->second->blockExists(info.block.x, info.block.y, info.block.z);
+}
+int highestBlock(
+        Craft::BlockInfo info,
+        Craft::ChunkBlockMaps* coords
+    )
+{
+    auto chunkIter = coords->find(info.chunk);
+    if (chunkIter == coords->end()) return -1;
+    return chunkIter->second->getTopBlock(info.block.x, info.block.z);
 }
 int findChunkIdx(int coord) {
     if ((coord + Craft::RENDER_DISTANCE) < 0)
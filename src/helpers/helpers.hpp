@@ -79,79 +79,6 @@ void saveImageAsPNG(unsigned char* rgbData, int width, int height);
  * @return        True if the string ends with ending else false.
  */
 bool endsWith(const std::string& s, const std::string& ending);
-/**
- * Set a Boolean within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setBool(GLuint program, const std::string &name, bool value);
-/**
- * Set a Integer within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setInt(GLuint program, const std::string &name, int value);
-/**
- * Set a Float within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setFloat(GLuint program, const std::string &name, float value);
-/**
- * Set a 2x1 vector within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setVec2(GLuint program, const std::string &name, glm::vec2 value);
-/**
- * Set a 2x1 integer vector within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setiVec2(GLuint program, const std::string &name, glm::ivec2 value);
-/**
- * Set a 3x1 vector within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setVec3(GLuint program, const std::string &name, glm::vec3 value);
-/**
- * Set a 3x1 integer vector within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setiVec3(GLuint program, const std::string &name, glm::ivec3 value);
-/**
- * Set a 4x1 vector within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- */
-void setVec4(GLuint program, const std::string &name, glm::vec4 value);
-/**
- * Set a 4x4 matrix within the OpenGL program.
- *
- * @param program: The given OpenGL program identifier.
- * @param name:    The name of the shader parameter.
- * @param value:   The value to set.
- * @return         True if mat4 was set, else false
- */
-bool setMat4(GLuint program, const std::string &name, glm::mat4& value);
 /**
  * Print a 4x4 matrix for debugging.
  *
@@ -178,7 +105,14 @@ inline void checkOpenGLError(const std::string& location) {
  * @param coords: The mapping of chunks to a mapping of chunk rel block coordinates to blocks.
  * @return:       A Boolean value of whether the block exists.
  */
-bool blockExists(Craft::BlockInfo info, std::unordered_map<Craft::Coordinate2D<int>, std::unordered_map<Craft::Coordinate<int>, Craft::Block>*>* coords);
+bool blockExists(Craft::BlockInfo info, Craft::ChunkBlockMaps* coords);
+/**
+ * Retrieve the highest block of a column from its chunk's heightmap.
+ * @param info:   The column's chunk and chunk relative coordinate, the y coordinate is ignored.
+ * @param coords: The mapping of chunks to a mapping of chunk rel block coordinates to blocks.
+ * @return:       The y position of the highest block, -1 if the column is empty or its chunk is not loaded.
+ */
+int highestBlock(Craft::BlockInfo info, Craft::ChunkBlockMaps* coords);
 /**
  * Given the x or z coordinate calculate the chunksPos between [0, TOTAL_CHUNK_WIDTH)
  *
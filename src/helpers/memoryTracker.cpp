@@ -0,0 +1,140 @@
+#include <atomic>
+#include <cstdlib>
+
+#include "memoryTracker.hpp"
+
+namespace Engine
+{
+    /// The tag of the calling thread's heap allocations.
+    static thread_local MemoryTag currentTag{UNTAGGED_MEMORY};
+    /// The heap bytes currently allocated by every tag.
+    static std::atomic<int64_t> liveBytes[NUM_MEMORY_TAGS]{};
+    /// The bytes held outside of the heap by every tag.
+    static std::atomic<int64_t> externalBytes[NUM_MEMORY_TAGS]{};
+    /// The heap allocations performed by every tag.
+    static std::atomic<uint64_t> totalAllocations[NUM_MEMORY_TAGS]{};
+    /// The allocations of every tag when the current frame began.
+    static uint64_t frameStartAllocations[NUM_MEMORY_TAGS]{};
+    /// The allocations of every tag during the last complete frame.
+    static uint64_t lastFrameAllocations[NUM_MEMORY_TAGS]{};
+
+    /// Written in front of every allocation so it is released from the tag it was allocated by.
+    struct alignas(alignof(std::max_align_t)) AllocationHeader
+    {
+        /// The size requested by the caller.
+        size_t size;
+        /// The tag the allocation is accounted to.
+        MemoryTag tag;
+    };
+
+    MemoryTag setMemoryTag(MemoryTag tag)
+    {
+        MemoryTag previous = currentTag;
+        currentTag = tag;
+        return previous;
+    }
+    void trackExternalMemory(MemoryTag tag, int64_t bytes)
+    {
+        externalBytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void beginMemoryFrame()
+    {
+        for (int tag=0; tag<NUM_MEMORY_TAGS; tag++)
+        {
+            uint64_t allocations = totalAllocations[tag].load(std::memory_order_relaxed);
+            lastFrameAllocations[tag] = allocations - frameStartAllocations[tag];
+            frameStartAllocations[tag] = allocations;
+        }
+    }
+    MemoryStats getMemoryStats()
+    {
+        MemoryStats stats{};
+        for (int tag=0; tag<NUM_MEMORY_TAGS; tag++)
+        {
+            stats.liveBytes[tag] = liveBytes[tag].load(std::memory_order_relaxed);
+            stats.externalBytes[tag] = externalBytes[tag].load(std::memory_order_relaxed);
+            stats.totalAllocations[tag] = totalAllocations[tag].load(std::memory_order_relaxed);
+            stats.frameAllocations[tag] = lastFrameAllocations[tag];
+        }
+        return stats;
+    }
+    uint64_t getAllocationsThisFrame()
+    {
+        uint64_t allocations = 0;
+        for (int tag=0; tag<NUM_MEMORY_TAGS; tag++)
+        {
+            allocations += totalAllocations[tag].load(std::memory_order_relaxed) - frameStartAllocations[tag];
+        }
+        return allocations;
+    }
+    /**
+     * Allocate memory accounted to the calling thread's tag.
+     *
+     * @param size: The number of bytes requested.
+     * @return:     The memory, or nullptr if the allocation failed.
+     */
+    static void* trackedAlloc(size_t size)
+    {
+        auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+        if (header == nullptr) return nullptr;
+        header->size = size;
+        header->tag = currentTag;
+        liveBytes[header->tag].fetch_add((int64_t) size, std::memory_order_relaxed);
+        totalAllocations[header->tag].fetch_add(1, std::memory_order_relaxed);
+        return header + 1;
+    }
+    /// Release memory allocated by trackedAlloc.
+    static void trackedFree(void* ptr)
+    {
+        if (ptr == nullptr) return;
+        AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+        liveBytes[header->tag].fetch_sub((int64_t) header->size, std::memory_order_relaxed);
+        std::free(header);
+    }
+}
+
+// The replaceable global allocation functions, routing every heap allocation of the process through the tracker.
+// The over-aligned overloads keep their default implementations, which do not call these.
+
+void* operator new(size_t size)
+{
+    void* ptr = Engine::trackedAlloc(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return Engine::trackedAlloc(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return Engine::trackedAlloc(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    Engine::trackedFree(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    Engine::trackedFree(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+    Engine::trackedFree(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept
+{
+    Engine::trackedFree(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    Engine::trackedFree(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    Engine::trackedFree(ptr);
+}
@@ -0,0 +1,124 @@
+#ifndef OPENGLDEMO_MEMORYTRACKER_HPP
+#define OPENGLDEMO_MEMORYTRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Engine
+{
+    /// The subsystems heap memory is accounted to.
+    enum MemoryTag : uint8_t
+    {
+        /// Anything allocated outside of a tagged scope or container.
+        UNTAGGED_MEMORY,
+        /// The chunk and block maps of the world and its pipeline bookkeeping.
+        WORLD_MEMORY,
+        /// The blocks of every chunk.
+        CHUNK_MEMORY,
+        /// The textures loaded from disk.
+        TEXTURE_MEMORY,
+        /// The tasks handed to the thread pool and their futures.
+        TASK_MEMORY,
+        /// Programs, buffers and other rendering state.
+        RENDER_MEMORY,
+        NUM_MEMORY_TAGS
+    };
+    /// The names of the memory tags, indexed by MemoryTag.
+    constexpr const char* MEMORY_TAG_NAMES[NUM_MEMORY_TAGS] = {
+        "untagged", "world", "chunks", "textures", "tasks", "rendering"
+    };
+    /**
+     * Whether to assert that a steady-state frame (the player standing still with the chunk pipeline idle) performs
+     * no heap allocation. Only checked in debug builds.
+     */
+    const bool ASSERT_STEADY_STATE_ALLOCATIONS = false;
+
+    /// A snapshot of the memory accounted to every tag.
+    struct MemoryStats
+    {
+        /// The heap bytes currently allocated.
+        int64_t liveBytes[NUM_MEMORY_TAGS]{};
+        /// The bytes held outside of the heap, such as persistently mapped buffers.
+        int64_t externalBytes[NUM_MEMORY_TAGS]{};
+        /// The heap allocations performed since the process started.
+        uint64_t totalAllocations[NUM_MEMORY_TAGS]{};
+        /// The heap allocations performed during the last frame.
+        uint64_t frameAllocations[NUM_MEMORY_TAGS]{};
+    };
+
+    /**
+     * Set the tag of the calling thread's heap allocations.
+     *
+     * Every operator new is accounted to the calling thread's tag. Use MemoryTagScope or TrackedAllocator rather
+     * than calling this directly.
+     *
+     * @param tag: The tag of the following allocations.
+     * @return:    The previous tag.
+     */
+    MemoryTag setMemoryTag(MemoryTag tag);
+    /**
+     * Account memory held outside of the heap to a tag.
+     *
+     * @param tag:   The tag to account the memory to.
+     * @param bytes: The number of bytes acquired, negative when released.
+     */
+    void trackExternalMemory(MemoryTag tag, int64_t bytes);
+    /// Start a new frame of allocation counts. Called once per frame by the main thread.
+    void beginMemoryFrame();
+    /// Retrieve the memory accounted to every tag, with the allocations of the frame before the last beginMemoryFrame.
+    MemoryStats getMemoryStats();
+    /// Retrieve the allocations performed by every tag since beginMemoryFrame.
+    uint64_t getAllocationsThisFrame();
+
+    /// Accounts the calling thread's heap allocations to a tag until the scope ends.
+    class MemoryTagScope
+    {
+    public:
+        explicit MemoryTagScope(MemoryTag tag) : previous{setMemoryTag(tag)} {}
+        ~MemoryTagScope() { setMemoryTag(previous); }
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+    private:
+        /// The tag to restore.
+        MemoryTag previous;
+    };
+
+    /**
+     * A standard allocator accounting the allocations of a container to a tag, whichever thread grows it.
+     *
+     * @tparam T:   The type allocated.
+     * @tparam Tag: The tag to account the allocations to.
+     */
+    template<class T, MemoryTag Tag>
+    class TrackedAllocator
+    {
+    public:
+        typedef T value_type;
+        template<class U>
+        struct rebind
+        {
+            typedef TrackedAllocator<U, Tag> other;
+        };
+
+        TrackedAllocator() = default;
+        template<class U>
+        TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+
+        T* allocate(size_t n)
+        {
+            MemoryTagScope scope(Tag);
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        void deallocate(T* ptr, size_t)
+        {
+            ::operator delete(ptr);
+        }
+        template<class U>
+        bool operator==(const TrackedAllocator<U, Tag>&) const { return true; }
+        template<class U>
+        bool operator!=(const TrackedAllocator<U, Tag>&) const { return false; }
+    };
+}
+
+#endif //OPENGLDEMO_MEMORYTRACKER_HPP
@@ -0,0 +1,106 @@
+#ifndef OPENGLDEMO_MPSCQUEUE_HPP
+#define OPENGLDEMO_MPSCQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+namespace Engine
+{
+    /// The size of a cache line, keeping the producers' and the consumer's positions from sharing one.
+    const size_t CACHE_LINE_BYTES = 64;
+
+    /**
+     * A bounded lock-free queue with any number of producers and a single consumer.
+     *
+     * Each cell holds a sequence number telling whose turn it is: a producer claims the tail with a compare and swap
+     * once the cell's sequence shows it is free, writes the value, then publishes it by advancing the sequence. The
+     * consumer reads a cell once its sequence shows it is published and hands it back to the producers a lap later.
+     * Neither side ever blocks, a push to a full queue fails instead.
+     *
+     * @tparam T:        The type of the values, copied in and out.
+     * @tparam Capacity: The number of values the queue holds, a power of two.
+     */
+    template<class T, size_t Capacity>
+    class MpscQueue
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two.");
+    public:
+        MpscQueue()
+        {
+            for (size_t idx=0; idx<Capacity; idx++)
+            {
+                cells[idx].sequence.store(idx, std::memory_order_relaxed);
+            }
+        }
+        ~MpscQueue() = default;
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+        /**
+         * Push a value, from any thread.
+         *
+         * @param value: The value.
+         * @return:      True if the value was queued, else false as the queue is full.
+         */
+        bool push(const T& value)
+        {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = cells[pos & (Capacity - 1)];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto lap = (intptr_t) sequence - (intptr_t) pos;
+                if (lap == 0)
+                {
+                    // On failure pos is reloaded with the tail another producer moved it to.
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lap < 0)
+                {
+                    // The consumer has not yet read the value pushed a lap ago.
+                    return false;
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        /**
+         * Pop the oldest value. Only the consumer thread may call this.
+         *
+         * @param out: Set to the value.
+         * @return:    True if a value was popped, else false as the queue is empty.
+         */
+        bool pop(T& out)
+        {
+            Cell& cell = cells[head & (Capacity - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != head + 1) return false;
+            out = cell.value;
+            cell.sequence.store(head + Capacity, std::memory_order_release);
+            head++;
+            return true;
+        }
+    private:
+        /// A slot of the queue and the sequence number telling whether it is free or published.
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+        /// The slots of the queue.
+        Cell cells[Capacity];
+        /// The position of the next push, shared by the producers.
+        alignas(CACHE_LINE_BYTES) std::atomic<size_t> tail{0};
+        /// The position of the next pop, owned by the consumer.
+        alignas(CACHE_LINE_BYTES) size_t head{0};
+    };
+}
+
+#endif //OPENGLDEMO_MPSCQUEUE_HPP
@@ -6,13 +6,31 @@
 
 namespace Craft
 {
+    /// The plane the Perlin backend samples for 2D noise, kept from the original heightmap generator.
+    const float PERLIN_2D_PLANE_Y = 100.0f / 7.0f;
+    /// The skew and unskew factors of the 2D simplex grid.
+    const float SIMPLEX_F2 = 0.36602540378f;
+    const float SIMPLEX_G2 = 0.21132486540f;
+    /// The skew and unskew factors of the 3D simplex grid.
+    const float SIMPLEX_F3 = 1.0f / 3.0f;
+    const float SIMPLEX_G3 = 1.0f / 6.0f;
+    /// Scales the sum of the corner contributions to the spread of the Perlin backend, within [-1, 1].
+    const float SIMPLEX_2D_SCALE = 45.0f;
+    const float SIMPLEX_3D_SCALE = 20.0f;
+    /// Large primes decorrelating the lattice coordinates within the gradient hash.
+    const int SIMPLEX_PRIME_X = 501125321;
+    const int SIMPLEX_PRIME_Y = 1136930381;
+    const int SIMPLEX_PRIME_Z = 1720413743;
+
     /// Code adopted from the Java code here: https://mrl.cs.nyu.edu/~perlin/noise/
     /// Additional information on the improved Noise algorithm:
     /// chrome-extension://efaidnbmnnnibpcajpcglclefindmkaj/https://mrl.cs.nyu.edu/~perlin/paper445.pdf
-    Noise::Noise(uint32_t seed) {
-        p.resize(512);
+    Noise::Noise(uint32_t seed, NoiseBackend backend)
+        : backend{backend}
+        , seed{seed}
+    {
         // Initialize the permutation vector with values 0 to 255
-        std::vector<int> permutation(256);
+        std::array<int, 256> permutation{};
         std::iota(permutation.begin(), permutation.end(), 0);
 
         // Shuffle the permutation vector using the provided seed
@@ -61,10 +79,13 @@ namespace Craft
 
         for (int i = 0; i < octaves; i++) {
             // Compute noise with the current frequency and amplitude
-            __m256 noiseResult = _mm256_noise_ps(_mm256_mul_ps(x, frequency_ps),
-                                                 _mm256_mul_ps(y, frequency_ps),
-                                                 _mm256_mul_ps(z, frequency_ps)
-            );
+            __m256 noiseResult = backend == NoiseBackend::SIMPLEX
+                    ? _mm256_simplex3D_ps(_mm256_mul_ps(x, frequency_ps),
+                                          _mm256_mul_ps(y, frequency_ps),
+                                          _mm256_mul_ps(z, frequency_ps))
+                    : _mm256_noise_ps(_mm256_mul_ps(x, frequency_ps),
+                                      _mm256_mul_ps(y, frequency_ps),
+                                      _mm256_mul_ps(z, frequency_ps));
             total = _mm256_fmadd_ps(
                         noiseResult,
                         amplitude_ps,
@@ -82,6 +103,178 @@ namespace Craft
         // Normalize the result
         return _mm256_div_ps(total, maxValue);
     }
+    __m256 Noise::__m256_fractalNoise2D_ps(
+            __m256 x,
+            __m256 z,
+            int octaves,
+            float persistence,
+            float amplitude,
+            float frequency
+    ) {
+        if (backend == NoiseBackend::PERLIN)
+        {
+            return __m256_fractalNoise_ps(
+                    x, _mm256_set1_ps(PERLIN_2D_PLANE_Y), z, octaves, persistence, amplitude, frequency
+                );
+        }
+        __m256 total = _mm256_setzero_ps();
+        __m256 maxValue = _mm256_setzero_ps();
+        __m256 amplitude_ps = _mm256_set1_ps(amplitude);
+        __m256 frequency_ps = _mm256_set1_ps(frequency);
+        for (int i = 0; i < octaves; i++) {
+            __m256 noiseResult = _mm256_simplex2D_ps(_mm256_mul_ps(x, frequency_ps), _mm256_mul_ps(z, frequency_ps));
+            total = _mm256_fmadd_ps(noiseResult, amplitude_ps, total);
+            maxValue = _mm256_add_ps(maxValue, amplitude_ps);
+            amplitude_ps = _mm256_mul_ps(amplitude_ps, _mm256_set1_ps(persistence));
+            frequency_ps = _mm256_mul_ps(frequency_ps, _mm256_set1_ps(2.0f));
+        }
+        return _mm256_div_ps(total, maxValue);
+    }
+    /**
+     * Hash the lattice coordinates of a simplex corner into gradient bits.
+     *
+     * @param seed: The seed of the generator.
+     * @param i:    The lattice x coordinate, premultiplied by SIMPLEX_PRIME_X.
+     * @param j:    The lattice y coordinate, premultiplied by SIMPLEX_PRIME_Y.
+     * @param k:    The lattice z coordinate, premultiplied by SIMPLEX_PRIME_Z.
+     * @return:     The hash, its low 4 bits pick the gradient.
+     */
+    static inline __m256i _mm256_simplexHash_epi32(__m256i seed, __m256i i, __m256i j, __m256i k)
+    {
+        __m256i hash = _mm256_xor_si256(_mm256_xor_si256(seed, i), _mm256_xor_si256(j, k));
+        hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x27d4eb2d));
+        return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 15));
+    }
+    /**
+     * The falloff of a simplex corner's contribution, (t > 0 ? t^4 : 0).
+     *
+     * @param t: The radius of the corner's kernel minus the squared distance to it.
+     */
+    static inline __m256 _mm256_simplexFalloff_ps(__m256 t)
+    {
+        t = _mm256_max_ps(t, _mm256_setzero_ps());
+        t = _mm256_mul_ps(t, t);
+        return _mm256_mul_ps(t, t);
+    }
+    __m256 Noise::_mm256_simplex2D_ps(__m256 x, __m256 z) const
+    {
+        // Skew the input onto the grid of triangles and find the cell containing the point.
+        __m256 skew = _mm256_mul_ps(_mm256_add_ps(x, z), _mm256_set1_ps(SIMPLEX_F2));
+        __m256 cellX = _mm256_floor_ps(_mm256_add_ps(x, skew));
+        __m256 cellZ = _mm256_floor_ps(_mm256_add_ps(z, skew));
+        __m256 unskew = _mm256_mul_ps(_mm256_add_ps(cellX, cellZ), _mm256_set1_ps(SIMPLEX_G2));
+        __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(cellX, unskew));
+        __m256 z0 = _mm256_sub_ps(z, _mm256_sub_ps(cellZ, unskew));
+
+        // The middle corner of the triangle is along x in the lower triangle, else along z.
+        __m256 lower = _mm256_cmp_ps(x0, z0, _CMP_GT_OQ);
+        __m256 one = _mm256_set1_ps(1.0f);
+        __m256 i1 = _mm256_and_ps(lower, one);
+        __m256 k1 = _mm256_andnot_ps(lower, one);
+        __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, i1), _mm256_set1_ps(SIMPLEX_G2));
+        __m256 z1 = _mm256_add_ps(_mm256_sub_ps(z0, k1), _mm256_set1_ps(SIMPLEX_G2));
+        __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(2.0f * SIMPLEX_G2));
+        __m256 z2 = _mm256_add_ps(_mm256_sub_ps(z0, one), _mm256_set1_ps(2.0f * SIMPLEX_G2));
+
+        __m256i seed_epi32 = _mm256_set1_epi32((int) seed);
+        __m256i i = _mm256_mullo_epi32(_mm256_cvtps_epi32(cellX), _mm256_set1_epi32(SIMPLEX_PRIME_X));
+        __m256i k = _mm256_mullo_epi32(_mm256_cvtps_epi32(cellZ), _mm256_set1_epi32(SIMPLEX_PRIME_Z));
+        __m256i iStep = _mm256_and_si256(_mm256_castps_si256(lower), _mm256_set1_epi32(SIMPLEX_PRIME_X));
+        __m256i kStep = _mm256_andnot_si256(_mm256_castps_si256(lower), _mm256_set1_epi32(SIMPLEX_PRIME_Z));
+        __m256i zero = _mm256_setzero_si256();
+        __m256i hash0 = _mm256_simplexHash_epi32(seed_epi32, i, zero, k);
+        __m256i hash1 = _mm256_simplexHash_epi32(seed_epi32, _mm256_add_epi32(i, iStep), zero, _mm256_add_epi32(k, kStep));
+        __m256i hash2 = _mm256_simplexHash_epi32(
+                seed_epi32,
+                _mm256_add_epi32(i, _mm256_set1_epi32(SIMPLEX_PRIME_X)),
+                zero,
+                _mm256_add_epi32(k, _mm256_set1_epi32(SIMPLEX_PRIME_Z))
+            );
+
+        // Each corner's gradient is one of the 3D Perlin gradients, evaluated on the y = 0 plane.
+        __m256 half = _mm256_set1_ps(0.5f);
+        __m256 t0 = _mm256_fnmadd_ps(z0, z0, _mm256_fnmadd_ps(x0, x0, half));
+        __m256 t1 = _mm256_fnmadd_ps(z1, z1, _mm256_fnmadd_ps(x1, x1, half));
+        __m256 t2 = _mm256_fnmadd_ps(z2, z2, _mm256_fnmadd_ps(x2, x2, half));
+        __m256 ySlice = _mm256_setzero_ps();
+        __m256 n = _mm256_mul_ps(_mm256_simplexFalloff_ps(t0), _mm256_grad_ps(hash0, x0, ySlice, z0));
+        n = _mm256_fmadd_ps(_mm256_simplexFalloff_ps(t1), _mm256_grad_ps(hash1, x1, ySlice, z1), n);
+        n = _mm256_fmadd_ps(_mm256_simplexFalloff_ps(t2), _mm256_grad_ps(hash2, x2, ySlice, z2), n);
+        return _mm256_mul_ps(n, _mm256_set1_ps(SIMPLEX_2D_SCALE));
+    }
+    __m256 Noise::_mm256_simplex3D_ps(__m256 x, __m256 y, __m256 z) const
+    {
+        // Skew the input onto the grid of tetrahedrons and find the cell containing the point.
+        __m256 skew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), _mm256_set1_ps(SIMPLEX_F3));
+        __m256 cellX = _mm256_floor_ps(_mm256_add_ps(x, skew));
+        __m256 cellY = _mm256_floor_ps(_mm256_add_ps(y, skew));
+        __m256 cellZ = _mm256_floor_ps(_mm256_add_ps(z, skew));
+        __m256 unskew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(cellX, cellY), cellZ), _mm256_set1_ps(SIMPLEX_G3));
+        __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(cellX, unskew));
+        __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(cellY, unskew));
+        __m256 z0 = _mm256_sub_ps(z, _mm256_sub_ps(cellZ, unskew));
+
+        // Rank the offsets to find the tetrahedron, the second and third corners step along the largest axes.
+        __m256 xGeY = _mm256_cmp_ps(x0, y0, _CMP_GE_OQ);
+        __m256 yGeZ = _mm256_cmp_ps(y0, z0, _CMP_GE_OQ);
+        __m256 xGeZ = _mm256_cmp_ps(x0, z0, _CMP_GE_OQ);
+        __m256 i1 = _mm256_and_ps(xGeY, xGeZ);
+        __m256 j1 = _mm256_andnot_ps(xGeY, yGeZ);
+        __m256 k1 = _mm256_andnot_ps(_mm256_or_ps(xGeZ, yGeZ), _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+        __m256 i2 = _mm256_or_ps(xGeY, xGeZ);
+        __m256 j2 = _mm256_or_ps(_mm256_andnot_ps(xGeY, _mm256_castsi256_ps(_mm256_set1_epi32(-1))), yGeZ);
+        __m256 k2 = _mm256_andnot_ps(_mm256_and_ps(xGeZ, yGeZ), _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+
+        __m256 one = _mm256_set1_ps(1.0f);
+        __m256 g3 = _mm256_set1_ps(SIMPLEX_G3);
+        __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(i1, one)), g3);
+        __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_and_ps(j1, one)), g3);
+        __m256 z1 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_and_ps(k1, one)), g3);
+        __m256 g3x2 = _mm256_set1_ps(2.0f * SIMPLEX_G3);
+        __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(i2, one)), g3x2);
+        __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_and_ps(j2, one)), g3x2);
+        __m256 z2 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_and_ps(k2, one)), g3x2);
+        __m256 g3x3 = _mm256_set1_ps((3.0f * SIMPLEX_G3) - 1.0f);
+        __m256 x3 = _mm256_add_ps(x0, g3x3);
+        __m256 y3 = _mm256_add_ps(y0, g3x3);
+        __m256 z3 = _mm256_add_ps(z0, g3x3);
+
+        __m256i seed_epi32 = _mm256_set1_epi32((int) seed);
+        __m256i primeX = _mm256_set1_epi32(SIMPLEX_PRIME_X);
+        __m256i primeY = _mm256_set1_epi32(SIMPLEX_PRIME_Y);
+        __m256i primeZ = _mm256_set1_epi32(SIMPLEX_PRIME_Z);
+        __m256i i = _mm256_mullo_epi32(_mm256_cvtps_epi32(cellX), primeX);
+        __m256i j = _mm256_mullo_epi32(_mm256_cvtps_epi32(cellY), primeY);
+        __m256i k = _mm256_mullo_epi32(_mm256_cvtps_epi32(cellZ), primeZ);
+        __m256i hash0 = _mm256_simplexHash_epi32(seed_epi32, i, j, k);
+        __m256i hash1 = _mm256_simplexHash_epi32(
+                seed_epi32,
+                _mm256_add_epi32(i, _mm256_and_si256(_mm256_castps_si256(i1), primeX)),
+                _mm256_add_epi32(j, _mm256_and_si256(_mm256_castps_si256(j1), primeY)),
+                _mm256_add_epi32(k, _mm256_and_si256(_mm256_castps_si256(k1), primeZ))
+            );
+        __m256i hash2 = _mm256_simplexHash_epi32(
+                seed_epi32,
+                _mm256_add_epi32(i, _mm256_and_si256(_mm256_castps_si256(i2), primeX)),
+                _mm256_add_epi32(j, _mm256_and_si256(_mm256_castps_si256(j2), primeY)),
+                _mm256_add_epi32(k, _mm256_and_si256(_mm256_castps_si256(k2), primeZ))
+            );
+        __m256i hash3 = _mm256_simplexHash_epi32(
+                seed_epi32, _mm256_add_epi32(i, primeX), _mm256_add_epi32(j, primeY), _mm256_add_epi32(k, primeZ)
+            );
+
+        // Sum the contribution of each corner, reusing the Perlin gradients.
+        __m256 radius = _mm256_set1_ps(0.6f);
+        __m256 t0 = _mm256_fnmadd_ps(z0, z0, _mm256_fnmadd_ps(y0, y0, _mm256_fnmadd_ps(x0, x0, radius)));
+        __m256 t1 = _mm256_fnmadd_ps(z1, z1, _mm256_fnmadd_ps(y1, y1, _mm256_fnmadd_ps(x1, x1, radius)));
+        __m256 t2 = _mm256_fnmadd_ps(z2, z2, _mm256_fnmadd_ps(y2, y2, _mm256_fnmadd_ps(x2, x2, radius)));
+        __m256 t3 = _mm256_fnmadd_ps(z3, z3, _mm256_fnmadd_ps(y3, y3, _mm256_fnmadd_ps(x3, x3, radius)));
+        __m256 n = _mm256_mul_ps(_mm256_simplexFalloff_ps(t0), _mm256_grad_ps(hash0, x0, y0, z0));
+        n = _mm256_fmadd_ps(_mm256_simplexFalloff_ps(t1), _mm256_grad_ps(hash1, x1, y1, z1), n);
+        n = _mm256_fmadd_ps(_mm256_simplexFalloff_ps(t2), _mm256_grad_ps(hash2, x2, y2, z2), n);
+        n = _mm256_fmadd_ps(_mm256_simplexFalloff_ps(t3), _mm256_grad_ps(hash3, x3, y3, z3), n);
+        return _mm256_mul_ps(n, _mm256_set1_ps(SIMPLEX_3D_SCALE));
+    }
 
 // SIMD version of the noise function
     __m256 Noise::_mm256_noise_ps(__m256 x, __m256 y, __m256 z)
@@ -6,12 +6,32 @@
 #define OPENGLDEMO_NOISE_HPP
 
 #include <immintrin.h>
+#include <array>
+#include <cstdint>
 
 namespace Craft
 {
+    /// The noise kernels a world's terrain can be generated with.
+    enum class NoiseBackend : uint8_t
+    {
+        /// Improved Perlin noise over a shuffled permutation table, read through AVX2 gathers.
+        PERLIN,
+        /// Simplex noise with hashed gradients, computed in registers without any table reads.
+        SIMPLEX
+    };
+    /// The number of noise backends.
+    const int NUM_NOISE_BACKENDS = (int) NoiseBackend::SIMPLEX + 1;
+    /// The names of the noise backends, indexed by NoiseBackend.
+    constexpr const char* NOISE_BACKEND_NAMES[NUM_NOISE_BACKENDS] = {"perlin", "simplex"};
     class Noise {
     public:
-        Noise(uint32_t seed);
+        /**
+         * Create a noise generator.
+         *
+         * @param seed:    The seed of the permutation table and the gradient hash.
+         * @param backend: The kernel the fractal noise functions sample.
+         */
+        Noise(uint32_t seed, NoiseBackend backend = NoiseBackend::PERLIN);
         float noise(float x, float y, float z) ;
         static float fade(float t);
         /// A function for calculating the linear interpolation between a and b.
@@ -22,6 +42,10 @@ namespace Craft
         static __m256 _mm256_lerp_ps(__m256 t, __m256 a, __m256 b);
         static __m256 _mm256_grad_ps(__m256i hash, __m256 x, __m256 y, __m256 z);
         __m256 _mm256_noise_ps(__m256 x, __m256 y, __m256 z);
+        /// SIMD 2D simplex noise in roughly [-1, 1], using hashed gradients instead of the permutation table.
+        __m256 _mm256_simplex2D_ps(__m256 x, __m256 z) const;
+        /// SIMD 3D simplex noise in roughly [-1, 1], using hashed gradients instead of the permutation table.
+        __m256 _mm256_simplex3D_ps(__m256 x, __m256 y, __m256 z) const;
 
         /**
          * Simple function for creating fractal noise from our noise function.
@@ -44,7 +68,7 @@ namespace Craft
             float amplitude,
             float frequency
         );
-        /// SIMD version of the fractal noise algo above.
+        /// SIMD version of the fractal noise algo above, sampling the generator's backend.
         __m256 __m256_fractalNoise_ps(
                 __m256 x,
                 __m256 y,
@@ -54,10 +78,32 @@ namespace Craft
                 float amplitude,
                 float frequency
         );
+        /**
+         * SIMD fractal noise over the x-z plane. The Perlin backend has no 2D kernel, so it samples its 3D noise on
+         * a fixed plane.
+         */
+        __m256 __m256_fractalNoise2D_ps(
+                __m256 x,
+                __m256 z,
+                int octaves,
+                float persistence,
+                float amplitude,
+                float frequency
+        );
+        /// Retrieve the kernel the fractal noise functions sample.
+        [[nodiscard]] inline NoiseBackend getBackend() const { return backend; }
+        /// Retrieve the seed mixed into the simplex gradient hash.
+        [[nodiscard]] inline uint32_t getSeed() const { return seed; }
+        /// Retrieve the duplicated permutation table of the Perlin backend.
+        [[nodiscard]] inline const std::array<int, 512>& getPermutation() const { return p; }
 
     private:
-        // Permutation vector
-        std::vector<int> p;
+        // Permutation vector, stored inline so creating a generator does not allocate.
+        std::array<int, 512> p{};
+        /// The kernel the fractal noise functions sample.
+        NoiseBackend backend;
+        /// The seed mixed into the simplex gradient hash.
+        uint32_t seed;
     };
 
 }
@@ -13,6 +13,8 @@
 #include <memory>
 #include <type_traits>
 
+#include "memoryTracker.hpp"
+
 class ThreadPool {
 public:
     ThreadPool(size_t);
@@ -27,6 +29,8 @@ public:
      */
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result_t<F, Args...>>;
+    /// Retrieve the number of tasks waiting for a worker.
+    size_t getQueueDepth();
 private:
     std::vector<std::thread> workers;
     std::queue<std::function<void()>> tasks;
@@ -67,6 +71,8 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
 -> std::future<typename std::invoke_result_t<F, Args...>>
 {
     using return_type = typename std::invoke_result_t<F, Args...>;
+    // The task, its future's shared state and its queue entry.
+    Engine::MemoryTagScope memoryScope(Engine::TASK_MEMORY);
     auto task = std::make_shared<std::packaged_task<return_type()>>(
             std::bind(std::forward<F>(f), std::forward<Args>(args)...)
     );
@@ -85,6 +91,12 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
     return res;
 }
 
+inline size_t ThreadPool::getQueueDepth()
+{
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    return tasks.size();
+}
+
 inline ThreadPool::~ThreadPool()
 {
     {
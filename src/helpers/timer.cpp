@@ -2,40 +2,102 @@
 // Created by admin on 6/20/2024.
 //
 
+#include <algorithm>
+
 #include "timer.hpp"
 
 namespace Engine
 {
+    std::chrono::steady_clock::time_point Timer::now() const
+    {
+        return manualClock ? manualTime : std::chrono::steady_clock::now();
+    }
+    void Timer::useManualClock()
+    {
+        manualClock = true;
+        manualTime = std::chrono::steady_clock::now();
+        resetTimer();
+    }
+    void Timer::advanceClock(float millis)
+    {
+        manualTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(millis)
+        );
+    }
     float Timer::getTimeSpan()
     {
-        std::chrono::steady_clock::time_point currTime = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point currTime = now();
         auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(currTime - prevTime);
         prevTime = currTime;
         return (float) diff.count();
     }
     float Timer::getElapsedTime()
     {
-        std::chrono::steady_clock::time_point currTime = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point currTime = now();
         auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(currTime - startTime);
         return (float) diff.count();
     }
     void Timer::startStopWatch()
     {
-        stopWatchStart = std::chrono::steady_clock::now();
+        stopWatchStart = now();
     }
     float Timer::lapStopWatch()
     {
-        std::chrono::steady_clock::time_point currTime = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point currTime = now();
         auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(currTime - stopWatchStart);
         return (float) diff.count();
     }
     void Timer::incFrames()
     {
         frames++;
+        std::chrono::steady_clock::time_point currTime = std::chrono::steady_clock::now();
+        if (lastFrameTime != std::chrono::steady_clock::time_point{})
+        {
+            uint64_t frameIdx = numFrameTimes.load(std::memory_order_relaxed);
+            frameTimes[frameIdx % FRAME_TIME_WINDOW].store(
+                std::chrono::duration<float, std::milli>(currTime - lastFrameTime).count(),
+                std::memory_order_relaxed
+            );
+            numFrameTimes.store(frameIdx + 1, std::memory_order_release);
+        }
+        lastFrameTime = currTime;
+    }
+    FrameTimeStats Timer::getFrameTimeStats() const
+    {
+        FrameTimeStats stats{};
+        uint64_t recorded = numFrameTimes.load(std::memory_order_acquire);
+        stats.numFrames = (int) std::min<uint64_t>(recorded, FRAME_TIME_WINDOW);
+        if (stats.numFrames == 0) return stats;
+
+        // Sorted on the stack, so reading the stats every frame allocates nothing and concurrent readers share no state.
+        std::array<float, FRAME_TIME_WINDOW> window{};
+        for (int frame=0; frame<stats.numFrames; frame++)
+        {
+            window[frame] = frameTimes[frame].load(std::memory_order_relaxed);
+        }
+        std::sort(window.begin(), window.begin() + stats.numFrames);
+
+        float total = 0.0f;
+        for (int frame=0; frame<stats.numFrames; frame++)
+        {
+            total += window[frame];
+        }
+        stats.minMillis = window.front();
+        stats.avgMillis = total / (float) stats.numFrames;
+        stats.p99Millis = window[(size_t) ((float) (stats.numFrames - 1) * 0.99f)];
+        // The slowest 1% of frames, at least one frame.
+        int numLow = std::max(1, stats.numFrames / 100);
+        float lowTotal = 0.0f;
+        for (int frame=stats.numFrames - numLow; frame<stats.numFrames; frame++)
+        {
+            lowTotal += window[frame];
+        }
+        stats.onePercentLowFPS = lowTotal > 0.0f ? 1000.0f * (float) numLow / lowTotal : 0.0f;
+        return stats;
     }
     void Timer::resetTimer()
     {
-        startTime = std::chrono::steady_clock::now();
+        startTime = now();
         prevTime = startTime;
         frames = 0;
     }
@@ -6,9 +6,28 @@
 #define OPENGLDEMO_TIMER_HPP
 
 #include <chrono>
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace Engine
 {
+    /// The number of frames kept by the timer's rolling window of frame times.
+    const int FRAME_TIME_WINDOW = 512;
+    /// Statistics over the timer's rolling window of frame times.
+    struct FrameTimeStats
+    {
+        /// The number of frames within the window.
+        int numFrames{0};
+        /// The shortest frame time in milliseconds.
+        float minMillis{0.0f};
+        /// The average frame time in milliseconds.
+        float avgMillis{0.0f};
+        /// The 99th percentile frame time in milliseconds.
+        float p99Millis{0.0f};
+        /// The frames per second averaged over the slowest 1% of frames.
+        float onePercentLowFPS{0.0f};
+    };
     class Timer
     {
     public:
@@ -18,26 +37,51 @@ namespace Engine
         float getElapsedTime();
         /// Retrieve the time since the getTimeSpan was last called.
         float getTimeSpan();
-        /// Retrieve the current frames per second.
+        /// Retrieve the average frames per second since the timer was reset.
         float getFPS();
         /// Start a stop watch.
         void startStopWatch();
         /// Get the current elapsed time of the stop watch (This is what apple calls it on the clock app idk).
         float lapStopWatch();
-        /// Increment the number of frames elapsed.
+        /// Increment the number of frames elapsed, recording the wall time since the previous frame.
         void incFrames();
+        /**
+         * Retrieve statistics over the last FRAME_TIME_WINDOW frames.
+         *
+         * Lock-free: incFrames is only called by the main thread, so any thread may read the window while it is
+         * written. A frame recorded during the read may replace one of the oldest frames.
+         *
+         * @return: The frame time statistics, zeroed if no frame was recorded.
+         */
+        [[nodiscard]] FrameTimeStats getFrameTimeStats() const;
         /// Reset the time and frames.
         void resetTimer();
         int getFrames();
+        /// Drive the timer with advanceClock instead of the system clock, so replayed input keeps its timing.
+        void useManualClock();
+        /// Advance the manual clock by the given number of milliseconds.
+        void advanceClock(float millis);
     private:
+        /// Retrieve the current time of the timer's clock.
+        std::chrono::steady_clock::time_point now() const;
+        /// Whether the timer is driven by advanceClock.
+        bool manualClock{false};
+        /// The current time of the manual clock.
+        std::chrono::steady_clock::time_point manualTime{std::chrono::steady_clock::now()};
         /// The startTime of the given timer. Only set on initialization and when resetTimer is called.
-        std::chrono::steady_clock::time_point startTime{std::chrono::steady_clock::now()};
+        std::chrono::steady_clock::time_point startTime{manualTime};
         /// The prevTime the timer has called getTimeSpan.
         std::chrono::steady_clock::time_point prevTime{startTime};
         /// The time the stop watch was started.
         std::chrono::steady_clock::time_point stopWatchStart{};
         /// The number of frames.
         float frames{0};
+        /// The wall time of the previous frame. Frame times are real even when the game runs on the manual clock.
+        std::chrono::steady_clock::time_point lastFrameTime{};
+        /// The most recent frame times in milliseconds, a ring buffer indexed by numFrameTimes.
+        std::array<std::atomic<float>, FRAME_TIME_WINDOW> frameTimes{};
+        /// The number of frame times ever recorded, published after each write to frameTimes.
+        std::atomic<uint64_t> numFrameTimes{0};
     };
 }
 
@@ -1,10 +1,58 @@
 #include <iostream>
+#include <string>
 
 #include "setup/app.hpp"
 
-int main()
+/**
+ * Find the noise backend with the given name.
+ *
+ * @param name:    The name of the backend, as in NOISE_BACKEND_NAMES.
+ * @param backend: Set to the backend if found.
+ * @return:        True if a backend has the given name, else false.
+ */
+static bool parseNoiseBackend(const std::string& name, Craft::NoiseBackend& backend)
 {
-    Engine::Application app{};
+    for (int idx=0; idx<Craft::NUM_NOISE_BACKENDS; idx++)
+    {
+        if (name != Craft::NOISE_BACKEND_NAMES[idx]) continue;
+        backend = (Craft::NoiseBackend) idx;
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    Engine::ApplicationOptions options{};
+    for (int arg=1; arg<argc; arg++)
+    {
+        std::string option = argv[arg];
+        if ((option == "--record" || option == "--replay") && arg + 1 < argc)
+        {
+            options.inputMode = option == "--record" ? Engine::InputMode::RECORD : Engine::InputMode::REPLAY;
+            options.inputPath = argv[++arg];
+        }
+        else if (option == "--benchmark" && arg + 1 < argc)
+        {
+            options.inputMode = Engine::InputMode::SCRIPTED;
+            options.benchmarkPath = argv[++arg];
+        }
+        else if (option == "--noise" && arg + 1 < argc && parseNoiseBackend(argv[arg + 1], options.noiseBackend))
+        {
+            arg++;
+        }
+        else if (option == "--regions" && arg + 1 < argc)
+        {
+            options.regionPath = argv[++arg];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--record <path> | --replay <path> | --benchmark <path>]"
+                      << " [--noise perlin|simplex] [--regions <directory>]" << std::endl;
+            return -1;
+        }
+    }
+    Engine::Application app{options};
     if (!app.initialize()) return -1;
     app.run();
     std::cout << "Closing..." << std::endl;
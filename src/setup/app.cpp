@@ -1,6 +1,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <thread>
+#include <chrono>
+#include <cassert>
 
 #include "app.hpp"
 #include "../craft/misc/textures.hpp"
@@ -23,26 +25,42 @@
 #define SCENE_FRAG_SHADER_PATH "src/assets/shader/scene.frag"
 #define NEIGHBOR_COMP_SHADER_PATH "src/assets/shader/neighbor.comp"
 #define AMBIENT_COMP_SHADER_PATH "src/assets/shader/ambient.comp"
+#define COMPACT_COMP_SHADER_PATH "src/assets/shader/compact.comp"
+#define TERRAIN_COMP_SHADER_PATH "src/assets/shader/terrain.comp"
+#define SHADER_CACHE_DIR "shader_cache"
 
 namespace Engine
 {
-    Application::Application()
-        : window(WINDOW_WIDTH, WINDOW_HEIGHT, "ChunkCraft")
+    Application::Application(ApplicationOptions options)
+        : options{std::move(options)}
+        , window(WINDOW_WIDTH, WINDOW_HEIGHT, "ChunkCraft", !this->options.benchmarkPath.empty())
+        , input(&window)
+        , programCache(SHADER_CACHE_DIR)
         , program{new Program(BLOCK_VERT_SHADER_PATH, BLOCK_GEOM_SHADER_PATH, BLOCK_FRAG_SHADER_PATH)}
         , worldProgram{new Program(WORLD_VERT_SHADER_PATH, WORLD_GEOM_SHADER_PATH, WORLD_FRAG_SHADER_PATH)}
         , orthoProgram{new Program(ORTHO_VERT_SHADER_PATH, ORTHO_GEOM_SHADER_PATH, ORTHO_FRAG_SHADER_PATH)}
         , sceneProgram{new Program(SCENE_VERT_SHADER_PATH, SCENE_GEOM_SHADER_PATH, SCENE_FRAG_SHADER_PATH)}
         , neighborCompute{new Compute(NEIGHBOR_COMP_SHADER_PATH)}
         , ambientOccCompute{new Compute(AMBIENT_COMP_SHADER_PATH)}
-        , world{new Craft::World(&window, program, worldProgram, neighborCompute, ambientOccCompute, WINDOW_WIDTH, WINDOW_HEIGHT)}
+        , compactCompute{new Compute(COMPACT_COMP_SHADER_PATH)}
+        , terrainCompute{new Compute(TERRAIN_COMP_SHADER_PATH)}
+        , frameUniforms{new FrameUniforms()}
+        , gpuProfiler{new GpuProfiler()}
+        , world{new Craft::World(&window, &input, program, worldProgram, neighborCompute, ambientOccCompute, compactCompute, terrainCompute, frameUniforms, gpuProfiler, WINDOW_WIDTH, WINDOW_HEIGHT, options.noiseBackend, options.regionPath)}
         , crossHair{new Craft::CrossHair(orthoProgram, &window)}
+        , overlay{new Overlay(&window, world, gpuProfiler)}
     {}
     Application::~Application()
     {
+        delete overlay;
         delete crossHair;
         delete world;
+        delete gpuProfiler;
+        delete frameUniforms;
         delete neighborCompute;
         delete ambientOccCompute;
+        delete compactCompute;
+        delete terrainCompute;
         delete worldProgram;
         delete orthoProgram;
         delete program;
@@ -95,6 +113,8 @@ namespace Engine
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
+
+        sceneProgram->getUniform<int>("screenTexture").set(0);
     }
     bool Application::initialize()
     {
@@ -104,52 +124,89 @@ namespace Engine
             std::cerr << "Failed to initialize window." << std::endl;
             return false;
         }
+        if (!input.initInput(options.inputMode, options.inputPath))
+        {
+            std::cerr << "Failed to initialize input." << std::endl;
+            return false;
+        }
+        if (!options.benchmarkPath.empty() && !benchmark.loadScript(options.benchmarkPath))
+        {
+            std::cerr << "Failed to load benchmark script." << std::endl;
+            return false;
+        }
         std::cout << "Initializing Program." << std::endl;
-        if (!program->initProgram())
+        MemoryTagScope memoryScope(RENDER_MEMORY);
+        programCache.initCache();
+        // Submit every program before checking any of them so the driver may compile them concurrently.
+        program->startProgram(&programCache);
+        worldProgram->startProgram(&programCache);
+        orthoProgram->startProgram(&programCache);
+        sceneProgram->startProgram(&programCache);
+        neighborCompute->startCompute(&programCache);
+        ambientOccCompute->startCompute(&programCache);
+        compactCompute->startCompute(&programCache);
+        if (Craft::GPU_TERRAIN) terrainCompute->startCompute(&programCache);
+        if (!program->finishProgram())
         {
             std::cerr << "Failed to initialize program." << std::endl;
             return false;
         }
-        if (!worldProgram->initProgram())
+        if (!worldProgram->finishProgram())
         {
             std::cerr << "Failed to initialize world program." << std::endl;
             return false;
         }
-        if (!orthoProgram->initProgram())
+        if (!orthoProgram->finishProgram())
         {
             std::cerr << "Failed to initialize ortho program." << std::endl;
             return false;
         }
-        if (!sceneProgram->initProgram())
+        if (!sceneProgram->finishProgram())
         {
             std::cerr << "Failed to initialize scene program." << std::endl;
             return false;
         }
-        if (!neighborCompute->initCompute())
+        if (!neighborCompute->finishCompute())
         {
             std::cerr << "Failed to initialize neighbors compute." << std::endl;
             return false;
         }
-        if (!ambientOccCompute->initCompute())
+        if (!ambientOccCompute->finishCompute())
         {
             std::cerr << "Failed to initialize neighbors compute." << std::endl;
             return false;
         }
+        if (!compactCompute->finishCompute())
+        {
+            std::cerr << "Failed to initialize compaction compute." << std::endl;
+            return false;
+        }
+        // The world falls back to generating terrain on the CPU without it.
+        if (Craft::GPU_TERRAIN && !terrainCompute->finishCompute())
+        {
+            std::cerr << "Failed to initialize terrain compute." << std::endl;
+        }
 
         // Initialize the ProjT.
         projMatrix = glm::perspective(glm::radians(80.0f), ((float) WINDOW_WIDTH /  (float) WINDOW_HEIGHT), 0.1f, 4000.0f);
 //        glfwSwapInterval(0);
+        // Benchmark frames must not wait on vsync.
+        if (!options.benchmarkPath.empty()) glfwSwapInterval(0);
 
-        program->useProgram();
-        setMat4(program->getProgram(), "u_projT", projMatrix);
-
-        worldProgram->useProgram();
-        setMat4(worldProgram->getProgram(), "u_projT", projMatrix);
+        frameUniforms->initBuffer();
+        gpuProfiler->initProfiler();
+        frameUniforms->setProjection(projMatrix);
 
         initFBO();
         initQuad();
         world->initWorld();
         crossHair->initCrossHair();
+        // The overlay is not drawn while benchmarking so it does not skew the frame times.
+        if (options.benchmarkPath.empty() && !overlay->initOverlay())
+        {
+            std::cerr << "Failed to initialize the performance overlay." << std::endl;
+            return false;
+        }
 
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         return true;
@@ -165,38 +222,82 @@ namespace Engine
     }
     void Application::drawHUD()
     {
+        gpuProfiler->beginPass(CROSSHAIR_PASS);
         crossHair->drawCrossHair(frameTexture);
+        gpuProfiler->endPass();
+        overlay->drawOverlay();
     }
     void Application::drawQuad()
     {
+        gpuProfiler->beginPass(QUAD_PASS);
         sceneProgram->useProgram();
         glActiveTexture(GL_TEXTURE0);
-        glUniform1i(glGetUniformLocation(sceneProgram->getProgram(), "screenTexture"), 0);
         glBindTexture(GL_TEXTURE_2D, frameTexture);
         glBindVertexArray(quadVAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
         glBindVertexArray(0);
+        gpuProfiler->endPass();
+    }
+    void Application::renderFrame()
+    {
+        beginMemoryFrame();
+        gpuProfiler->beginFrame();
+        // draw to the frame buffer.
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        updateScene();
+        // Camera matrices, light level and time are final for this frame.
+        frameUniforms->upload();
+        drawScene();
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // Draw the frame buffer to screen and use it for hud drawing.
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Draw the quad of the frame that was generated from the drawScene function.
+        drawQuad();
+        // Draw the crossHair last as it uses special proj and view matrices.
+        drawHUD();
+        glfwSwapBuffers(window.getWindow());
+        // Poll for mouse and keyboard events
+        glfwPollEvents();
+    }
+    void Application::runBenchmark()
+    {
+        std::cout << "Benchmarking " << benchmark.getNumFrames() << " frames..." << std::endl;
+        // Reset the statistics gathered while loading the spawn area.
+        world->stats = Craft::WorldStats{};
+        gpuProfiler->resetTotals();
+        MemoryStats startMemory = getMemoryStats();
+        for (int frame=0; frame<benchmark.getNumFrames(); frame++)
+        {
+            auto frameStart = std::chrono::steady_clock::now();
+            input.beginTick();
+            BenchmarkPose pose = benchmark.getPose(frame);
+            world->player.setPose(pose.position, pose.yaw, pose.pitch);
+            renderFrame();
+            // Include the GPU's work in the frame time.
+            glFinish();
+            benchmark.recordFrame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        }
+        benchmark.report(world->stats, *gpuProfiler, startMemory);
     }
     void Application::run()
     {
+        if (!options.benchmarkPath.empty())
+        {
+            runBenchmark();
+            return;
+        }
         std::cout << "Running..." << std::endl;
         while (!window.shouldClose())
         {
-            // draw to the frame buffer.
-            glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            updateScene();
-            drawScene();
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            // Draw the frame buffer to screen and use it for hud drawing.
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            // Draw the quad of the frame that was generated from the drawScene function.
-            drawQuad();
-            // Draw the crossHair last as it uses special proj and view matrices.
-            drawHUD();
-            glfwSwapBuffers(window.getWindow());
-            // Poll for mouse and keyboard events
-            glfwPollEvents();
+            input.beginTick();
+            if (input.isReplayFinished()) break;
+            renderFrame();
+            if (ASSERT_STEADY_STATE_ALLOCATIONS && world->isSteadyState())
+            {
+                assert(getAllocationsThisFrame() == 0 && "A steady-state frame allocated heap memory.");
+            }
         }
+        input.saveRecording();
     }
 }
\ No newline at end of file
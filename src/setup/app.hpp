@@ -5,6 +5,11 @@
 #include "program.hpp"
 #include "camera.hpp"
 #include "compute.hpp"
+#include "programCache.hpp"
+#include "frameUniforms.hpp"
+#include "input.hpp"
+#include "benchmark.hpp"
+#include "overlay.hpp"
 #include "../craft/entities/player.hpp"
 #include "../craft/worldGeneration/chunk.hpp"
 #include "../craft/misc/textures.hpp"
@@ -13,10 +18,24 @@
 
 namespace Engine
 {
+    /// The command line options of the application.
+    struct ApplicationOptions
+    {
+        /// Whether input is read live, recorded or replayed.
+        InputMode inputMode{InputMode::LIVE};
+        /// The input recording to write or replay.
+        std::string inputPath{};
+        /// The benchmark script to fly through offscreen, empty to play normally.
+        std::string benchmarkPath{};
+        /// The noise kernel the world's terrain is generated with.
+        Craft::NoiseBackend noiseBackend{Craft::NoiseBackend::PERLIN};
+        /// The directory of the regions written by chunkcraft-pregen, empty to generate every chunk.
+        std::string regionPath{};
+    };
     class Application
     {
     public:
-        Application();
+        explicit Application(ApplicationOptions options = {});
         ~Application();
         /**
          * Initialize the Applications GLFW window, OpenGL Program, Buffers, and Camera.
@@ -31,8 +50,16 @@ namespace Engine
          */
         void run();
     private:
+        /// The command line options of the application.
+        ApplicationOptions options;
         /// The Window object of the application.
         Window window;
+        /// The keyboard and mouse input, sampled once per frame.
+        Input input;
+        /// The scripted flythrough, used when benchmarking.
+        Benchmark benchmark;
+        /// The on-disk cache of linked program binaries.
+        ProgramCache programCache;
         /// The Program for blocks within the application
         Program* program;
         /// The program for generic models within the application.
@@ -43,12 +70,22 @@ namespace Engine
         Compute* neighborCompute;
         /// The program for our neighbor compute
         Compute* ambientOccCompute;
+        /// The program compacting visible faces into the instance lists and draw commands.
+        Compute* compactCompute;
+        /// The program generating terrain on the GPU, only initialized when GPU_TERRAIN is set.
+        Compute* terrainCompute;
         /// The program for rendering the scenes quad to the screen.
         Program* sceneProgram;
+        /// The uniform buffer holding the camera matrices, light level and time.
+        FrameUniforms* frameUniforms;
+        /// Times the render and compute passes on the GPU.
+        GpuProfiler* gpuProfiler;
         /// The player world.
         Craft::World* world;
         /// The game crossHair.
         Craft::CrossHair* crossHair;
+        /// The performance overlay, toggled with OVERLAY_TOGGLE_KEY.
+        Overlay* overlay;
 
         std::vector<float> quadVertices = {
                 1.0f,  1.0f, 1.0f, 1.0f,
@@ -69,6 +106,10 @@ namespace Engine
         void drawScene();
         void drawHUD();
         void drawQuad();
+        /// Update the world and render a single frame to the window.
+        void renderFrame();
+        /// Fly through the benchmark script, rendering a fixed number of frames, then report the timings.
+        void runBenchmark();
     };
 }
 
@@ -0,0 +1,153 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <iomanip>
+#include "nlohmann/json.hpp"
+
+#include "benchmark.hpp"
+
+using json = nlohmann::json;
+
+namespace Engine
+{
+    /// The upper bounds in milliseconds of the frame time histogram's buckets, the last bucket is unbounded.
+    static const double HISTOGRAM_BOUNDS[] = {4.0, 8.0, 16.7, 33.3, 50.0, 100.0};
+
+    bool Benchmark::loadScript(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open benchmark script: " << path << std::endl;
+            return false;
+        }
+        json script = json::parse(file, nullptr, false);
+        if (script.is_discarded() || !script.contains("points") || !script["points"].is_array())
+        {
+            std::cerr << "Invalid benchmark script: " << path << std::endl;
+            return false;
+        }
+        numFrames = std::max(1, script.value("frames", numFrames));
+        for (const auto& point: script["points"])
+        {
+            if (!point.is_array() || point.size() != 3)
+            {
+                std::cerr << "Benchmark points must be [x, y, z] arrays: " << path << std::endl;
+                return false;
+            }
+            points.emplace_back(point[0].get<float>(), point[1].get<float>(), point[2].get<float>());
+        }
+        if (points.size() < 2)
+        {
+            std::cerr << "A benchmark script needs at least two points: " << path << std::endl;
+            return false;
+        }
+        frameTimes.reserve(numFrames);
+        return true;
+    }
+    glm::vec3 Benchmark::evaluateSpline(float t) const
+    {
+        int last = (int) points.size() - 1;
+        int segment = std::clamp((int) t, 0, last - 1);
+        float u = t - (float) segment;
+        // The end points are repeated so the spline passes through every point.
+        const glm::vec3& p0 = points[std::max(segment - 1, 0)];
+        const glm::vec3& p1 = points[segment];
+        const glm::vec3& p2 = points[segment + 1];
+        const glm::vec3& p3 = points[std::min(segment + 2, last)];
+        float u2 = u * u;
+        float u3 = u2 * u;
+        return 0.5f * (
+            (2.0f * p1) +
+            (-p0 + p2) * u +
+            (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+            (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * u3
+        );
+    }
+    BenchmarkPose Benchmark::getPose(int frame) const
+    {
+        float span = (float) (points.size() - 1);
+        float t = numFrames > 1 ? span * (float) frame / (float) (numFrames - 1) : 0.0f;
+        BenchmarkPose pose{};
+        pose.position = evaluateSpline(t);
+        // Look along the direction of travel.
+        float lookT = std::min(t + 0.01f, span);
+        glm::vec3 direction = evaluateSpline(lookT) - evaluateSpline(lookT - 0.01f);
+        if (glm::length(direction) > 0.0f)
+        {
+            direction = glm::normalize(direction);
+            pose.yaw = glm::degrees(atan2f(direction.z, direction.x));
+            pose.pitch = std::clamp(glm::degrees(asinf(direction.y)), -89.0f, 89.0f);
+        }
+        return pose;
+    }
+    void Benchmark::recordFrame(double frameMillis)
+    {
+        frameTimes.push_back(frameMillis);
+    }
+    void Benchmark::report(const Craft::WorldStats& stats, const GpuProfiler& gpuProfiler, const MemoryStats& startMemory) const
+    {
+        if (frameTimes.empty()) return;
+        std::vector<double> sorted = frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](double p)
+        {
+            auto idx = (size_t) std::min((double) sorted.size() - 1, p / 100.0 * (double) sorted.size());
+            return sorted[idx];
+        };
+        double total = 0.0;
+        for (double frameTime: sorted)
+        {
+            total += frameTime;
+        }
+        auto numFramesRendered = (double) sorted.size();
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Benchmark: " << sorted.size() << " frames in " << total / 1000.0 << " s" << std::endl;
+        std::cout << "Frame time (ms): avg " << total / numFramesRendered
+                  << ", p50 " << percentile(50.0)
+                  << ", p90 " << percentile(90.0)
+                  << ", p99 " << percentile(99.0)
+                  << ", max " << sorted.back() << std::endl;
+        std::cout << "Frame time histogram:" << std::endl;
+        size_t bucketStart = 0;
+        double lowerBound = 0.0;
+        for (double upperBound: HISTOGRAM_BOUNDS)
+        {
+            auto bucketEnd = (size_t) (std::lower_bound(sorted.begin(), sorted.end(), upperBound) - sorted.begin());
+            std::cout << "  [" << lowerBound << ", " << upperBound << ") ms: " << bucketEnd - bucketStart << std::endl;
+            bucketStart = bucketEnd;
+            lowerBound = upperBound;
+        }
+        std::cout << "  [" << lowerBound << ", inf) ms: " << sorted.size() - bucketStart << std::endl;
+        std::cout << "Chunks streamed: " << stats.chunksStreamed << std::endl;
+        std::cout << "Instances drawn: " << stats.instancesDrawn
+                  << " (" << (double) stats.instancesDrawn / numFramesRendered << " per frame)" << std::endl;
+        std::cout << "World phases (ms per frame):" << std::endl;
+        for (int phase=0; phase<Craft::NUM_WORLD_PHASES; phase++)
+        {
+            std::cout << "  " << Craft::WORLD_PHASE_NAMES[phase] << ": " << stats.phaseMillis[phase] / numFramesRendered << std::endl;
+        }
+        if (gpuProfiler.getFramesCollected() > 0)
+        {
+            auto framesCollected = (double) gpuProfiler.getFramesCollected();
+            std::cout << "GPU passes (ms per frame, " << gpuProfiler.getFramesCollected() << " frames collected, "
+                      << gpuProfiler.getFramesDropped() << " dropped):" << std::endl;
+            for (int pass=0; pass<NUM_GPU_PASSES; pass++)
+            {
+                std::cout << "  " << GPU_PASS_NAMES[pass] << ": " << gpuProfiler.getTotalMillis((GpuPass) pass) / framesCollected << std::endl;
+            }
+        }
+        MemoryStats endMemory = getMemoryStats();
+        std::cout << "Memory (live MiB, mapped MiB, allocations per frame):" << std::endl;
+        for (int tag=0; tag<NUM_MEMORY_TAGS; tag++)
+        {
+            std::cout << "  " << MEMORY_TAG_NAMES[tag] << ": "
+                      << (double) endMemory.liveBytes[tag] / (1024.0 * 1024.0) << ", "
+                      << (double) endMemory.externalBytes[tag] / (1024.0 * 1024.0) << ", "
+                      << (double) (endMemory.totalAllocations[tag] - startMemory.totalAllocations[tag]) / numFramesRendered
+                      << std::endl;
+        }
+        std::cout << std::defaultfloat;
+    }
+}
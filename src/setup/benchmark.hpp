@@ -0,0 +1,86 @@
+#ifndef OPENGLDEMO_BENCHMARK_HPP
+#define OPENGLDEMO_BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "gpuProfiler.hpp"
+#include "../helpers/memoryTracker.hpp"
+#include "../craft/worldGeneration/world.hpp"
+
+namespace Engine
+{
+    /// The pose of the camera for a single benchmark frame.
+    struct BenchmarkPose
+    {
+        /// The world position of the player's eyes.
+        glm::vec3 position{0.0f};
+        /// The angle in degrees of the camera for looking left and right.
+        float yaw{0.0f};
+        /// The angle in degrees of the camera for looking up and down.
+        float pitch{0.0f};
+    };
+
+    /**
+     * A scripted flythrough used to regression test rendering and streaming performance.
+     *
+     * The script is a JSON file holding the number of frames to render and the control points of a Catmull-Rom
+     * spline the camera flies along, looking in the direction of travel:
+     *
+     *     { "frames": 1000, "points": [[8, 120, 8], [200, 140, 40], [400, 120, -100]] }
+     */
+    class Benchmark
+    {
+    public:
+        Benchmark() = default;
+        ~Benchmark() = default;
+        /**
+         * Load a benchmark script.
+         *
+         * @param path: The path of the script.
+         * @return:     True if the script was loaded, else false.
+         */
+        bool loadScript(const std::string& path);
+        /// Retrieve the number of frames to render.
+        [[nodiscard]] inline int getNumFrames() const { return numFrames; }
+        /**
+         * Retrieve the camera pose of a frame.
+         *
+         * @param frame: The index of the frame [0, getNumFrames()).
+         * @return:      The pose of the camera along the spline.
+         */
+        [[nodiscard]] BenchmarkPose getPose(int frame) const;
+        /**
+         * Record the duration of a frame.
+         *
+         * @param frameMillis: The wall time of the frame in milliseconds, including waiting on the GPU.
+         */
+        void recordFrame(double frameMillis);
+        /**
+         * Print the frame time percentiles and histogram, the world's streaming and phase statistics, the GPU time of
+         * every pass, and the memory of every subsystem.
+         *
+         * @param stats:       The statistics gathered by the world over the benchmark.
+         * @param gpuProfiler: The profiler timing the passes over the benchmark.
+         * @param startMemory: The memory of every subsystem when the benchmark started.
+         */
+        void report(const Craft::WorldStats& stats, const GpuProfiler& gpuProfiler, const MemoryStats& startMemory) const;
+    private:
+        /// The number of frames to render.
+        int numFrames{1000};
+        /// The control points of the camera spline.
+        std::vector<glm::vec3> points{};
+        /// The wall time of every rendered frame in milliseconds.
+        std::vector<double> frameTimes{};
+        /**
+         * Evaluate the camera spline.
+         *
+         * @param t: The position along the spline [0, points.size() - 1].
+         * @return:  The point of the spline at t.
+         */
+        [[nodiscard]] glm::vec3 evaluateSpline(float t) const;
+    };
+}
+
+#endif //OPENGLDEMO_BENCHMARK_HPP
@@ -9,46 +9,27 @@
 
 namespace Engine
 {
-    bool Camera::firstMouse = true;
-    float Camera::lastX = 0.0f;
-    float Camera::lastY = 0.0f;
-    float Camera::yaw = 180.0f;
-    float Camera::pitch = -20.0f;
-
     Camera::Camera(
             Window* window,
-            Engine::Program* program,
-            Engine::Program* worldProgram,
+            FrameUniforms* frameUniforms,
             uint32_t width,
             uint32_t height,
             float x, float y, float z
     )
         : window(window)
-        , program(program)
-        , worldProgram(worldProgram)
+        , frameUniforms(frameUniforms)
         , windowWidth(width)
         , windowHeight(height)
     {}
 
     bool Camera::initCamera()
     {
-        if (window == nullptr || program == nullptr)
+        if (window == nullptr || frameUniforms == nullptr)
         {
-            std::cerr << "Window or Program not initialized" << std::endl;
+            std::cerr << "Window or FrameUniforms not initialized" << std::endl;
             return false;
         }
-        // Will eventually clean up how I handle all the programs. But for now there are two, so I am not going to panic.
-        program->useProgram();
-        setMat4(program->getProgram(), "u_viewT", view);
-        worldProgram->useProgram();
-        setMat4(worldProgram->getProgram(), "u_viewT", view);
-
-        int width, height;
-        glfwGetWindowSize(window->getWindow(), &width, &height);
-        Camera::lastX = static_cast<float>(width) / 2.0f;
-        Camera::lastY = static_cast<float>(height) / 2.0f;
-        glfwSetWindowUserPointer(window->getWindow(), this);
-        glfwSetCursorPosCallback(window->getWindow(), mouse_movement_callback);
+        frameUniforms->setView(view);
 
         return true;
     }
@@ -56,62 +37,40 @@ namespace Engine
     {
 
         view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
-        program->useProgram();
-        if (!setMat4(program->getProgram(), "u_viewT", view)) {
-            return false;
-        }
+        frameUniforms->setView(view);
 
         // Compute camera normal based on X and Z axis
-        program->useProgram();
         glm::vec3 normFront = glm::normalize(glm::vec3(cameraFront.x, 0, cameraFront.z));
         bool lookingX = abs(normFront.x) > abs(normFront.z);
         int scalar = lookingX ? (normFront.x < 0 ? -1 : 1) : (normFront.z < 0 ? -1 : 1);
         glm::vec3 cameraNormal = glm::vec3{(lookingX ? scalar : 0), 0, (!lookingX ? scalar : 0)};
-//        setVec3(program->getProgram(), "u_CameraNorm", cameraNormal);
-
-        worldProgram->useProgram();
-        if (!setMat4(worldProgram->getProgram(), "u_viewT", view)) {
-            return false;
-        }
         return true;
     }
 
-    void Camera::mouse_movement_callback(GLFWwindow* window, double xPos, double yPos)
+    void Camera::applyMouseDelta(float xOffset, float yOffset)
     {
-        auto userPointerData = static_cast<Craft::GLFWUserPointer*>(glfwGetWindowUserPointer(window));
-        Camera* camera = userPointerData->camera;
-        if (Camera::firstMouse)
-        {
-            Camera::lastX = static_cast<float>(xPos);
-            Camera::lastY = static_cast<float>(yPos);
-            Camera::firstMouse = false;
-        }
-
-        float xoffset = static_cast<float>(xPos) - Camera::lastX;
-        float yoffset = Camera::lastY - static_cast<float>(yPos);
-        Camera::lastX = static_cast<float>(xPos);
-        Camera::lastY = static_cast<float>(yPos);
-
-        xoffset *= camera->sensitivity;
-        yoffset *= camera->sensitivity;
-
-        Camera::yaw += xoffset;
-        Camera::pitch += yoffset;
+        if (xOffset == 0.0f && yOffset == 0.0f) return;
+        setOrientation(yaw + (xOffset * sensitivity), pitch + (yOffset * sensitivity));
+    }
+    void Camera::setOrientation(float newYaw, float newPitch)
+    {
+        yaw = newYaw;
+        pitch = newPitch;
 
-        if (Camera::pitch > 89.0f)
+        if (pitch > 89.0f)
         {
-            Camera::pitch = 89.0f;
+            pitch = 89.0f;
         }
-        if (Camera::pitch < -89.0f)
+        if (pitch < -89.0f)
         {
-            Camera::pitch = -89.0f;
+            pitch = -89.0f;
         }
 
         glm::vec3 direction;
-        direction.x = cos(glm::radians(Camera::yaw)) * cos(glm::radians(Camera::pitch));
-        direction.y = sin(glm::radians(Camera::pitch));
-        direction.z = sin(glm::radians(Camera::yaw)) * cos(glm::radians(Camera::pitch));
-        camera->cameraFront = glm::normalize(direction);
+        direction.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
+        direction.y = sin(glm::radians(pitch));
+        direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
+        cameraFront = glm::normalize(direction);
     }
 
     glm::vec3 Camera::getCameraFront()
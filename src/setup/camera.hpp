@@ -6,7 +6,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "./window.hpp"
-#include "./program.hpp"
+#include "./frameUniforms.hpp"
 
 namespace Engine
 {
@@ -16,9 +16,8 @@ namespace Engine
         /**
          * Instantiate a Camera object that will handle to View Matrix for shaders.
          *
-         * @param window:  A pointer to the Window object.
-         * @param program: A pointer to the Program object.
-         * @param worldProgram: A pointer to the Program object.
+         * @param window:        A pointer to the Window object.
+         * @param frameUniforms: A pointer to the per-frame uniforms the view matrix is written to.
          * @param width:        The width of the window.
          * @param height:       The height of the window.
          * @param x:            The x position of the player.
@@ -27,8 +26,7 @@ namespace Engine
          */
         Camera(
             Window* window,
-            Program* program,
-            Program* worldProgram,
+            FrameUniforms* frameUniforms,
             uint32_t width,
             uint32_t height,
             float x, float y, float z
@@ -53,22 +51,26 @@ namespace Engine
          */
         bool updateCamera(glm::vec3 cameraPos, glm::vec3 cameraUp);
         /**
-         * Callback for handling mouse movement for looking around.
+         * Turn the camera by the mouse movement of a tick.
          *
-         * @param window: A pointer to the GLFW window.
-         * @param xPos:   The current X position of the mouse.
-         * @param yPos:   The current Y position of the mouse.
+         * @param xOffset: The horizontal mouse movement.
+         * @param yOffset: The vertical mouse movement, positive when moving up.
          */
-        static void mouse_movement_callback(GLFWwindow* window, double xPos, double yPos);
+        void applyMouseDelta(float xOffset, float yOffset);
+        /**
+         * Point the camera in a given direction.
+         *
+         * @param newYaw:   The angle in degrees for looking left and right.
+         * @param newPitch: The angle in degrees for looking up and down, clamped to [-89, 89].
+         */
+        void setOrientation(float newYaw, float newPitch);
 
         glm::vec3 getCameraFront();
     private:
         /// A pointer to a window object.
         Window* window;
-        /// A pointer to a program object for block rendering.
-        Program* program;
-        /// A pointer to a program object for generic rendering.
-        Program* worldProgram;
+        /// A pointer to the per-frame uniforms shared by the block and world programs.
+        FrameUniforms* frameUniforms;
         /// The sensitivity of the camera.
         float sensitivity{0.075f};
         /// The height and width of the current window.
@@ -78,16 +80,10 @@ namespace Engine
         glm::vec3 cameraFront{glm::vec3(-1.0f, -0.35f, 0.0f)};
         /// The 4x4 matrix describing the View transformation.
         glm::mat4 view{};//{glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp)};
-        /// A Boolean that acts as a buffer for initial calls to mouse_movement_callback.
-        static bool firstMouse;
-        /// The previous X value of the mouse.
-        static float lastX;
-        /// The previous Y value of the mouse.
-        static float lastY;
         /// The current angle in degrees of the camera for looking left and right.
-        static float yaw;
+        float yaw{180.0f};
         /// The current angle in degrees of the camera for looking up and down.
-        static float pitch;
+        float pitch{-20.0f};
     };
 }
 
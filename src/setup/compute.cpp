@@ -24,52 +24,80 @@ namespace Engine
     {
         glUseProgram(program);
     }
-    bool Compute::genCompute(const std::string& shaderPath)
+    void Compute::genCompute(const std::string& shaderPath, const std::string& shaderSource)
     {
-        std::string shaderSource = getFileContents(shaderPath.c_str());
         if (shaderSource.empty())
         {
             std::cerr << "Shader contains no content: " << shaderPath << std::endl;
         }
         const char* shaderSrc = shaderSource.c_str();
-        int success;
-        char infoLog[512];
 
         std::cout << "Generating Compute Shader: " << shaderPath << std::endl;
         compShader = glCreateShader(GL_COMPUTE_SHADER);
         glShaderSource(compShader, 1, &shaderSrc, nullptr);
         glCompileShader(compShader);
-        glGetShaderiv(compShader, GL_COMPILE_STATUS, &success);
-        if(!success)
-        {
-            glGetShaderInfoLog(compShader, 512, nullptr, infoLog);
-            std::string msg = "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n";
-            std::cerr << msg << infoLog << std::endl;
-            return false;
-        }
-        return true;
     }
 
-    bool Compute::initCompute()
+    bool Compute::initCompute(ProgramCache* cache)
+    {
+        return startCompute(cache) && finishCompute();
+    }
+    bool Compute::startCompute(ProgramCache* cache)
     {
         program = glCreateProgram();
+        std::string shaderSource = getFileContents(computeShaderName.c_str());
 
+        programCache = cache != nullptr && cache->isEnabled() ? cache : nullptr;
+        if (programCache != nullptr)
+        {
+            cacheKey = programCache->hashSources({shaderSource});
+            loadedFromCache = programCache->loadProgram(program, cacheKey);
+            if (loadedFromCache)
+            {
+                std::cout << "Loaded cached compute program: " << computeShaderName << std::endl;
+                return true;
+            }
+        }
 
-        int success;
-        char infoLog[512];
-        if (!genCompute(computeShaderName)) return false;
+        genCompute(computeShaderName, shaderSource);
         glAttachShader(program, compShader);
+        if (programCache != nullptr)
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
         glLinkProgram(program);
-
-        glGetProgramiv(program, GL_LINK_STATUS, &success);
-        if(!success)
+        return true;
+    }
+    bool Compute::finishCompute()
+    {
+        if (!loadedFromCache)
         {
-            std::cerr << "OpenGL Error: " << glGetError() << std::endl;
-            std::cerr << "Failed to link the program." << std::endl;
-            glGetProgramInfoLog(program, 512, nullptr, infoLog);
-            std::cerr << "Link info: " << infoLog << std::endl;
-            return false;
+            int success;
+            char infoLog[512];
+            glGetShaderiv(compShader, GL_COMPILE_STATUS, &success);
+            if(!success)
+            {
+                glGetShaderInfoLog(compShader, 512, nullptr, infoLog);
+                std::string msg = "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n";
+                std::cerr << msg << infoLog << std::endl;
+                return false;
+            }
+
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if(!success)
+            {
+                std::cerr << "OpenGL Error: " << glGetError() << std::endl;
+                std::cerr << "Failed to link the program." << std::endl;
+                glGetProgramInfoLog(program, 512, nullptr, infoLog);
+                std::cerr << "Link info: " << infoLog << std::endl;
+                return false;
+            }
+            if (programCache != nullptr)
+            {
+                programCache->storeProgram(program, cacheKey);
+            }
         }
+        uniformLocations = reflectUniforms(program);
         glUseProgram(program);
         return true;
     }
@@ -8,6 +8,9 @@
 #include <string>
 #include <unordered_map>
 
+#include "uniform.hpp"
+#include "programCache.hpp"
+
 namespace Engine
 {
     class Compute
@@ -30,9 +33,40 @@ namespace Engine
          *
          * Creates an OpenGL program, compiles and attaches the specified compute shader, and finally link the program.
          *
+         * @param cache: The program binary cache, or nullptr to always compile from source.
+         * @return:      True if the program was initialized, else False.
+         */
+        bool initCompute(ProgramCache* cache = nullptr);
+        /**
+         * Begin initializing the compute program.
+         *
+         * Loads the program from the cache if possible, else submits the shader for compilation and the program for
+         * linking without waiting on the result.
+         *
+         * @param cache: The program binary cache, or nullptr to always compile from source.
+         * @return:      True if the program was started, else False.
+         */
+        bool startCompute(ProgramCache* cache = nullptr);
+        /**
+         * Finish initializing the compute program started by startCompute.
+         *
          * @return: True if the program was initialized, else False.
          */
-        bool initCompute();
+        bool finishCompute();
+        /**
+         * Retrieve a typed handle to one of the compute program's active uniforms.
+         *
+         * Uniforms are reflected once after linking, so this does not query OpenGL.
+         *
+         * @tparam T:   The CPU side type of the uniform.
+         * @param name: The name of the uniform within the shader.
+         * @return:     The handle, invalid if the uniform is not active.
+         */
+        template<typename T>
+        [[nodiscard]] Uniform<T> getUniform(const std::string& name) const
+        {
+            return findUniform<T>(program, uniformLocations, name);
+        }
     private:
         /// The path of the fragment shader.
         std::string computeShaderName;
@@ -40,15 +74,21 @@ namespace Engine
         GLint compShader{0};
         /// The identifier of the OpenGL program.
         GLuint program{0};
+        /// A mapping of active uniform names to their locations, filled once after linking.
+        std::unordered_map<std::string, GLint> uniformLocations{};
+        /// The cache the program was started with, nullptr if not cached.
+        ProgramCache* programCache{nullptr};
+        /// The key of the program within the cache.
+        uint64_t cacheKey{0};
+        /// Whether the program was loaded from the cache rather than compiled.
+        bool loadedFromCache{false};
         /**
-         * Compile the shader code given a path.
-         *
-         * Read in shader code from file, compile it, then attach it to the program.
+         * Submit the compute shader for compilation.
          *
-         * @param shaderPath: The path to the shader.
-         * @return            true if successful else false.
+         * @param shaderPath:   The path to the shader.
+         * @param shaderSource: The contents of the shader.
          */
-        bool genCompute(const std::string& computePath);
+        void genCompute(const std::string& shaderPath, const std::string& shaderSource);
     };
 }
 #endif //OPENGLDEMO_COMPUTE_HPP
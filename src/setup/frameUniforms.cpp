@@ -0,0 +1,24 @@
+#include "frameUniforms.hpp"
+
+namespace Engine
+{
+    FrameUniforms::~FrameUniforms()
+    {
+        if (UBO != 0)
+        {
+            glDeleteBuffers(1, &UBO);
+        }
+    }
+    void FrameUniforms::initBuffer()
+    {
+        glGenBuffers(1, &UBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), &data, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, UBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    void FrameUniforms::upload()
+    {
+        glNamedBufferSubData(UBO, 0, sizeof(FrameUniformData), &data);
+    }
+}
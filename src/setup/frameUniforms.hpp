@@ -0,0 +1,62 @@
+#ifndef OPENGLDEMO_FRAMEUNIFORMS_HPP
+#define OPENGLDEMO_FRAMEUNIFORMS_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    /// The uniform buffer binding of the FrameUniforms block within the shaders.
+    const GLuint FRAME_UNIFORM_BINDING = 0;
+
+    /**
+     * The CPU side copy of the FrameUniforms block, laid out with std140 rules.
+     *
+     * Must be kept in sync with the FrameUniforms block in block.vert and default.vert.
+     */
+    struct FrameUniformData
+    {
+        /// The projection transformation.
+        glm::mat4 projT{1.0f};
+        /// The view transformation.
+        glm::mat4 viewT{1.0f};
+        /// The global light level of the world [0, 15].
+        float defaultLightLevel{15.0f};
+        /// The in-game time in hours.
+        float time{0.0f};
+        /// Padding to round the block up to a vec4 boundary.
+        float padding[2]{0.0f, 0.0f};
+    };
+    static_assert(sizeof(FrameUniformData) == 144, "FrameUniformData must match the std140 layout of FrameUniforms.");
+
+    /**
+     * A uniform buffer shared by every program that needs per-frame state (camera matrices, light level and time).
+     *
+     * Values are staged on the CPU throughout the frame and written to the GPU with a single upload.
+     */
+    class FrameUniforms
+    {
+    public:
+        FrameUniforms() = default;
+        ~FrameUniforms();
+        /// Create the uniform buffer and bind it to FRAME_UNIFORM_BINDING.
+        void initBuffer();
+        /// Stage the projection transformation.
+        inline void setProjection(const glm::mat4& projT) { data.projT = projT; }
+        /// Stage the view transformation.
+        inline void setView(const glm::mat4& viewT) { data.viewT = viewT; }
+        /// Stage the global light level.
+        inline void setLightLevel(float lightLevel) { data.defaultLightLevel = lightLevel; }
+        /// Stage the in-game time.
+        inline void setTime(float time) { data.time = time; }
+        /// Write the staged values to the uniform buffer. Should be called once per frame before drawing.
+        void upload();
+    private:
+        /// The identifier of the uniform buffer.
+        GLuint UBO{0};
+        /// The staged values.
+        FrameUniformData data{};
+    };
+}
+
+#endif //OPENGLDEMO_FRAMEUNIFORMS_HPP
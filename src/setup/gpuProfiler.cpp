@@ -0,0 +1,84 @@
+#include "gpuProfiler.hpp"
+
+namespace Engine
+{
+    GpuProfiler::~GpuProfiler()
+    {
+        if (!initialized) return;
+        for (auto& frame: frames)
+        {
+            glDeleteQueries(MAX_GPU_TIMESTAMPS, frame.queries);
+        }
+    }
+    void GpuProfiler::initProfiler()
+    {
+        for (auto& frame: frames)
+        {
+            glGenQueries(MAX_GPU_TIMESTAMPS, frame.queries);
+        }
+        initialized = true;
+    }
+    void GpuProfiler::collectFrame(FrameQueries& frame)
+    {
+        if (frame.numTimestamps == 0) return;
+        // Queries complete in order, so the whole set is available once its last timestamp is.
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(frame.queries[frame.numTimestamps - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            framesDropped++;
+            frame.numTimestamps = 0;
+            return;
+        }
+        for (double& passMillis: lastFrameMillis)
+        {
+            passMillis = 0.0;
+        }
+        for (int timestamp=0; timestamp<frame.numTimestamps; timestamp+=2)
+        {
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(frame.queries[timestamp], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(frame.queries[timestamp + 1], GL_QUERY_RESULT, &end);
+            lastFrameMillis[frame.passes[timestamp / 2]] += (double) (end - start) / 1000000.0;
+        }
+        for (int pass=0; pass<NUM_GPU_PASSES; pass++)
+        {
+            totalMillis[pass] += lastFrameMillis[pass];
+        }
+        framesCollected++;
+        frame.numTimestamps = 0;
+    }
+    void GpuProfiler::beginFrame()
+    {
+        if (!initialized) return;
+        frameIdx = (frameIdx + 1) % GPU_PROFILER_FRAMES;
+        collectFrame(frames[frameIdx]);
+    }
+    void GpuProfiler::beginPass(GpuPass pass)
+    {
+        passOpen = true;
+        FrameQueries& frame = frames[frameIdx];
+        // Passes past the frame's capacity are not timed.
+        passRecorded = initialized && frame.numTimestamps + 2 <= MAX_GPU_TIMESTAMPS;
+        if (!passRecorded) return;
+        frame.passes[frame.numTimestamps / 2] = pass;
+        glQueryCounter(frame.queries[frame.numTimestamps++], GL_TIMESTAMP);
+    }
+    void GpuProfiler::endPass()
+    {
+        if (!passOpen) return;
+        passOpen = false;
+        if (!passRecorded) return;
+        FrameQueries& frame = frames[frameIdx];
+        glQueryCounter(frame.queries[frame.numTimestamps++], GL_TIMESTAMP);
+    }
+    void GpuProfiler::resetTotals()
+    {
+        for (double& passMillis: totalMillis)
+        {
+            passMillis = 0.0;
+        }
+        framesCollected = 0;
+        framesDropped = 0;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef OPENGLDEMO_GPUPROFILER_HPP
+#define OPENGLDEMO_GPUPROFILER_HPP
+
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace Engine
+{
+    /// The render and compute passes timed on the GPU.
+    enum GpuPass
+    {
+        TERRAIN_PASS,
+        NEIGHBOR_PASS,
+        AMBIENT_PASS,
+        COMPACT_PASS,
+        WORLD_DRAW_PASS,
+        SUN_PASS,
+        QUAD_PASS,
+        CROSSHAIR_PASS,
+        NUM_GPU_PASSES
+    };
+    /// The names of the GPU passes, indexed by GpuPass.
+    constexpr const char* GPU_PASS_NAMES[NUM_GPU_PASSES] = {
+        "terrain dispatch", "neighbor dispatch", "ambient occlusion dispatch", "compaction dispatch", "world draw", "sun", "quad blit",
+        "crosshair"
+    };
+    /// The number of frames of queries in flight, results are read this many frames after they are recorded.
+    const int GPU_PROFILER_FRAMES = 2;
+    /// The number of timestamps a frame may record, two per timed pass.
+    const int MAX_GPU_TIMESTAMPS = 128;
+
+    /**
+     * Times passes on the GPU with a timestamp query (glQueryCounter) at the start and end of every pass.
+     *
+     * Timestamps are used instead of GL_TIME_ELAPSED so a pass may be timed several times within a frame. Each frame
+     * records into its own set of queries, and a set is only read back once the GPU has finished with it,
+     * GPU_PROFILER_FRAMES frames later, so reading the results never stalls the pipeline. A set that is still not
+     * available by then is dropped rather than waited on.
+     */
+    class GpuProfiler
+    {
+    public:
+        GpuProfiler() = default;
+        ~GpuProfiler();
+        /// Create the timestamp queries. Requires a current OpenGL context.
+        void initProfiler();
+        /// Start recording a frame, collecting the results of the frame that last used its queries.
+        void beginFrame();
+        /**
+         * Record the start of a pass. Passes must not overlap.
+         *
+         * @param pass: The pass starting.
+         */
+        void beginPass(GpuPass pass);
+        /// Record the end of the pass started by beginPass.
+        void endPass();
+        /// Retrieve the GPU time of a pass within the latest collected frame, in milliseconds.
+        [[nodiscard]] inline double getLastFrameMillis(GpuPass pass) const { return lastFrameMillis[pass]; }
+        /// Retrieve the GPU time of a pass summed over every collected frame, in milliseconds.
+        [[nodiscard]] inline double getTotalMillis(GpuPass pass) const { return totalMillis[pass]; }
+        /// Retrieve the number of frames whose results were collected.
+        [[nodiscard]] inline uint64_t getFramesCollected() const { return framesCollected; }
+        /// Retrieve the number of frames whose results were not available in time.
+        [[nodiscard]] inline uint64_t getFramesDropped() const { return framesDropped; }
+        /// Reset the totals and frame counts.
+        void resetTotals();
+    private:
+        /// The queries and passes recorded by a frame.
+        struct FrameQueries
+        {
+            /// The timestamp queries, a start and end pair per timed pass.
+            GLuint queries[MAX_GPU_TIMESTAMPS]{};
+            /// The pass of every pair of timestamps.
+            GpuPass passes[MAX_GPU_TIMESTAMPS / 2]{};
+            /// The number of timestamps recorded.
+            int numTimestamps{0};
+        };
+        /// Whether the queries were created.
+        bool initialized{false};
+        /// The query sets of the frames in flight.
+        FrameQueries frames[GPU_PROFILER_FRAMES]{};
+        /// The index of the query set of the current frame.
+        int frameIdx{0};
+        /// Whether a pass is started and not yet ended, and whether its start was recorded.
+        bool passOpen{false}, passRecorded{false};
+        /// The GPU time of every pass within the latest collected frame.
+        double lastFrameMillis[NUM_GPU_PASSES]{};
+        /// The GPU time of every pass summed over every collected frame.
+        double totalMillis[NUM_GPU_PASSES]{};
+        /// The number of frames whose results were collected.
+        uint64_t framesCollected{0};
+        /// The number of frames whose results were not available in time.
+        uint64_t framesDropped{0};
+        /**
+         * Read back the results of a query set if the GPU has finished with it.
+         *
+         * @param frame: The query set.
+         */
+        void collectFrame(FrameQueries& frame);
+    };
+}
+
+#endif //OPENGLDEMO_GPUPROFILER_HPP
@@ -0,0 +1,158 @@
+#include <fstream>
+#include <iostream>
+
+#include "input.hpp"
+#include "../craft/misc/types.hpp"
+
+namespace Engine
+{
+    /// A magic number marking the start of an input recording ("CCIR").
+    const uint32_t INPUT_RECORDING_MAGIC = 0x52494343;
+    /// The version of the recording layout. Bump whenever InputTick or InputRecordingHeader changes.
+    const uint32_t INPUT_RECORDING_VERSION = 1;
+
+    /// The header written before the ticks of a recording.
+    struct InputRecordingHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numTicks;
+        uint32_t reserved;
+    };
+
+    /// The GLFW key bound to every InputKey.
+    static const std::pair<InputKey, int> KEY_BINDINGS[] = {
+        {InputKey::FORWARD, GLFW_KEY_W},
+        {InputKey::BACKWARD, GLFW_KEY_S},
+        {InputKey::LEFT, GLFW_KEY_A},
+        {InputKey::RIGHT, GLFW_KEY_D},
+        {InputKey::TOGGLE_FLYING, GLFW_KEY_F},
+        {InputKey::JUMP, GLFW_KEY_SPACE},
+        {InputKey::DESCEND, GLFW_KEY_LEFT_SHIFT}
+    };
+
+    Input::Input(Window* window)
+        : window{window}
+    {}
+    bool Input::initInput(InputMode inputMode, const std::string& recordingPath)
+    {
+        mode = inputMode;
+        path = recordingPath;
+        if (mode == InputMode::REPLAY && !loadRecording())
+        {
+            return false;
+        }
+        glfwSetCursorPosCallback(window->getWindow(), mouse_movement_callback);
+        glfwSetMouseButtonCallback(window->getWindow(), mouse_button_callback);
+        lastTickTime = std::chrono::steady_clock::now();
+        return true;
+    }
+    void Input::beginTick()
+    {
+        auto currTime = std::chrono::steady_clock::now();
+        float tickMillis = std::chrono::duration<float, std::milli>(currTime - lastTickTime).count();
+        lastTickTime = currTime;
+        if (mode == InputMode::REPLAY)
+        {
+            // Step one past the end so isReplayFinished reports once the last tick has been played.
+            currentTick = replayIdx < ticks.size() ? ticks[replayIdx] : InputTick{};
+            replayIdx++;
+            return;
+        }
+        if (mode == InputMode::SCRIPTED)
+        {
+            currentTick = InputTick{};
+            currentTick.tickMillis = tickMillis;
+            return;
+        }
+        currentTick = pendingTick;
+        currentTick.tickMillis = tickMillis;
+        for (const auto& binding: KEY_BINDINGS)
+        {
+            if (glfwGetKey(window->getWindow(), binding.second) == GLFW_PRESS)
+            {
+                currentTick.keys |= (uint16_t) binding.first;
+            }
+        }
+        pendingTick = InputTick{};
+        if (mode == InputMode::RECORD)
+        {
+            ticks.push_back(currentTick);
+        }
+    }
+    bool Input::loadRecording()
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open input recording: " << path << std::endl;
+            return false;
+        }
+        InputRecordingHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != INPUT_RECORDING_MAGIC || header.version != INPUT_RECORDING_VERSION)
+        {
+            std::cerr << "Invalid input recording: " << path << std::endl;
+            return false;
+        }
+        ticks.resize(header.numTicks);
+        file.read(reinterpret_cast<char*>(ticks.data()), (std::streamsize) (ticks.size() * sizeof(InputTick)));
+        if (!file)
+        {
+            std::cerr << "Input recording is truncated: " << path << std::endl;
+            return false;
+        }
+        std::cout << "Replaying " << ticks.size() << " ticks from " << path << std::endl;
+        return true;
+    }
+    bool Input::saveRecording()
+    {
+        if (mode != InputMode::RECORD) return true;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to write input recording: " << path << std::endl;
+            return false;
+        }
+        InputRecordingHeader header{INPUT_RECORDING_MAGIC, INPUT_RECORDING_VERSION, (uint32_t) ticks.size(), 0};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(ticks.data()), (std::streamsize) (ticks.size() * sizeof(InputTick)));
+        if (!file)
+        {
+            std::cerr << "Failed to write input recording: " << path << std::endl;
+            return false;
+        }
+        std::cout << "Recorded " << ticks.size() << " ticks to " << path << std::endl;
+        return true;
+    }
+    void Input::mouse_movement_callback(GLFWwindow* window, double xPos, double yPos)
+    {
+        auto userPointerData = static_cast<Craft::GLFWUserPointer*>(glfwGetWindowUserPointer(window));
+        if (userPointerData == nullptr || userPointerData->input == nullptr) return;
+        Input* input = userPointerData->input;
+        if (input->firstMouse)
+        {
+            input->lastX = xPos;
+            input->lastY = yPos;
+            input->firstMouse = false;
+        }
+        input->pendingTick.mouseDeltaX += static_cast<float>(xPos - input->lastX);
+        input->pendingTick.mouseDeltaY += static_cast<float>(input->lastY - yPos);
+        input->lastX = xPos;
+        input->lastY = yPos;
+    }
+    void Input::mouse_button_callback(GLFWwindow* window, int button, int action, int /*mods*/)
+    {
+        auto userPointerData = static_cast<Craft::GLFWUserPointer*>(glfwGetWindowUserPointer(window));
+        if (userPointerData == nullptr || userPointerData->input == nullptr || action != GLFW_PRESS) return;
+        Input* input = userPointerData->input;
+        if (button == GLFW_MOUSE_BUTTON_LEFT)
+        {
+            input->pendingTick.clicks |= (uint8_t) InputButton::LEFT;
+        }
+        else if (button == GLFW_MOUSE_BUTTON_RIGHT)
+        {
+            input->pendingTick.clicks |= (uint8_t) InputButton::RIGHT;
+        }
+    }
+}
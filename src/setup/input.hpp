@@ -0,0 +1,141 @@
+#ifndef OPENGLDEMO_INPUT_HPP
+#define OPENGLDEMO_INPUT_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "./window.hpp"
+
+namespace Engine
+{
+    /// The keys read by the game, one bit each within InputTick::keys.
+    enum class InputKey : uint16_t
+    {
+        FORWARD = 1 << 0,
+        BACKWARD = 1 << 1,
+        LEFT = 1 << 2,
+        RIGHT = 1 << 3,
+        TOGGLE_FLYING = 1 << 4,
+        JUMP = 1 << 5,
+        DESCEND = 1 << 6
+    };
+    /// The mouse buttons read by the game, one bit each within InputTick::clicks.
+    enum class InputButton : uint8_t
+    {
+        LEFT = 1 << 0,
+        RIGHT = 1 << 1
+    };
+    /// Where the input of every tick comes from.
+    enum class InputMode
+    {
+        /// Read from GLFW.
+        LIVE,
+        /// Read from GLFW and written to a recording on exit.
+        RECORD,
+        /// Read from a recording, ignoring GLFW.
+        REPLAY,
+        /// Empty, ignoring GLFW, while the game is driven by a script such as the benchmark.
+        SCRIPTED
+    };
+
+    /// The input of a single tick, as stored within recordings.
+    struct InputTick
+    {
+        /// The InputKeys held during the tick.
+        uint16_t keys{0};
+        /// The InputButtons pressed during the tick.
+        uint8_t clicks{0};
+        uint8_t padding{0};
+        /// The mouse movement during the tick, in screen coordinates.
+        float mouseDeltaX{0.0f};
+        float mouseDeltaY{0.0f};
+        /// The duration of the tick in milliseconds.
+        float tickMillis{0.0f};
+    };
+    static_assert(sizeof(InputTick) == 16, "InputTick is written to recordings as is.");
+
+    /**
+     * The keyboard and mouse input of the game, sampled once per tick.
+     *
+     * The game only reads the input of the current tick, so a session can be recorded (keys held, mouse movement,
+     * clicks and the tick duration) and replayed to rerun the exact same path through the world.
+     */
+    class Input
+    {
+    public:
+        explicit Input(Window* window);
+        ~Input() = default;
+        /**
+         * Install the input callbacks, loading the recording when replaying.
+         *
+         * The window's user pointer must be a Craft::GLFWUserPointer pointing to this object before events are polled.
+         *
+         * @param mode: Where the input of every tick comes from.
+         * @param path: The recording to write or replay, unused when live.
+         * @return:     True if the input was initialized, else false.
+         */
+        bool initInput(InputMode mode, const std::string& path);
+        /// Start a new tick, sampling the input the game reads until the next tick.
+        void beginTick();
+        /**
+         * Write the recorded ticks to disk. Does nothing unless recording.
+         *
+         * @return: True if the recording was written, else false.
+         */
+        bool saveRecording();
+        /// Retrieve whether a key is held during the current tick.
+        [[nodiscard]] inline bool isKeyDown(InputKey key) const { return (currentTick.keys & (uint16_t) key) != 0; }
+        /// Retrieve whether a mouse button was pressed during the current tick.
+        [[nodiscard]] inline bool wasPressed(InputButton button) const { return (currentTick.clicks & (uint8_t) button) != 0; }
+        /// Retrieve the mouse movement of the current tick, y pointing up.
+        [[nodiscard]] inline glm::vec2 getMouseDelta() const { return {currentTick.mouseDeltaX, currentTick.mouseDeltaY}; }
+        /// Retrieve whether no key is held, no button pressed and the mouse did not move during the current tick.
+        [[nodiscard]] inline bool isIdle() const
+        {
+            return currentTick.keys == 0 && currentTick.clicks == 0 &&
+                   currentTick.mouseDeltaX == 0.0f && currentTick.mouseDeltaY == 0.0f;
+        }
+        /// Retrieve the duration of the current tick in milliseconds.
+        [[nodiscard]] inline float getTickMillis() const { return currentTick.tickMillis; }
+        /// Retrieve whether every tick of the recording was replayed.
+        [[nodiscard]] inline bool isReplayFinished() const { return mode == InputMode::REPLAY && replayIdx > ticks.size(); }
+        /**
+         * Callback accumulating the mouse movement of the tick.
+         *
+         * @param window: A pointer to the GLFW window.
+         * @param xPos:   The current X position of the mouse.
+         * @param yPos:   The current Y position of the mouse.
+         */
+        static void mouse_movement_callback(GLFWwindow* window, double xPos, double yPos);
+        /// Callback accumulating the mouse buttons pressed during the tick.
+        static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+    private:
+        /// A pointer to the window object.
+        Window* window;
+        /// Where the input of every tick comes from.
+        InputMode mode{InputMode::LIVE};
+        /// The recording to write or replay.
+        std::string path{};
+        /// The input the game reads during the current tick.
+        InputTick currentTick{};
+        /// The mouse movement and clicks accumulated by the callbacks since the last tick.
+        InputTick pendingTick{};
+        /// A Boolean that acts as a buffer for initial calls to mouse_movement_callback.
+        bool firstMouse{true};
+        /// The previous position of the mouse.
+        double lastX{0.0}, lastY{0.0};
+        /// The time the current tick started.
+        std::chrono::steady_clock::time_point lastTickTime{std::chrono::steady_clock::now()};
+        /// The ticks recorded so far, or loaded for replay.
+        std::vector<InputTick> ticks{};
+        /// The index of the next tick to replay.
+        size_t replayIdx{0};
+        /// Load a recording for replay.
+        bool loadRecording();
+    };
+}
+
+#endif //OPENGLDEMO_INPUT_HPP
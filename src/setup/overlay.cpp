@@ -0,0 +1,118 @@
+#include <iostream>
+
+#include "imgui.h"
+#include "imgui_impl_glfw.h"
+#include "imgui_impl_opengl3.h"
+
+#include "overlay.hpp"
+
+namespace Engine
+{
+    Overlay::Overlay(Window* window, Craft::World* world, GpuProfiler* gpuProfiler)
+        : window{window}
+        , world{world}
+        , gpuProfiler{gpuProfiler}
+    {}
+    Overlay::~Overlay()
+    {
+        if (!initialized) return;
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext();
+    }
+    bool Overlay::initOverlay()
+    {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+        // Nothing to persist between runs.
+        ImGui::GetIO().IniFilename = nullptr;
+        ImGui::StyleColorsDark();
+        if (!ImGui_ImplGlfw_InitForOpenGL(window->getWindow(), false))
+        {
+            std::cerr << "Failed to initialize the ImGui GLFW backend." << std::endl;
+            ImGui::DestroyContext();
+            return false;
+        }
+        if (!ImGui_ImplOpenGL3_Init("#version 460"))
+        {
+            std::cerr << "Failed to initialize the ImGui OpenGL backend." << std::endl;
+            ImGui_ImplGlfw_Shutdown();
+            ImGui::DestroyContext();
+            return false;
+        }
+        initialized = true;
+        return true;
+    }
+    void Overlay::drawOverlay()
+    {
+        if (!initialized) return;
+        bool toggleDown = glfwGetKey(window->getWindow(), OVERLAY_TOGGLE_KEY) == GLFW_PRESS;
+        if (toggleDown && !toggleHeld)
+        {
+            visible = !visible;
+        }
+        toggleHeld = toggleDown;
+        if (!visible) return;
+
+        FrameTimeStats frameStats = world->getFrameTimeStats();
+        Craft::WorldLiveStats liveStats = world->sampleLiveStats();
+
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+        ImGui::SetNextWindowBgAlpha(0.6f);
+        ImGui::Begin(
+            "Performance",
+            nullptr,
+            ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+            ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs
+        );
+        ImGui::Text("Frame time (last %d frames)", frameStats.numFrames);
+        ImGui::Text("  min %.2f ms  avg %.2f ms  p99 %.2f ms", frameStats.minMillis, frameStats.avgMillis, frameStats.p99Millis);
+        ImGui::Text(
+            "  %.1f fps  1%% low %.1f fps",
+            frameStats.avgMillis > 0.0f ? 1000.0f / frameStats.avgMillis : 0.0f,
+            frameStats.onePercentLowFPS
+        );
+        ImGui::Separator();
+        ImGui::Text("GPU time (%d frames ago)", GPU_PROFILER_FRAMES);
+        for (int pass=0; pass<NUM_GPU_PASSES; pass++)
+        {
+            ImGui::Text("  %s: %.3f ms", GPU_PASS_NAMES[pass], gpuProfiler->getLastFrameMillis((GpuPass) pass));
+        }
+        ImGui::Separator();
+        ImGui::Text("Loaded chunks: %zu", liveStats.loadedChunks);
+        ImGui::Text("  waiting to generate: %zu", liveStats.chunksToGenerate);
+        for (int state=0; state<Craft::NUM_CHUNK_STATES; state++)
+        {
+            ImGui::Text("  %s: %zu", Craft::CHUNK_STATE_NAMES[state], liveStats.chunksPerState[state]);
+        }
+        ImGui::Separator();
+        if (Craft::GPU_MESHING)
+        {
+            ImGui::Text("Instances drawn: n/a (GPU meshing)");
+        }
+        else
+        {
+            ImGui::Text("Instances drawn: %llu", (unsigned long long) liveStats.instancesDrawn);
+        }
+        ImGui::Text("Thread pool queue: %zu", liveStats.poolQueueDepth);
+        ImGui::Text("Mapped buffers: %.1f MiB", (double) liveStats.mappedBufferBytes / (1024.0 * 1024.0));
+        ImGui::Separator();
+        MemoryStats memoryStats = getMemoryStats();
+        ImGui::Text("Heap (live, allocations last frame)");
+        for (int tag=0; tag<NUM_MEMORY_TAGS; tag++)
+        {
+            ImGui::Text(
+                "  %s: %.2f MiB, %llu",
+                MEMORY_TAG_NAMES[tag],
+                (double) memoryStats.liveBytes[tag] / (1024.0 * 1024.0),
+                (unsigned long long) memoryStats.frameAllocations[tag]
+            );
+        }
+        ImGui::End();
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+}
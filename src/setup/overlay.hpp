@@ -0,0 +1,48 @@
+#ifndef OPENGLDEMO_OVERLAY_HPP
+#define OPENGLDEMO_OVERLAY_HPP
+
+#include "window.hpp"
+#include "gpuProfiler.hpp"
+#include "../craft/worldGeneration/world.hpp"
+
+namespace Engine
+{
+    /// The key showing and hiding the performance overlay.
+    const int OVERLAY_TOGGLE_KEY = GLFW_KEY_F3;
+
+    /**
+     * An ImGui window drawn over the frame showing the rolling frame time statistics, the GPU time of every pass and
+     * the world's streaming and memory counters. Hidden until OVERLAY_TOGGLE_KEY is pressed, and sampled only while shown.
+     */
+    class Overlay
+    {
+    public:
+        Overlay(Window* window, Craft::World* world, GpuProfiler* gpuProfiler);
+        ~Overlay();
+        /**
+         * Create the ImGui context and initialize its GLFW and OpenGL backends.
+         *
+         * The backends do not install GLFW callbacks, the overlay is read-only and Input owns the mouse.
+         *
+         * @return: True if the overlay was initialized, else false.
+         */
+        bool initOverlay();
+        /// Toggle the overlay when OVERLAY_TOGGLE_KEY is pressed, then draw it to the bound framebuffer if shown.
+        void drawOverlay();
+    private:
+        /// A pointer to the window object.
+        Window* window;
+        /// The world whose counters are shown.
+        Craft::World* world;
+        /// The profiler whose GPU pass times are shown.
+        GpuProfiler* gpuProfiler;
+        /// Whether the ImGui context and backends were initialized.
+        bool initialized{false};
+        /// Whether the overlay is shown.
+        bool visible{false};
+        /// Whether the toggle key was held during the previous frame.
+        bool toggleHeld{false};
+    };
+}
+
+#endif //OPENGLDEMO_OVERLAY_HPP
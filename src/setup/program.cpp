@@ -30,26 +30,21 @@ namespace Engine
     {
         glUseProgram(program);
     }
-    bool Program::genShader(const std::string& shaderPath)
+    void Program::genShader(const std::string& shaderPath, const std::string& shaderSource)
     {
-        std::string shaderSource = getFileContents(shaderPath.c_str());
         if (shaderSource.empty())
         {
             std::cerr << "Shader contains no content: " << shaderPath << std::endl;
         }
         const char* shaderSrc = shaderSource.c_str();
-        int success;
-        char infoLog[512];
-        bool isVertShader = endsWith(shaderPath, ".vert");
-        bool isGeomShader = endsWith(shaderPath, ".geom");
         GLint shader;
-        if (isVertShader)
+        if (endsWith(shaderPath, ".vert"))
         {
             std::cout << "Generating Vertex Shader: " << shaderPath << std::endl;
             vertShader = glCreateShader(GL_VERTEX_SHADER);
             shader = vertShader;
         }
-        else if (isGeomShader)
+        else if (endsWith(shaderPath, ".geom"))
         {
             std::cout << "Generating Geometry Shader: " << shaderPath << std::endl;
             geomShader = glCreateShader(GL_GEOMETRY_SHADER);
@@ -63,46 +58,88 @@ namespace Engine
         }
         glShaderSource(shader, 1, &shaderSrc, nullptr);
         glCompileShader(shader);
+    }
+    bool Program::checkShader(GLint shader, const std::string& msg)
+    {
+        int success;
+        char infoLog[512];
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if(!success)
         {
             glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-            std::string msg = isVertShader
-                              ? "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
-                              : isGeomShader
-                              ? "ERROR::SHADER::GEOMETRY::COMPILATION_FAILED\n"
-                              : "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n";
             std::cout << msg << infoLog << std::endl;
             return false;
         }
         return true;
     }
 
-    bool Program::initProgram()
+    bool Program::initProgram(ProgramCache* cache)
+    {
+        return startProgram(cache) && finishProgram();
+    }
+    bool Program::startProgram(ProgramCache* cache)
     {
         program = glCreateProgram();
-        if (!genShader(vertexShaderName)) return false;
-        if (!geometryShaderName.empty() && !genShader(geometryShaderName)) return false;
-        if (!genShader(fragmentShaderName)) return false;
+        std::string vertSource = getFileContents(vertexShaderName.c_str());
+        std::string geomSource = geometryShaderName.empty() ? "" : getFileContents(geometryShaderName.c_str());
+        std::string fragSource = getFileContents(fragmentShaderName.c_str());
 
-        int success;
-        char infoLog[512];
+        programCache = cache != nullptr && cache->isEnabled() ? cache : nullptr;
+        if (programCache != nullptr)
+        {
+            cacheKey = programCache->hashSources({vertSource, geomSource, fragSource});
+            loadedFromCache = programCache->loadProgram(program, cacheKey);
+            if (loadedFromCache)
+            {
+                std::cout << "Loaded cached program: " << vertexShaderName << std::endl;
+                return true;
+            }
+        }
+
+        genShader(vertexShaderName, vertSource);
+        if (!geometryShaderName.empty())
+        {
+            genShader(geometryShaderName, geomSource);
+        }
+        genShader(fragmentShaderName, fragSource);
         glAttachShader(program, vertShader);
         glAttachShader(program, fragShader);
         if (geomShader != 0)
         {
             glAttachShader(program, geomShader);
         }
+        if (programCache != nullptr)
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
         glLinkProgram(program);
-        glGetProgramiv(program, GL_LINK_STATUS, &success);
-        if(!success)
+        return true;
+    }
+    bool Program::finishProgram()
+    {
+        if (!loadedFromCache)
         {
-            std::cerr << "OpenGL Error: " << glGetError() << std::endl;
-            std::cerr << "Failed to link the program." << std::endl;
-            glGetProgramInfoLog(program, 512, nullptr, infoLog);
-            std::cerr << "Link info: " << infoLog << std::endl;
-            return false;
+            if (!checkShader(vertShader, "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n")) return false;
+            if (geomShader != 0 && !checkShader(geomShader, "ERROR::SHADER::GEOMETRY::COMPILATION_FAILED\n")) return false;
+            if (!checkShader(fragShader, "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n")) return false;
+
+            int success;
+            char infoLog[512];
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if(!success)
+            {
+                std::cerr << "OpenGL Error: " << glGetError() << std::endl;
+                std::cerr << "Failed to link the program." << std::endl;
+                glGetProgramInfoLog(program, 512, nullptr, infoLog);
+                std::cerr << "Link info: " << infoLog << std::endl;
+                return false;
+            }
+            if (programCache != nullptr)
+            {
+                programCache->storeProgram(program, cacheKey);
+            }
         }
+        uniformLocations = reflectUniforms(program);
         glUseProgram(program);
         // Enable Depth testing
         glEnable(GL_DEPTH_TEST);
@@ -4,6 +4,9 @@
 #include <string>
 #include <unordered_map>
 
+#include "uniform.hpp"
+#include "programCache.hpp"
+
 namespace Engine
 {
     class Program
@@ -28,9 +31,43 @@ namespace Engine
          *
          * Creates an OpenGL program, compiles and attaches the specified shaders, and finally links the program.
          *
+         * @param cache: The program binary cache, or nullptr to always compile from source.
+         * @return:      True if the program was initialized, else False.
+         */
+        bool initProgram(ProgramCache* cache = nullptr);
+        /**
+         * Begin initializing the OpenGL program.
+         *
+         * Loads the program from the cache if possible, else submits the shaders for compilation and the program for
+         * linking without waiting on the result. Starting several programs before finishing any of them lets the
+         * driver compile them concurrently.
+         *
+         * @param cache: The program binary cache, or nullptr to always compile from source.
+         * @return:      True if the program was started, else False.
+         */
+        bool startProgram(ProgramCache* cache = nullptr);
+        /**
+         * Finish initializing the OpenGL program started by startProgram.
+         *
+         * Checks the compile and link status, stores the binary in the cache, and reflects the program's uniforms.
+         *
          * @return: True if the program was initialized, else False.
          */
-        bool initProgram();
+        bool finishProgram();
+        /**
+         * Retrieve a typed handle to one of the program's active uniforms.
+         *
+         * Uniforms are reflected once after linking, so this does not query OpenGL.
+         *
+         * @tparam T:   The CPU side type of the uniform.
+         * @param name: The name of the uniform within the shaders.
+         * @return:     The handle, invalid if the uniform is not active.
+         */
+        template<typename T>
+        [[nodiscard]] Uniform<T> getUniform(const std::string& name) const
+        {
+            return findUniform<T>(program, uniformLocations, name);
+        }
     private:
         /// The path of the vertex shader.
         std::string vertexShaderName;
@@ -48,15 +85,32 @@ namespace Engine
         GLint fragShader{0};
         /// The identifier of the OpenGL program.
         GLuint program{0};
+        /// A mapping of active uniform names to their locations, filled once after linking.
+        std::unordered_map<std::string, GLint> uniformLocations{};
+        /// The cache the program was started with, nullptr if not cached.
+        ProgramCache* programCache{nullptr};
+        /// The key of the program within the cache.
+        uint64_t cacheKey{0};
+        /// Whether the program was loaded from the cache rather than compiled.
+        bool loadedFromCache{false};
         /**
-         * Compile the shader code given a path.
+         * Submit shader code for compilation.
+         *
+         * Creates the shader matching the file extension of the path and compiles it. The compile status is not
+         * checked here, see checkShader.
          *
-         * Read in shader code from file, compile it, then attach it to the program.
+         * @param shaderPath:   The path to the shader.
+         * @param shaderSource: The contents of the shader.
+         */
+        void genShader(const std::string& shaderPath, const std::string& shaderSource);
+        /**
+         * Check the compile status of a shader submitted by genShader.
          *
-         * @param shaderPath: The path to the shader.
-         * @return            true if successful else false.
+         * @param shader: The identifier of the shader.
+         * @param msg:    The message printed if compilation failed.
+         * @return        true if successful else false.
          */
-        bool genShader(const std::string& shaderPath);
+        static bool checkShader(GLint shader, const std::string& msg);
     };
 }
 #endif //OPENGLDEMO_PROGRAM_HPP
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+#include "programCache.hpp"
+
+namespace Engine
+{
+    /// A magic number marking the start of a cached binary ("CCPB").
+    const uint32_t PROGRAM_BINARY_MAGIC = 0x42504343;
+    /// The version of the cached binary layout. Bump whenever ProgramBinaryHeader changes.
+    const uint32_t PROGRAM_BINARY_VERSION = 1;
+
+    /// The header written before every cached program binary.
+    struct ProgramBinaryHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        GLenum format;
+        GLint length;
+    };
+
+    /**
+     * Hash a string with 64 bit FNV-1a.
+     *
+     * @param hash: The running hash.
+     * @param data: The string to add to the hash.
+     * @return:     The updated hash.
+     */
+    static uint64_t fnv1a(uint64_t hash, const std::string& data)
+    {
+        for (unsigned char c: data)
+        {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    ProgramCache::ProgramCache(std::string cacheDir)
+        : cacheDir{std::filesystem::current_path().parent_path() / cacheDir}
+    {}
+    void ProgramCache::initCache()
+    {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        if (numFormats == 0)
+        {
+            std::cout << "Driver supports no program binary formats, shaders will be compiled from source." << std::endl;
+            return;
+        }
+        std::error_code error;
+        std::filesystem::create_directories(cacheDir, error);
+        if (error)
+        {
+            std::cerr << "Failed to create shader cache directory: " << cacheDir << std::endl;
+            return;
+        }
+        driverString = std::string((const char*) glGetString(GL_VENDOR)) + "|" +
+                       std::string((const char*) glGetString(GL_RENDERER)) + "|" +
+                       std::string((const char*) glGetString(GL_VERSION));
+        enabled = true;
+    }
+    uint64_t ProgramCache::hashSources(const std::vector<std::string>& sources) const
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        hash = fnv1a(hash, driverString);
+        for (const auto& source: sources)
+        {
+            // Separate sources so that moving code between stages changes the key.
+            hash = fnv1a(hash, std::to_string(source.size()));
+            hash = fnv1a(hash, source);
+        }
+        return hash;
+    }
+    std::filesystem::path ProgramCache::getBinaryPath(uint64_t key) const
+    {
+        std::stringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return cacheDir / name.str();
+    }
+    bool ProgramCache::loadProgram(GLuint program, uint64_t key) const
+    {
+        if (!enabled) return false;
+        std::ifstream file(getBinaryPath(key), std::ios::binary);
+        if (!file.is_open()) return false;
+
+        ProgramBinaryHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (
+                !file ||
+                header.magic != PROGRAM_BINARY_MAGIC ||
+                header.version != PROGRAM_BINARY_VERSION ||
+                header.key != key ||
+                header.length <= 0
+            )
+        {
+            return false;
+        }
+        std::vector<char> binary(header.length);
+        file.read(binary.data(), header.length);
+        if (!file) return false;
+
+        glProgramBinary(program, header.format, binary.data(), header.length);
+        GLint success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        // The driver rejects binaries it can no longer use (e.g. after an update), fall back to source.
+        return success == GL_TRUE;
+    }
+    void ProgramCache::storeProgram(GLuint program, uint64_t key) const
+    {
+        if (!enabled) return;
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+
+        std::vector<char> binary(length);
+        ProgramBinaryHeader header{PROGRAM_BINARY_MAGIC, PROGRAM_BINARY_VERSION, key, 0, 0};
+        glGetProgramBinary(program, length, &header.length, &header.format, binary.data());
+        if (header.length <= 0) return;
+
+        // Write to a temporary file first so an interrupted write never leaves a truncated binary behind.
+        std::filesystem::path binaryPath = getBinaryPath(key);
+        std::filesystem::path tmpPath = binaryPath;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                std::cerr << "Failed to write shader cache entry: " << tmpPath << std::endl;
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), header.length);
+        }
+        std::error_code error;
+        std::filesystem::rename(tmpPath, binaryPath, error);
+        if (error)
+        {
+            std::cerr << "Failed to write shader cache entry: " << binaryPath << std::endl;
+        }
+    }
+}
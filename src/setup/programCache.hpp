@@ -0,0 +1,73 @@
+#ifndef OPENGLDEMO_PROGRAMCACHE_HPP
+#define OPENGLDEMO_PROGRAMCACHE_HPP
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace Engine
+{
+    /**
+     * A disk cache of linked program binaries.
+     *
+     * Binaries are retrieved with glGetProgramBinary after a successful link and keyed by a hash of the program's
+     * shader sources and the driver (vendor, renderer and version) strings. Any change to a shader or the driver
+     * produces a new key, so stale entries are simply never loaded again.
+     */
+    class ProgramCache
+    {
+    public:
+        /**
+         * Create a program cache.
+         *
+         * @param cacheDir: The relative path from the project root to the directory holding the binaries.
+         */
+        explicit ProgramCache(std::string cacheDir);
+        ~ProgramCache() = default;
+        /**
+         * Initialize the cache. Must be called once an OpenGL context is current.
+         *
+         * The cache disables itself if the driver does not support any program binary formats.
+         */
+        void initCache();
+        /// Retrieve whether binaries can be loaded and stored.
+        [[nodiscard]] inline bool isEnabled() const { return enabled; }
+        /**
+         * Hash the given shader sources together with the driver string.
+         *
+         * @param sources: The sources of every shader within the program, in attachment order.
+         * @return:        The key of the program within the cache.
+         */
+        [[nodiscard]] uint64_t hashSources(const std::vector<std::string>& sources) const;
+        /**
+         * Load a cached binary into the given program.
+         *
+         * @param program: The identifier of an unlinked OpenGL program.
+         * @param key:     The key of the program.
+         * @return:        True if the binary was found and the program linked successfully, else false.
+         */
+        bool loadProgram(GLuint program, uint64_t key) const;
+        /**
+         * Store the binary of a linked program.
+         *
+         * The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+         *
+         * @param program: The identifier of the linked OpenGL program.
+         * @param key:     The key of the program.
+         */
+        void storeProgram(GLuint program, uint64_t key) const;
+    private:
+        /// The directory holding the cached binaries.
+        std::filesystem::path cacheDir;
+        /// The vendor, renderer and version strings of the current driver.
+        std::string driverString{};
+        /// Whether the cache is usable.
+        bool enabled{false};
+        /// Retrieve the file path of the binary with the given key.
+        [[nodiscard]] std::filesystem::path getBinaryPath(uint64_t key) const;
+    };
+}
+
+#endif //OPENGLDEMO_PROGRAMCACHE_HPP
@@ -0,0 +1,35 @@
+#include <vector>
+
+#include "uniform.hpp"
+
+namespace Engine
+{
+    std::unordered_map<std::string, GLint> reflectUniforms(GLuint program)
+    {
+        std::unordered_map<std::string, GLint> uniforms{};
+        GLint numUniforms = 0;
+        GLint maxNameLength = 0;
+        glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms);
+        glGetProgramInterfaceiv(program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+        const GLenum properties[] = {GL_BLOCK_INDEX, GL_LOCATION};
+        std::vector<char> nameBuffer(maxNameLength + 1);
+        for (GLint idx = 0; idx < numUniforms; idx++)
+        {
+            GLint values[2];
+            glGetProgramResourceiv(program, GL_UNIFORM, idx, 2, properties, 2, nullptr, values);
+            // Members of a uniform block have no location, they are set through the block's buffer.
+            if (values[0] != -1) continue;
+
+            GLsizei nameLength = 0;
+            glGetProgramResourceName(program, GL_UNIFORM, idx, (GLsizei) nameBuffer.size(), &nameLength, nameBuffer.data());
+            std::string name{nameBuffer.data(), (size_t) nameLength};
+            uniforms[name] = values[1];
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            {
+                uniforms[name.substr(0, name.size() - 3)] = values[1];
+            }
+        }
+        return uniforms;
+    }
+}
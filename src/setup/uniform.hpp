@@ -0,0 +1,116 @@
+#ifndef OPENGLDEMO_UNIFORM_HPP
+#define OPENGLDEMO_UNIFORM_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <string>
+#include <unordered_map>
+#include <iostream>
+
+namespace Engine
+{
+    /**
+     * A typed handle to a uniform within a linked OpenGL program.
+     *
+     * Handles are resolved once from the program's reflected uniforms and write through glProgramUniform*, so the
+     * program does not need to be bound when setting a value. An invalid handle (location -1) is silently ignored
+     * by OpenGL, matching the old behaviour of the set* helpers.
+     *
+     * @tparam T: The CPU side type of the uniform.
+     */
+    template<typename T>
+    class Uniform
+    {
+    public:
+        Uniform() = default;
+        Uniform(GLuint program, GLint location)
+            : program{program}
+            , location{location}
+        {}
+        /**
+         * Set the value of the uniform.
+         *
+         * @param value: The value to set.
+         */
+        void set(const T& value) const;
+        /// Retrieve whether the uniform was found within the program.
+        [[nodiscard]] inline bool isValid() const { return location != -1; }
+        /// Retrieve the location of the uniform.
+        [[nodiscard]] inline GLint getLocation() const { return location; }
+    private:
+        /// The identifier of the OpenGL program the uniform belongs to.
+        GLuint program{0};
+        /// The location of the uniform within the program.
+        GLint location{-1};
+    };
+
+    template<> inline void Uniform<bool>::set(const bool& value) const
+    {
+        glProgramUniform1i(program, location, value ? 1 : 0);
+    }
+    template<> inline void Uniform<int>::set(const int& value) const
+    {
+        glProgramUniform1i(program, location, value);
+    }
+    template<> inline void Uniform<float>::set(const float& value) const
+    {
+        glProgramUniform1f(program, location, value);
+    }
+    template<> inline void Uniform<glm::vec2>::set(const glm::vec2& value) const
+    {
+        glProgramUniform2fv(program, location, 1, glm::value_ptr(value));
+    }
+    template<> inline void Uniform<glm::ivec2>::set(const glm::ivec2& value) const
+    {
+        glProgramUniform2iv(program, location, 1, glm::value_ptr(value));
+    }
+    template<> inline void Uniform<glm::vec3>::set(const glm::vec3& value) const
+    {
+        glProgramUniform3fv(program, location, 1, glm::value_ptr(value));
+    }
+    template<> inline void Uniform<glm::ivec3>::set(const glm::ivec3& value) const
+    {
+        glProgramUniform3iv(program, location, 1, glm::value_ptr(value));
+    }
+    template<> inline void Uniform<glm::vec4>::set(const glm::vec4& value) const
+    {
+        glProgramUniform4fv(program, location, 1, glm::value_ptr(value));
+    }
+    template<> inline void Uniform<glm::mat4>::set(const glm::mat4& value) const
+    {
+        glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+    /**
+     * Query every active uniform of a linked program.
+     *
+     * Uniforms that live inside of a uniform block are skipped as they have no location. Array uniforms are stored
+     * both with and without their "[0]" suffix.
+     *
+     * @param program: The identifier of the linked OpenGL program.
+     * @return:        A mapping of uniform name to location.
+     */
+    std::unordered_map<std::string, GLint> reflectUniforms(GLuint program);
+    /**
+     * Retrieve a typed handle to a reflected uniform.
+     *
+     * @tparam T:       The CPU side type of the uniform.
+     * @param program:  The identifier of the OpenGL program.
+     * @param uniforms: The reflected uniforms of the program.
+     * @param name:     The name of the uniform.
+     * @return:         The handle, invalid if the uniform is not active within the program.
+     */
+    template<typename T>
+    Uniform<T> findUniform(GLuint program, const std::unordered_map<std::string, GLint>& uniforms, const std::string& name)
+    {
+        auto iter = uniforms.find(name);
+        if (iter == uniforms.end())
+        {
+            std::cout << "Failed to find location: " << name << std::endl;
+            return Uniform<T>{program, -1};
+        }
+        return Uniform<T>{program, iter->second};
+    }
+}
+
+#endif //OPENGLDEMO_UNIFORM_HPP
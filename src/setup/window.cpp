@@ -4,10 +4,11 @@
 
 namespace Engine
 {
-    Window::Window(int width, int height, std::string name)
+    Window::Window(int width, int height, std::string name, bool headless)
         : width{width}
         , height{height}
         , name( std::move(name) )
+        , headless{headless}
     {}
     Window::~Window()
     {
@@ -33,8 +34,9 @@ namespace Engine
             glfwSetWindowShouldClose(window, GLFW_TRUE);
         }
     }
-    bool Window::initWindow()
+    bool Window::initGLFW(int platform)
     {
+        glfwInitHint(GLFW_PLATFORM, platform);
         if (!glfwInit())
         {
             std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -44,27 +46,52 @@ namespace Engine
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-        // Get the primary monitor
-        GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
-        if (!primaryMonitor) {
-            std::cerr << "Failed to get the primary monitor" << std::endl;
-            glfwTerminate();
-            return false;
+        return true;
+    }
+    bool Window::initWindow()
+    {
+        // Without a display, first render through Mesa's OSMesa on GLFW's null platform.
+        bool nullPlatform = headless && glfwPlatformSupported(GLFW_PLATFORM_NULL);
+        if (!initGLFW(nullPlatform ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM)) return false;
+        if (headless)
+        {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, nullPlatform ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
         }
+        else
+        {
+            // Get the primary monitor
+            GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
+            if (!primaryMonitor) {
+                std::cerr << "Failed to get the primary monitor" << std::endl;
+                glfwTerminate();
+                return false;
+            }
 
-        // Get the video mode of the primary monitor
-        const GLFWvidmode* videoMode = glfwGetVideoMode(primaryMonitor);
-        if (!videoMode) {
-            std::cerr << "Failed to get the video mode of the primary monitor" << std::endl;
-            glfwTerminate();
-            return false;
+            // Get the video mode of the primary monitor
+            const GLFWvidmode* videoMode = glfwGetVideoMode(primaryMonitor);
+            if (!videoMode) {
+                std::cerr << "Failed to get the video mode of the primary monitor" << std::endl;
+                glfwTerminate();
+                return false;
+            }
         }
 //        width = 1500;//videoMode->width;
 //        height = 1000;//videoMode->height;
 
 
         window = glfwCreateWindow(width,height,  name.c_str(), nullptr, nullptr);
+        if (window == nullptr && nullPlatform)
+        {
+            // The null platform is always built in, but without libOSMesa it cannot create a context, so retry on
+            // the default platform through an EGL surface.
+            std::cerr << "Failed to create an OSMesa context, falling back to EGL" << std::endl;
+            glfwTerminate();
+            if (!initGLFW(GLFW_ANY_PLATFORM)) return false;
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            window = glfwCreateWindow(width,height,  name.c_str(), nullptr, nullptr);
+        }
         if (window == nullptr)
         {
             std::cerr << "Failed to create GLFW window" << std::endl;
@@ -12,11 +12,12 @@ namespace Engine
         /**
          * Initialize the GLFW Window.
          *
-         * @param width:  The width of the given window.
-         * @param height: The height of the given window.
-         * @param name:   The name of the given window.
+         * @param width:    The width of the given window.
+         * @param height:   The height of the given window.
+         * @param name:     The name of the given window.
+         * @param headless: Whether to render offscreen, without a display, for benchmarking.
          */
-        explicit Window(int width, int height, std::string name);
+        explicit Window(int width, int height, std::string name, bool headless = false);
         ~Window();
         /**
          * Retrieve whether the window should close.
@@ -45,6 +46,13 @@ namespace Engine
         [[nodiscard]] inline int getHeight() const {return height;}
 
     private:
+        /**
+         * Initialize GLFW on a platform and hint the OpenGL version of the window's context.
+         *
+         * @param platform: The GLFW platform to initialize, or GLFW_ANY_PLATFORM to let GLFW choose.
+         * @return true if successful else false.
+         */
+        static bool initGLFW(int platform);
         /**
          * Initialize GLAD, the OpenGL wrapper for this project.
          *
@@ -59,6 +67,8 @@ namespace Engine
         int height;
         /// The name of the GLFW window.
         std::string name;
+        /// Whether the window is an invisible offscreen surface.
+        bool headless;
     };
 }
 #endif //OPENGLDEMO_WINDOW_HPP
\ No newline at end of file
@@ -0,0 +1,296 @@
+//
+// Checks the world's bulk edits on a 3x3 square of generated chunks: random fills, spheres, replacements, and copies
+// pasted elsewhere are split across the chunks and applied the way the world applies them, then compared against the
+// blocks each edit should leave, the copies against the square's blocks, the light against relighting every chunk
+// from scratch, and the chunks sent back through the pipeline against the chunks the edit changed or faces.
+//
+// Usage: chunkcraft-editcheck [edits]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include "chunkSquare.hpp"
+#include "../src/craft/worldGeneration/bulkEdit.hpp"
+
+using namespace Craft;
+
+/// The names of the bulk edits, indexed by the kind of edit.
+const char* EDIT_NAMES[4] = {"fill", "sphere", "replace", "paste"};
+/// The largest size of a random box along x and z, wide enough to cross a chunk.
+const int MAX_BOX_WIDTH = 24;
+
+/// Retrieve the index within the square of a chunk position, -1 for chunks beyond the square.
+static int getSquareIdx(Coordinate2D<int> chunkPos)
+{
+    if (chunkPos.x < -1 || chunkPos.x > 1 || chunkPos.z < -1 || chunkPos.z > 1) return -1;
+    return ((chunkPos.z + 1) * 3) + (chunkPos.x + 1);
+}
+
+/// Retrieve the type of the block at a world position, air beyond the square.
+static BlockId getSquareBlock(const ChunkSquare& square, Coordinate<int> worldPos)
+{
+    Coordinate2D<int> chunkPos{
+        (int) std::floor((float) worldPos.x / CHUNK_WIDTH), (int) std::floor((float) worldPos.z / CHUNK_WIDTH)
+    };
+    int chunk = getSquareIdx(chunkPos);
+    if (chunk < 0) return AIR_BLOCK_ID;
+    return square.columns[chunk].getBlock(
+        worldPos.x - (chunkPos.x * CHUNK_WIDTH), worldPos.y, worldPos.z - (chunkPos.z * CHUNK_WIDTH)
+    );
+}
+
+/// Pick a random corner of a box near the surface of the square, up to a few blocks past its sides.
+static Coordinate<int> pickCorner(const ChunkSquare& square, std::mt19937& gen)
+{
+    std::uniform_int_distribution<> xz(-CHUNK_WIDTH - 4, (2 * CHUNK_WIDTH) + 3), dy(-12, 6);
+    int x = xz(gen), z = xz(gen);
+    int columnX = std::clamp(x, -CHUNK_WIDTH, (2 * CHUNK_WIDTH) - 1) + CHUNK_WIDTH;
+    int columnZ = std::clamp(z, -CHUNK_WIDTH, (2 * CHUNK_WIDTH) - 1) + CHUNK_WIDTH;
+    const ChunkColumns& columns = square.columns[((columnZ / CHUNK_WIDTH) * 3) + (columnX / CHUNK_WIDTH)];
+    int top = columns.getTopBlock(columnX % CHUNK_WIDTH, columnZ % CHUNK_WIDTH);
+    return {x, top + dy(gen), z};
+}
+
+/**
+ * Apply a bulk edit to the square the way World::editBox and World::finishBulkEdit do.
+ *
+ * @param staleChunks: Set to the chunks the world would send back through the pipeline.
+ * @return:            The number of chunks that changed.
+ */
+template<class Edit>
+static int editSquare(
+        const LightEngine& engine,
+        ChunkSquare& square,
+        Coordinate<int> firstCorner,
+        Coordinate<int> secondCorner,
+        const Edit& edit,
+        std::vector<Coordinate2D<int>>& staleChunks
+    )
+{
+    std::vector<BlockId> dense(BLOCKS_IN_CHUNK);
+    std::vector<Coordinate2D<int>> editedChunks{};
+    std::vector<uint8_t> borderMasks{};
+    for (const ChunkBox& part: splitBox(firstCorner, secondCorner))
+    {
+        int chunk = getSquareIdx(part.chunkPos);
+        if (chunk < 0) continue;
+        Coordinate<int> chunkOrigin = part.getOrigin();
+        ChunkEditResult result = editColumns(
+            square.columns[chunk], part.minPos, part.maxPos, dense.data(),
+            [&](Coordinate<int> blockPos, BlockId id) { return edit(blockPos + chunkOrigin, id); },
+            [](int, BlockId) {}
+        );
+        if (!result.changed) continue;
+        engine.lightChunk(square.columns[chunk], square.light[chunk]);
+        editedChunks.push_back(part.chunkPos);
+        borderMasks.push_back(result.borderMask);
+    }
+    auto isLoaded = [](Coordinate2D<int> chunkPos) { return getSquareIdx(chunkPos) >= 0; };
+    std::vector<Coordinate2D<int>> relitChunks = getRelitChunks(editedChunks, isLoaded);
+    for (size_t idx = editedChunks.size(); idx < relitChunks.size(); idx++)
+    {
+        int chunk = getSquareIdx(relitChunks[idx]);
+        engine.lightChunk(square.columns[chunk], square.light[chunk]);
+    }
+    for (const Coordinate2D<int>& chunkPos: relitChunks)
+    {
+        engine.propagateBorders(getNeighborhood(square, getSquareIdx(chunkPos)));
+    }
+    staleChunks = getStaleChunks(editedChunks, borderMasks, isLoaded);
+    return (int) editedChunks.size();
+}
+
+/**
+ * Copy the blocks within a box of the square the way World::copyBlocks does.
+ *
+ * @return: The blocks of the box, air beyond the square.
+ */
+static BlockBuffer copySquare(const ChunkSquare& square, Coordinate<int> firstCorner, Coordinate<int> secondCorner)
+{
+    Coordinate<int> minCorner = firstCorner;
+    Coordinate<int> maxCorner = secondCorner;
+    orderCorners(minCorner, maxCorner);
+    BlockBuffer out{};
+    out.size = {maxCorner.x - minCorner.x + 1, maxCorner.y - minCorner.y + 1, maxCorner.z - minCorner.z + 1};
+    out.blocks.assign((size_t) out.size.x * out.size.y * out.size.z, AIR_BLOCK_ID);
+    for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+    {
+        copyColumns(square.columns[chunk], {(chunk % 3) - 1, (chunk / 3) - 1}, minCorner, maxCorner, out);
+    }
+    return out;
+}
+
+int main(int argc, char** argv)
+{
+    int numEdits = argc > 1 ? std::max(0, std::stoi(argv[1])) : 256;
+
+    ToolBlocks blocks{};
+    const BlockId blockTypes[4] = {AIR_BLOCK_ID, blocks.stoneId, blocks.grassId, blocks.lampId};
+    LightEngine engine(&blocks.registry);
+    DensityField terrain(TOOL_TERRAIN_SEED);
+
+    auto square = std::make_unique<ChunkSquare>();
+    auto before = std::make_unique<ChunkSquare>();
+    auto reference = std::make_unique<ChunkSquare>();
+    generateSquare(terrain, blocks, *square);
+    lightFromScratch(engine, *square);
+
+    // Edit boxes around the surface, some reaching past the square.
+    std::mt19937 gen(44);
+    std::uniform_int_distribution<> width(1, MAX_BOX_WIDTH), height(1, 12), kind(0, 3), type(0, 3), coin(0, 1);
+    std::vector<BlockId> denseBefore(BLOCKS_IN_CHUNK), denseAfter(BLOCKS_IN_CHUNK);
+    std::chrono::high_resolution_clock::duration editTime{0};
+    long failures = 0;
+    for (int editIdx = 0; editIdx < numEdits; editIdx++)
+    {
+        int editKind = kind(gen);
+        Coordinate<int> firstCorner = pickCorner(*square, gen);
+        Coordinate<int> secondCorner = firstCorner + Coordinate<int>{width(gen) - 1, height(gen) - 1, width(gen) - 1};
+        BlockId id = blockTypes[type(gen)];
+        BlockId from = blockTypes[type(gen)];
+        int radius = width(gen) / 2;
+        BlockBuffer copied{};
+        bool pasteAir = coin(gen) == 1;
+        if (editKind == 3)
+        {
+            // Copy a box, check it against the square, then paste it somewhere else.
+            Coordinate<int> copyCorner = pickCorner(*square, gen);
+            copied = copySquare(*square, copyCorner, copyCorner + secondCorner + Coordinate<int>{
+                -firstCorner.x, -firstCorner.y, -firstCorner.z
+            });
+            for (int yIdx = 0; yIdx < copied.size.y; yIdx++)
+            {
+                for (int zIdx = 0; zIdx < copied.size.z; zIdx++)
+                {
+                    for (int xIdx = 0; xIdx < copied.size.x; xIdx++)
+                    {
+                        Coordinate<int> worldPos = copyCorner + Coordinate<int>{xIdx, yIdx, zIdx};
+                        if (copied.blocks[copied.getIdx(xIdx, yIdx, zIdx)] == getSquareBlock(*square, worldPos))
+                        {
+                            continue;
+                        }
+                        std::cerr << "Copy " << editIdx << " differs from the square at " << worldPos << std::endl;
+                        failures++;
+                    }
+                }
+            }
+        }
+        auto applyKind = [&](Coordinate<int> blockPos, BlockId current) -> BlockId
+        {
+            switch (editKind)
+            {
+                case 0: return FillEdit{id}(blockPos, current);
+                case 1: return SphereEdit{firstCorner, radius * radius, id}(blockPos, current);
+                case 2: return ReplaceEdit{from, id}(blockPos, current);
+                default: return PasteEdit{firstCorner, &copied, pasteAir}(blockPos, current);
+            }
+        };
+        Coordinate<int> boxMin = firstCorner, boxMax = secondCorner;
+        if (editKind == 1)
+        {
+            boxMin = firstCorner + Coordinate<int>{-radius, -radius, -radius};
+            boxMax = firstCorner + Coordinate<int>{radius, radius, radius};
+        }
+
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++) before->columns[chunk] = square->columns[chunk];
+        std::vector<Coordinate2D<int>> staleChunks{};
+        auto start = std::chrono::high_resolution_clock::now();
+        int changedChunks = editSquare(engine, *square, boxMin, boxMax, applyKind, staleChunks);
+        editTime += std::chrono::high_resolution_clock::now() - start;
+
+        // Compare every chunk against the edit applied block by block, noting the chunks that must be re-queued.
+        int expectedChanged = 0;
+        std::vector<Coordinate2D<int>> expectedStale{};
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            Coordinate2D<int> chunkPos{(chunk % 3) - 1, (chunk / 3) - 1};
+            Coordinate<int> chunkOrigin{chunkPos.x * CHUNK_WIDTH, 0, chunkPos.z * CHUNK_WIDTH};
+            before->columns[chunk].toDense(denseBefore.data());
+            square->columns[chunk].toDense(denseAfter.data());
+            bool changed = false;
+            for (int blockIdx = 0; blockIdx < BLOCKS_IN_CHUNK; blockIdx++)
+            {
+                Coordinate<int> blockPos{
+                    blockIdx % CHUNK_WIDTH, blockIdx / CHUNK_SIZE, (blockIdx % CHUNK_SIZE) / CHUNK_WIDTH
+                };
+                Coordinate<int> worldPos = blockPos + chunkOrigin;
+                bool inBox = worldPos.x >= std::min(boxMin.x, boxMax.x) && worldPos.x <= std::max(boxMin.x, boxMax.x) &&
+                             worldPos.y >= std::min(boxMin.y, boxMax.y) && worldPos.y <= std::max(boxMin.y, boxMax.y) &&
+                             worldPos.z >= std::min(boxMin.z, boxMax.z) && worldPos.z <= std::max(boxMin.z, boxMax.z);
+                BlockId expected = inBox ? applyKind(worldPos, denseBefore[blockIdx]) : denseBefore[blockIdx];
+                if (denseAfter[blockIdx] != expected)
+                {
+                    std::cerr << EDIT_NAMES[editKind] << " " << editIdx << " left " << denseAfter[blockIdx]
+                              << " instead of " << expected << " at " << worldPos << std::endl;
+                    failures++;
+                }
+                if (denseAfter[blockIdx] == denseBefore[blockIdx]) continue;
+                changed = true;
+                for (int neighbor = 0; neighbor < 4; neighbor++)
+                {
+                    bool facing = (neighbor == 0 && blockPos.x == CHUNK_WIDTH - 1) ||
+                                  (neighbor == 1 && blockPos.x == 0) ||
+                                  (neighbor == 2 && blockPos.z == CHUNK_WIDTH - 1) ||
+                                  (neighbor == 3 && blockPos.z == 0);
+                    Coordinate2D<int> neighborPos = chunkPos + CHUNK_NEIGHBOR_OFFSETS[neighbor];
+                    if (!facing || getSquareIdx(neighborPos) < 0) continue;
+                    if (std::find(expectedStale.begin(), expectedStale.end(), neighborPos) == expectedStale.end())
+                    {
+                        expectedStale.push_back(neighborPos);
+                    }
+                }
+            }
+            if (!changed) continue;
+            expectedChanged++;
+            if (std::find(expectedStale.begin(), expectedStale.end(), chunkPos) == expectedStale.end())
+            {
+                expectedStale.push_back(chunkPos);
+            }
+        }
+        if (changedChunks != expectedChanged)
+        {
+            std::cerr << EDIT_NAMES[editKind] << " " << editIdx << " reported " << changedChunks
+                      << " changed chunks instead of " << expectedChanged << "." << std::endl;
+            failures++;
+        }
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            Coordinate2D<int> chunkPos{(chunk % 3) - 1, (chunk / 3) - 1};
+            long queued = std::count(staleChunks.begin(), staleChunks.end(), chunkPos);
+            long expected = std::count(expectedStale.begin(), expectedStale.end(), chunkPos);
+            if (queued == expected) continue;
+            std::cerr << EDIT_NAMES[editKind] << " " << editIdx << " re-queued chunk " << chunk << " " << queued
+                      << " times instead of " << expected << "." << std::endl;
+            failures++;
+        }
+
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++) reference->columns[chunk] = square->columns[chunk];
+        lightFromScratch(engine, *reference);
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            if (!(reference->light[chunk] == square->light[chunk]))
+            {
+                std::cerr << "After " << EDIT_NAMES[editKind] << " " << editIdx << " chunk " << chunk
+                          << " differs from lighting from scratch." << std::endl;
+                failures++;
+            }
+        }
+        if (failures > 0) break;
+    }
+
+    std::cout << "bulk edit: " << std::chrono::duration<double, std::micro>(editTime).count() / std::max(numEdits, 1)
+              << " us/edit" << std::endl;
+    if (failures > 0)
+    {
+        std::cerr << failures << " bulk edit checks failed." << std::endl;
+        return -1;
+    }
+    return 0;
+}
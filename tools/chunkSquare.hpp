@@ -0,0 +1,98 @@
+//
+// The generated terrain the headless tools work on: the block types they register, chunks generated from the same
+// seed, and a 3x3 square of chunks lit the way the world lights them.
+//
+
+#ifndef OPENGLDEMO_CHUNKSQUARE_HPP
+#define OPENGLDEMO_CHUNKSQUARE_HPP
+
+#include "../src/helpers/arena.hpp"
+#include "../src/craft/worldGeneration/blockRegistry.hpp"
+#include "../src/craft/worldGeneration/densityField.hpp"
+#include "../src/craft/worldGeneration/chunkColumns.hpp"
+#include "../src/craft/worldGeneration/lightEngine.hpp"
+
+namespace Craft
+{
+    /// The seed of the terrain every tool generates.
+    const int TOOL_TERRAIN_SEED = 44;
+
+    /// The registry of the tools' block types.
+    struct ToolBlocks
+    {
+        BlockRegistry registry{};
+        const BlockId stoneId = registry.registerBlock("stone", true, 0);
+        const BlockId grassId = registry.registerBlock("grass", true, 0);
+        const BlockId lampId = registry.registerBlock("lamp", true, MAX_LIGHT_LEVEL);
+    };
+
+    /**
+     * Generate the blocks of a chunk, reusing the worker arena of the calling thread.
+     *
+     * @param terrain:  The density field generating the terrain.
+     * @param blocks:   The tools' block types.
+     * @param chunkPos: The position of the chunk.
+     * @param columns:  The columns to write to.
+     */
+    inline void generateColumns(
+            DensityField& terrain,
+            const ToolBlocks& blocks,
+            Coordinate2D<int> chunkPos,
+            ChunkColumns& columns
+        )
+    {
+        Engine::getWorkerArena().reset();
+        ChunkOccupancy occupancy{};
+        terrain.generate(chunkPos, occupancy);
+        columns.fromTerrain(occupancy, blocks.grassId, blocks.stoneId);
+    }
+
+    /// The chunks of a 3x3 square centered on chunk (0, 0), indexed like a LightNeighborhood.
+    struct ChunkSquare
+    {
+        ChunkColumns columns[LIGHT_NEIGHBORHOOD_CHUNKS]{};
+        ChunkLight light[LIGHT_NEIGHBORHOOD_CHUNKS]{};
+    };
+
+    /// Generate the blocks of every chunk of the square, leaving its light alone.
+    inline void generateSquare(DensityField& terrain, const ToolBlocks& blocks, ChunkSquare& square)
+    {
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            generateColumns(terrain, blocks, {(chunk % 3) - 1, (chunk / 3) - 1}, square.columns[chunk]);
+        }
+    }
+
+    /// Build the neighborhood of one of the square's chunks, leaving out the chunks beyond the square.
+    inline LightNeighborhood getNeighborhood(ChunkSquare& square, int chunk)
+    {
+        LightNeighborhood neighborhood{};
+        for (int dz = -1; dz <= 1; dz++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int x = (chunk % 3) + dx, z = (chunk / 3) + dz;
+                if (x < 0 || x > 2 || z < 0 || z > 2) continue;
+                int slot = ((dz + 1) * 3) + (dx + 1);
+                neighborhood.columns[slot] = &square.columns[(z * 3) + x];
+                neighborhood.light[slot] = &square.light[(z * 3) + x];
+            }
+        }
+        return neighborhood;
+    }
+
+    /// Light every chunk of the square on its own, then spread the light across every border as the world does.
+    inline void lightFromScratch(const LightEngine& engine, ChunkSquare& square)
+    {
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            engine.lightChunk(square.columns[chunk], square.light[chunk]);
+        }
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            engine.propagateBorders(getNeighborhood(square, chunk));
+        }
+    }
+}
+
+#endif //OPENGLDEMO_CHUNKSQUARE_HPP
@@ -0,0 +1,180 @@
+//
+// Times the conversions and queries of the column run-length chunk representation on generated terrain, checks that
+// every conversion and random edits round trip through the dense form and keep the heightmap current, and reports the
+// memory used per chunk.
+//
+// Usage: chunkcraft-columnbench [chunk radius]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstring>
+#include <algorithm>
+
+#include "../src/helpers/arena.hpp"
+#include "../src/craft/worldGeneration/densityField.hpp"
+#include "../src/craft/worldGeneration/chunkColumns.hpp"
+
+using namespace Craft;
+
+/// The block types the terrain is built from, standing in for the BlockRegistry's identifiers.
+const BlockId STONE_ID = 1;
+const BlockId GRASS_ID = 2;
+/// The number of random edits applied to every chunk.
+const int EDITS_PER_CHUNK = 256;
+/// The bytes a block took as a node of the previous per-chunk hash map: the key, the block, the hash and a link.
+const size_t HASH_NODE_BYTES = 40;
+
+/// The time spent in each operation, summed over every chunk.
+struct OperationTimes
+{
+    std::chrono::high_resolution_clock::duration fromTerrain{0};
+    std::chrono::high_resolution_clock::duration toDense{0};
+    std::chrono::high_resolution_clock::duration fromDense{0};
+    std::chrono::high_resolution_clock::duration toOccupancy{0};
+    std::chrono::high_resolution_clock::duration encode{0};
+    std::chrono::high_resolution_clock::duration decode{0};
+    std::chrono::high_resolution_clock::duration queries{0};
+    std::chrono::high_resolution_clock::duration edits{0};
+};
+
+/// Add the time taken by a call to an operation's total.
+template<class Operation>
+static void timeOperation(std::chrono::high_resolution_clock::duration& total, Operation operation)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    operation();
+    total += std::chrono::high_resolution_clock::now() - start;
+}
+
+static void printTime(const char* name, std::chrono::high_resolution_clock::duration total, double count, const char* unit)
+{
+    std::cout << name << ": " << std::chrono::duration<double, std::micro>(total).count() / count << " us/" << unit << std::endl;
+}
+
+/// Count the columns whose heightmap entry differs from the highest block of the dense form.
+static long countHeightMismatches(const ChunkColumns& columns, const std::vector<BlockId>& dense)
+{
+    long mismatches = 0;
+    for (int column = 0; column < CHUNK_SIZE; column++)
+    {
+        int top = CHUNK_HEIGHT - 1;
+        while (top >= 0 && dense[(top * CHUNK_SIZE) + column] == AIR_BLOCK_ID) top--;
+        mismatches += columns.getTopBlock(column % CHUNK_WIDTH, column / CHUNK_WIDTH) != top ? 1 : 0;
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    int radius = argc > 1 ? std::max(0, std::stoi(argv[1])) : 4;
+
+    DensityField terrain(44);
+    const std::vector<BlockId> palette{AIR_BLOCK_ID, STONE_ID, GRASS_ID};
+    std::vector<BlockId> dense(BLOCKS_IN_CHUNK), roundTrip(BLOCKS_IN_CHUNK);
+    std::vector<uint8_t> encoded{};
+    std::mt19937 gen(44);
+    OperationTimes times{};
+    ChunkColumns columns{}, decoded{};
+    long numChunks = 0, numQueries = 0, solidBlocks = 0, failures = 0;
+    size_t columnBytes = 0, encodedBytes = 0, numRuns = 0;
+    for (int chunkX = -radius; chunkX <= radius; chunkX++)
+    {
+        for (int chunkZ = -radius; chunkZ <= radius; chunkZ++)
+        {
+            Engine::getWorkerArena().reset();
+            ChunkOccupancy occupancy{};
+            terrain.generate({chunkX, chunkZ}, occupancy);
+            numChunks++;
+
+            timeOperation(times.fromTerrain, [&]() { columns.fromTerrain(occupancy, GRASS_ID, STONE_ID); });
+            timeOperation(times.toDense, [&]() { columns.toDense(dense.data()); });
+            timeOperation(times.fromDense, [&]() { decoded.fromDense(dense.data()); });
+            decoded.toDense(roundTrip.data());
+            failures += dense != roundTrip ? 1 : 0;
+
+            ChunkOccupancy converted{};
+            timeOperation(times.toOccupancy, [&]() { columns.toOccupancy(converted); });
+            failures += std::memcmp(converted.rows, occupancy.rows, sizeof(occupancy.rows)) != 0 ? 1 : 0;
+
+            encoded.clear();
+            timeOperation(times.encode, [&]() { columns.encode(palette, encoded); });
+            bool decodedColumns = false;
+            timeOperation(times.decode, [&]() { decodedColumns = decoded.decode(encoded.data(), encoded.size(), palette); });
+            decoded.toDense(roundTrip.data());
+            failures += !decodedColumns || dense != roundTrip ? 1 : 0;
+
+            // Query every block and every column, checking them against the dense form.
+            long mismatches = 0;
+            timeOperation(times.queries, [&]() {
+                for (int blockIdx = 0; blockIdx < BLOCKS_IN_CHUNK; blockIdx++)
+                {
+                    int x = blockIdx % CHUNK_WIDTH, z = (blockIdx / CHUNK_WIDTH) % CHUNK_WIDTH, y = blockIdx / CHUNK_SIZE;
+                    mismatches += columns.blockExists(x, y, z) != (dense[blockIdx] != AIR_BLOCK_ID) ? 1 : 0;
+                }
+            });
+            numQueries += BLOCKS_IN_CHUNK;
+            mismatches += countHeightMismatches(columns, dense) + countHeightMismatches(decoded, dense);
+            failures += mismatches > 0 ? 1 : 0;
+
+            solidBlocks += std::count_if(dense.begin(), dense.end(), [](BlockId id) { return id != AIR_BLOCK_ID; });
+            // Measure a chunk's columns as generated, the chunk reused above has grown to hold earlier edits.
+            ChunkColumns generated{};
+            generated.fromTerrain(occupancy, GRASS_ID, STONE_ID);
+            columnBytes += generated.getMemoryUsage();
+            encodedBytes += encoded.size();
+            numRuns += columns.getNumRuns();
+
+            // Dig and build around the surface, mirroring every edit in the dense form.
+            std::uniform_int_distribution<> xz(0, CHUNK_WIDTH - 1), dy(-6, 6), type(0, 2);
+            std::vector<int> positions(EDITS_PER_CHUNK * 4);
+            for (int edit = 0; edit < EDITS_PER_CHUNK; edit++)
+            {
+                int x = xz(gen), z = xz(gen);
+                int y = std::clamp(std::max(columns.getTopBlock(x, z), 0) + dy(gen), 0, CHUNK_HEIGHT - 1);
+                positions[edit * 4] = x;
+                positions[(edit * 4) + 1] = y;
+                positions[(edit * 4) + 2] = z;
+                positions[(edit * 4) + 3] = type(gen);
+            }
+            timeOperation(times.edits, [&]() {
+                for (int edit = 0; edit < EDITS_PER_CHUNK; edit++)
+                {
+                    columns.setBlock(positions[edit * 4], positions[(edit * 4) + 1], positions[(edit * 4) + 2],
+                                     palette[positions[(edit * 4) + 3]]);
+                }
+            });
+            for (int edit = 0; edit < EDITS_PER_CHUNK; edit++)
+            {
+                int blockIdx = (positions[(edit * 4) + 1] * CHUNK_SIZE) + (positions[(edit * 4) + 2] * CHUNK_WIDTH) + positions[edit * 4];
+                dense[blockIdx] = palette[positions[(edit * 4) + 3]];
+            }
+            columns.toDense(roundTrip.data());
+            failures += dense != roundTrip || countHeightMismatches(columns, dense) > 0 ? 1 : 0;
+        }
+    }
+
+    auto chunks = (double) numChunks;
+    printTime("fromTerrain", times.fromTerrain, chunks, "chunk");
+    printTime("toDense", times.toDense, chunks, "chunk");
+    printTime("fromDense", times.fromDense, chunks, "chunk");
+    printTime("toOccupancy", times.toOccupancy, chunks, "chunk");
+    printTime("encode", times.encode, chunks, "chunk");
+    printTime("decode", times.decode, chunks, "chunk");
+    std::cout << "blockExists: " << std::chrono::duration<double, std::nano>(times.queries).count() / (double) numQueries
+              << " ns/query" << std::endl;
+    printTime("setBlock", times.edits, chunks * EDITS_PER_CHUNK, "edit");
+    std::cout << "Runs: " << (double) numRuns / chunks << " per chunk" << std::endl;
+    std::cout << "Memory per chunk: columns " << (double) columnBytes / chunks << " B, encoded "
+              << (double) encodedBytes / chunks << " B, dense " << BLOCKS_IN_CHUNK * sizeof(BlockId) << " B, hash map ~"
+              << (double) solidBlocks * HASH_NODE_BYTES / chunks << " B" << std::endl;
+    if (failures > 0)
+    {
+        std::cerr << failures << " conversions did not round trip." << std::endl;
+        return -1;
+    }
+    return 0;
+}
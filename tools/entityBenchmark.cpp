@@ -0,0 +1,172 @@
+//
+// Times the entity store stepping a crowd of entities over generated terrain and checks the systems: entities that
+// collide with the ground stand on it or fall above it, and entities that do not follow the player's jump and fall
+// curves. A few entities are destroyed and created again every tick to exercise the packed rows.
+//
+// Usage: chunkcraft-entitybench [entities] [ticks]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "chunkSquare.hpp"
+#include "../src/craft/entities/entityStore.hpp"
+
+using namespace Craft;
+
+/// The number of chunks along each side of the generated square.
+const int GROUND_CHUNKS = 8;
+/// The milliseconds of a tick at 60 ticks a second.
+const float TICK_MILLIS = 1000.0f / 60.0f;
+/// One in this many entities does not collide with the ground and is checked against the curves instead.
+const int CURVE_ENTITY_RATIO = 16;
+/// The number of walking entities destroyed and created again every tick.
+const int CHURN_PER_TICK = 8;
+/// The walking speed of the player in blocks per millisecond, the speed the walkers wander at.
+const float WALKING_SPEED = 0.004317f;
+
+/// An entity following the jump and fall curves and the movement it is expected to have.
+struct CurveEntity
+{
+    EntityId id;
+    MovementState movement;
+    float startY;
+    float millis;
+};
+
+/// Retrieve the height of the ground under a bounding box the way the store's systems find it.
+static float getFootprintGround(const EntityGround& ground, glm::vec3 position, float halfWidth)
+{
+    float farSide = halfWidth - (float) EPSILON;
+    int minX = (int) std::floor(position.x - halfWidth), maxX = (int) std::floor(position.x + farSide);
+    int minZ = (int) std::floor(position.z - halfWidth), maxZ = (int) std::floor(position.z + farSide);
+    return (float) std::max(
+        std::max(ground.getHeight(minX, minZ), ground.getHeight(maxX, minZ)),
+        std::max(ground.getHeight(minX, maxZ), ground.getHeight(maxX, maxZ))
+    );
+}
+
+int main(int argc, char** argv)
+{
+    int numEntities = argc > 1 ? std::max(1, std::stoi(argv[1])) : 10000;
+    int numTicks = argc > 2 ? std::max(1, std::stoi(argv[2])) : 600;
+
+    ToolBlocks blocks{};
+    DensityField terrain(TOOL_TERRAIN_SEED);
+    EntityGround ground{};
+    ground.reset(0, 0, GROUND_CHUNKS * CHUNK_WIDTH);
+    for (int chunk = 0; chunk < GROUND_CHUNKS * GROUND_CHUNKS; chunk++)
+    {
+        int chunkX = chunk % GROUND_CHUNKS, chunkZ = chunk / GROUND_CHUNKS;
+        ChunkColumns columns{};
+        generateColumns(terrain, blocks, {chunkX, chunkZ}, columns);
+        for (int z = 0; z < CHUNK_WIDTH; z++)
+        {
+            for (int x = 0; x < CHUNK_WIDTH; x++)
+            {
+                int idx = (((chunkZ * CHUNK_WIDTH) + z) * ground.width) + (chunkX * CHUNK_WIDTH) + x;
+                ground.heights[idx] = columns.getTopBlock(x, z) + 1;
+            }
+        }
+    }
+
+    std::mt19937 gen(44);
+    std::uniform_real_distribution<float> xz(CHUNK_WIDTH, (float) (ground.width - CHUNK_WIDTH));
+    std::uniform_real_distribution<float> drop(0.0f, 24.0f), heading(0.0f, 2.0f * (float) M_PI);
+    EntityStore store{};
+    auto createWalker = [&]()
+    {
+        glm::vec3 position{xz(gen), 0.0f, xz(gen)};
+        position.y = getFootprintGround(ground, position, 0.3f) + drop(gen);
+        EntityId id = store.createEntity(position, 0.3f, 1.8f, MovementState::FALLING, COLLIDE_WITH_GROUND);
+        float angle = heading(gen);
+        store.setVelocity(id, glm::vec3{std::cos(angle), 0.0f, std::sin(angle)} * WALKING_SPEED);
+        return id;
+    };
+    std::vector<EntityId> walkers{};
+    std::vector<CurveEntity> curveEntities{};
+    for (int entity = 0; entity < numEntities; entity++)
+    {
+        if (entity % CURVE_ENTITY_RATIO != 0)
+        {
+            walkers.push_back(createWalker());
+            continue;
+        }
+        bool jumping = (entity / CURVE_ENTITY_RATIO) % 2 == 0;
+        MovementState movement = jumping ? MovementState::JUMPING : MovementState::FALLING;
+        float startY = std::floor(drop(gen)) + 64.0f;
+        EntityId id = store.createEntity(glm::vec3{xz(gen), startY, xz(gen)}, 0.3f, 1.8f, movement, 0);
+        curveEntities.push_back({id, movement, startY, 0.0f});
+    }
+
+    std::uniform_int_distribution<size_t> pickWalker(0, std::max<size_t>(walkers.size(), 1) - 1);
+    std::chrono::high_resolution_clock::duration updateTime{0};
+    long failures = 0;
+    for (int tick = 0; tick < numTicks; tick++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        store.update(TICK_MILLIS, ground);
+        updateTime += std::chrono::high_resolution_clock::now() - start;
+
+        for (EntityId id: walkers)
+        {
+            glm::vec3 position = store.getPosition(id);
+            float groundY = getFootprintGround(ground, position, 0.3f);
+            MovementState movement = store.getMovement(id);
+            bool onGround = position.y >= groundY && position.y <= groundY + GROUND_TOLERANCE;
+            if ((movement == MovementState::STATIONARY && !onGround) ||
+                (movement == MovementState::FALLING && position.y <= groundY))
+            {
+                std::cerr << "Tick " << tick << " left entity " << id << " at y " << position.y << " over ground "
+                          << groundY << "." << std::endl;
+                failures++;
+            }
+        }
+        for (CurveEntity& entity: curveEntities)
+        {
+            entity.millis += TICK_MILLIS;
+            float expectedY = EntityStore::getCurveHeight(entity.movement, entity.startY, entity.millis);
+            if (entity.movement == MovementState::JUMPING && expectedY >= entity.startY + JUMP_HEIGHT)
+            {
+                expectedY = entity.startY + JUMP_HEIGHT;
+                entity.movement = MovementState::FALLING;
+                entity.startY = expectedY;
+                entity.millis = 0.0f;
+            }
+            float y = store.getPosition(entity.id).y;
+            bool offCurve = std::abs(y - expectedY) > 1e-3f + (1e-5f * std::abs(y));
+            if (store.getMovement(entity.id) != entity.movement || offCurve)
+            {
+                std::cerr << "Tick " << tick << " moved entity " << entity.id << " to y " << y << " instead of "
+                          << expectedY << "." << std::endl;
+                failures++;
+            }
+        }
+        for (int churn = 0; churn < CHURN_PER_TICK && !walkers.empty(); churn++)
+        {
+            EntityId& id = walkers[pickWalker(gen)];
+            if (!store.destroyEntity(id))
+            {
+                std::cerr << "Tick " << tick << " could not destroy entity " << id << "." << std::endl;
+                failures++;
+            }
+            id = createWalker();
+        }
+        if (failures > 0) break;
+    }
+
+    double updateMicros = std::chrono::duration<double, std::micro>(updateTime).count() / numTicks;
+    std::cout << "update: " << updateMicros << " us/tick for " << store.getNumEntities() << " entities, "
+              << updateMicros * 1000.0 / (double) store.getNumEntities() << " ns/entity" << std::endl;
+    if (failures > 0)
+    {
+        std::cerr << failures << " entity checks failed." << std::endl;
+        return -1;
+    }
+    return 0;
+}
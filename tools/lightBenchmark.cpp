@@ -0,0 +1,116 @@
+//
+// Times the light engine on a 3x3 square of generated chunks and checks that lighting the blocks incrementally after
+// random edits gives the same light as relighting every chunk from scratch, and that every chunk whose light changed
+// is reported.
+//
+// Usage: chunkcraft-lightbench [edits]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <memory>
+#include <algorithm>
+
+#include "chunkSquare.hpp"
+
+using namespace Craft;
+
+/// The number of edits between comparisons against lighting from scratch.
+const int EDITS_PER_CHECK = 16;
+
+/// Retrieve whether two chunks hold the same light.
+static bool sameLight(const ChunkLight& a, const ChunkLight& b)
+{
+    return a == b;
+}
+
+int main(int argc, char** argv)
+{
+    int numEdits = argc > 1 ? std::max(0, std::stoi(argv[1])) : 512;
+
+    ToolBlocks blocks{};
+    LightEngine engine(&blocks.registry);
+    DensityField terrain(TOOL_TERRAIN_SEED);
+
+    auto square = std::make_unique<ChunkSquare>();
+    auto reference = std::make_unique<ChunkSquare>();
+    generateSquare(terrain, blocks, *square);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+    {
+        engine.lightChunk(square->columns[chunk], square->light[chunk]);
+    }
+    auto lightTime = std::chrono::high_resolution_clock::now() - start;
+    start = std::chrono::high_resolution_clock::now();
+    for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+    {
+        engine.propagateBorders(getNeighborhood(*square, chunk));
+    }
+    auto borderTime = std::chrono::high_resolution_clock::now() - start;
+    size_t lightBytes = 0;
+    for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+    {
+        lightBytes += square->light[chunk].getMemoryUsage();
+    }
+
+    // Dig, build and place lamps around the surface of the center chunk.
+    std::mt19937 gen(44);
+    std::uniform_int_distribution<> xz(0, CHUNK_WIDTH - 1), dy(-6, 6), type(0, 9);
+    LightNeighborhood center = getNeighborhood(*square, LIGHT_CENTER_CHUNK);
+    std::vector<ChunkLight> before(LIGHT_NEIGHBORHOOD_CHUNKS);
+    std::chrono::high_resolution_clock::duration editTime{0};
+    long failures = 0;
+    for (int edit = 0; edit < numEdits; edit++)
+    {
+        ChunkColumns& columns = square->columns[LIGHT_CENTER_CHUNK];
+        int x = xz(gen), z = xz(gen);
+        int y = std::clamp(std::max(columns.getTopBlock(x, z), 0) + dy(gen), 0, CHUNK_HEIGHT - 1);
+        int blockType = type(gen);
+        BlockId id = blockType < 5 ? AIR_BLOCK_ID : blockType < 9 ? blocks.stoneId : blocks.lampId;
+        if (!columns.setBlock(x, y, z, id)) continue;
+
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++) before[chunk] = square->light[chunk];
+        start = std::chrono::high_resolution_clock::now();
+        uint16_t changed = engine.updateBlock(center, {x, y, z});
+        editTime += std::chrono::high_resolution_clock::now() - start;
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            if (((changed >> chunk) & 1) == 0 && !sameLight(before[chunk], square->light[chunk]))
+            {
+                std::cerr << "Edit " << edit << " changed chunk " << chunk << " without reporting it." << std::endl;
+                failures++;
+            }
+        }
+
+        if ((edit + 1) % EDITS_PER_CHECK != 0 && edit + 1 != numEdits) continue;
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++) reference->columns[chunk] = square->columns[chunk];
+        lightFromScratch(engine, *reference);
+        for (int chunk = 0; chunk < LIGHT_NEIGHBORHOOD_CHUNKS; chunk++)
+        {
+            if (!sameLight(reference->light[chunk], square->light[chunk]))
+            {
+                std::cerr << "After edit " << edit << " chunk " << chunk << " differs from lighting from scratch." << std::endl;
+                failures++;
+            }
+        }
+    }
+
+    std::cout << "lightChunk: " << std::chrono::duration<double, std::micro>(lightTime).count() / LIGHT_NEIGHBORHOOD_CHUNKS
+              << " us/chunk" << std::endl;
+    std::cout << "propagateBorders: "
+              << std::chrono::duration<double, std::micro>(borderTime).count() / LIGHT_NEIGHBORHOOD_CHUNKS << " us/chunk"
+              << std::endl;
+    std::cout << "light storage: " << lightBytes / LIGHT_NEIGHBORHOOD_CHUNKS << " bytes/chunk" << std::endl;
+    std::cout << "updateBlock: " << std::chrono::duration<double, std::micro>(editTime).count() / std::max(numEdits, 1)
+              << " us/edit" << std::endl;
+    if (failures > 0)
+    {
+        std::cerr << failures << " light checks failed." << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+//
+// Compares the bitmask face extractor against the per-side blocksMap walk it replaced in World::updateInstanceIdxVBO.
+//
+// Usage: chunkcraft-meshbench [iterations]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../src/craft/worldGeneration/block.hpp"
+#include "../src/craft/worldGeneration/faceExtractor.hpp"
+
+using namespace Craft;
+
+/// A small deterministic hash used to shape the synthetic terrain.
+static uint32_t hash(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * Write the side visibility bits into sideData the way neighbor.comp does, using the extractor's conventions for
+ * the world borders (no neighboring chunks, solid below the world).
+ */
+static void computeSideData(const ChunkOccupancy& occupancy, std::vector<NeighborInfo>& visibility)
+{
+    auto exists = [&occupancy](int x, int y, int z)
+    {
+        if (y < 0) return true;
+        if (x < 0 || x >= CHUNK_WIDTH || z < 0 || z >= CHUNK_WIDTH || y >= CHUNK_HEIGHT) return false;
+        return occupancy.test(x, y, z);
+    };
+    for (int y = 0; y < CHUNK_HEIGHT; y++)
+    {
+        for (int z = 0; z < CHUNK_WIDTH; z++)
+        {
+            for (int x = 0; x < CHUNK_WIDTH; x++)
+            {
+                int idx = (y * CHUNK_SIZE) + (z * CHUNK_WIDTH) + x;
+                if (!occupancy.test(x, y, z))
+                {
+                    visibility[idx].sideData = 0;
+                    continue;
+                }
+                int sideData = 1;
+                sideData |= exists(x, y + 1, z) ? 0 : 2;
+                sideData |= exists(x, y - 1, z) ? 0 : 4;
+                sideData |= exists(x + 1, y, z) ? 0 : 8;
+                sideData |= exists(x - 1, y, z) ? 0 : 16;
+                sideData |= exists(x, y, z + 1) ? 0 : 32;
+                sideData |= exists(x, y, z - 1) ? 0 : 64;
+                visibility[idx].sideData = sideData;
+            }
+        }
+    }
+}
+
+/// The per-side walk over blocksMap previously used to build the instance lists.
+static void extractFacesFromSideData(
+        const std::unordered_map<Coordinate<int>, BlockId>& blocksMap,
+        const NeighborInfo* visibility,
+        int* output,
+        int* counts
+    )
+{
+    for (int side = 0; side < SIDES_PER_BLOCK; side++)
+    {
+        counts[side] = 0;
+        for (auto& block: blocksMap)
+        {
+            int blockIdx = (block.first.y * CHUNK_SIZE) + (block.first.z * CHUNK_WIDTH) + block.first.x;
+            NeighborInfo info = visibility[blockIdx];
+            if ((info.sideData & 1) == 1 && ((info.sideData >> (side + 1)) & 1) == 1)
+            {
+                output[(side * BLOCKS_IN_CHUNK) + counts[side]] = blockIdx;
+                counts[side] += 1;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::max(1, std::stoi(argv[1])) : 200;
+
+    // Build a chunk resembling generated terrain, with a few caves so rows are not all solid.
+    ChunkOccupancy occupancy{};
+    std::unordered_map<Coordinate<int>, BlockId> blocksMap{};
+    for (int x = 0; x < CHUNK_WIDTH; x++)
+    {
+        for (int z = 0; z < CHUNK_WIDTH; z++)
+        {
+            int height = CHUNK_BASE_HEIGHT - 7 + (int) (hash((x * 31) + (z * 977)) % 15);
+            for (int y = 0; y < height; y++)
+            {
+                if (y > 20 && hash((y * 65537) + (z * 257) + x) % 11 == 0) continue;
+                occupancy.set(x, y, z);
+                blocksMap.emplace(Coordinate<int>{x, y, z}, (BlockId) 1);
+            }
+        }
+    }
+    std::vector<NeighborInfo> visibility(BLOCKS_IN_CHUNK);
+    computeSideData(occupancy, visibility);
+
+    std::vector<int> legacyOutput(SIDES_PER_BLOCK * BLOCKS_IN_CHUNK);
+    std::vector<int> bitmaskOutput(SIDES_PER_BLOCK * BLOCKS_IN_CHUNK);
+    int legacyCounts[SIDES_PER_BLOCK];
+    int bitmaskCounts[SIDES_PER_BLOCK];
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        extractFacesFromSideData(blocksMap, visibility.data(), legacyOutput.data(), legacyCounts);
+    }
+    auto legacyTime = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        extractFaces(occupancy, ChunkNeighborOccupancy{}, 0, bitmaskOutput.data(), BLOCKS_IN_CHUNK, bitmaskCounts);
+    }
+    auto bitmaskTime = std::chrono::high_resolution_clock::now() - start;
+
+    // Both extractors must produce the same instances, in any order.
+    bool matches = true;
+    int totalFaces = 0;
+    for (int side = 0; side < SIDES_PER_BLOCK; side++)
+    {
+        auto legacyBegin = legacyOutput.begin() + (side * BLOCKS_IN_CHUNK);
+        auto bitmaskBegin = bitmaskOutput.begin() + (side * BLOCKS_IN_CHUNK);
+        std::sort(legacyBegin, legacyBegin + legacyCounts[side]);
+        std::sort(bitmaskBegin, bitmaskBegin + bitmaskCounts[side]);
+        matches &= legacyCounts[side] == bitmaskCounts[side] &&
+                   std::equal(legacyBegin, legacyBegin + legacyCounts[side], bitmaskBegin);
+        totalFaces += bitmaskCounts[side];
+    }
+
+    double legacyMs = std::chrono::duration<double, std::milli>(legacyTime).count() / iterations;
+    double bitmaskMs = std::chrono::duration<double, std::milli>(bitmaskTime).count() / iterations;
+    std::cout << "Blocks: " << blocksMap.size() << ", visible faces: " << totalFaces << std::endl;
+    std::cout << "blocksMap walk: " << legacyMs << " ms/chunk" << std::endl;
+    std::cout << "Bitmask extractor: " << bitmaskMs << " ms/chunk (" << legacyMs / bitmaskMs << "x)" << std::endl;
+    if (!matches)
+    {
+        std::cerr << "Extractors produced different faces." << std::endl;
+        return -1;
+    }
+    return 0;
+}
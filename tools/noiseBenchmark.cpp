@@ -0,0 +1,265 @@
+//
+// Compares the gather-free simplex noise backend against the Perlin backend, both per kernel call and on the terrain
+// the density field generates with each. Writes a heightmap of both terrains for visual comparison.
+//
+// Usage: chunkcraft-noisebench [chunk radius]
+//
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <immintrin.h>
+
+#include "../src/helpers/noise.hpp"
+#include "../src/helpers/arena.hpp"
+#include "../src/craft/worldGeneration/densityField.hpp"
+
+using namespace Craft;
+
+/// The number of kernel calls timed per backend.
+const int KERNEL_ITERATIONS = 1 << 18;
+
+/// The distribution of a set of samples.
+struct SampleStats
+{
+    double mean{0.0};
+    double stdDev{0.0};
+    double min{0.0};
+    double max{0.0};
+};
+/// The terrain statistics compared between backends.
+struct TerrainStats
+{
+    /// The distribution of the highest solid block of every column.
+    SampleStats surface{};
+    /// The fraction of the world's blocks that are solid.
+    double solidFraction{0.0};
+    /// The fraction of columns with air below their highest solid block.
+    double overhangFraction{0.0};
+    /// The mean time to generate a chunk's occupancy.
+    double msPerChunk{0.0};
+};
+
+/// Accumulates samples into SampleStats.
+struct StatsAccumulator
+{
+    double sum{0.0};
+    double sumSquared{0.0};
+    double min{INFINITY};
+    double max{-INFINITY};
+    long count{0};
+
+    inline void add(double value)
+    {
+        sum += value;
+        sumSquared += value * value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+        count++;
+    }
+    [[nodiscard]] SampleStats finish() const
+    {
+        double mean = sum / (double) count;
+        return {mean, std::sqrt(std::max(0.0, (sumSquared / (double) count) - (mean * mean))), min, max};
+    }
+};
+
+/**
+ * Time a noise kernel and gather the distribution of its output.
+ *
+ * @param kernel: Evaluates the kernel on 8 sample positions, given the index of the call.
+ * @param stats:  The distribution of the output.
+ * @return:       The time per sample, in nanoseconds.
+ */
+template<class Kernel>
+static double benchmarkKernel(Kernel kernel, SampleStats& stats)
+{
+    StatsAccumulator accumulator{};
+    alignas(32) float results[8];
+    __m256 checksum = _mm256_setzero_ps();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < KERNEL_ITERATIONS; iteration++)
+    {
+        checksum = _mm256_add_ps(checksum, kernel(iteration));
+    }
+    auto time = std::chrono::high_resolution_clock::now() - start;
+    // Sample the distribution outside of the timed loop.
+    for (int iteration = 0; iteration < KERNEL_ITERATIONS; iteration += 7)
+    {
+        _mm256_store_ps(results, kernel(iteration));
+        for (float result: results) accumulator.add(result);
+    }
+    _mm256_store_ps(results, checksum);
+    if (std::isnan(results[0])) std::cerr << "Kernel produced NaN." << std::endl;
+    stats = accumulator.finish();
+    return std::chrono::duration<double, std::nano>(time).count() / (KERNEL_ITERATIONS * 8.0);
+}
+
+/**
+ * Generate a square of chunks with the given backend, gathering the terrain statistics and its heightmap.
+ *
+ * @param backend:   The noise backend to generate with.
+ * @param radius:    The number of chunks generated on each side of the origin.
+ * @param heightmap: The height of every column, row major from the lowest x and z.
+ * @return:          The statistics of the terrain.
+ */
+static TerrainStats generateTerrain(NoiseBackend backend, int radius, std::vector<int>& heightmap)
+{
+    DensityField terrain(44, backend);
+    int width = ((2 * radius) + 1) * CHUNK_WIDTH;
+    heightmap.assign((size_t) width * width, 0);
+    StatsAccumulator surface{};
+    long solidBlocks = 0;
+    long overhangs = 0;
+    std::chrono::high_resolution_clock::duration generationTime{0};
+    for (int chunkX = -radius; chunkX <= radius; chunkX++)
+    {
+        for (int chunkZ = -radius; chunkZ <= radius; chunkZ++)
+        {
+            Engine::getWorkerArena().reset();
+            ChunkOccupancy occupancy{};
+            auto start = std::chrono::high_resolution_clock::now();
+            terrain.generate({chunkX, chunkZ}, occupancy);
+            generationTime += std::chrono::high_resolution_clock::now() - start;
+
+            for (int z = 0; z < CHUNK_WIDTH; z++)
+            {
+                for (int x = 0; x < CHUNK_WIDTH; x++)
+                {
+                    int top = -1;
+                    int solidInColumn = 0;
+                    for (int y = 0; y < CHUNK_HEIGHT; y++)
+                    {
+                        if (!occupancy.test(x, y, z)) continue;
+                        top = y;
+                        solidInColumn++;
+                    }
+                    solidBlocks += solidInColumn;
+                    overhangs += solidInColumn < top + 1 ? 1 : 0;
+                    surface.add(top);
+                    int mapX = ((chunkX + radius) * CHUNK_WIDTH) + x;
+                    int mapZ = ((chunkZ + radius) * CHUNK_WIDTH) + z;
+                    heightmap[((size_t) mapZ * width) + mapX] = top;
+                }
+            }
+        }
+    }
+    auto numColumns = (double) surface.count;
+    TerrainStats stats{};
+    stats.surface = surface.finish();
+    stats.solidFraction = (double) solidBlocks / (numColumns * CHUNK_HEIGHT);
+    stats.overhangFraction = (double) overhangs / numColumns;
+    stats.msPerChunk = std::chrono::duration<double, std::milli>(generationTime).count() / (numColumns / CHUNK_SIZE);
+    return stats;
+}
+
+/**
+ * Write a heightmap as a binary PGM image, scaled to the range of heights the terrain spans.
+ *
+ * @param path:      The path of the image.
+ * @param heightmap: The height of every column.
+ * @param width:     The width and height of the image.
+ * @param low:       The height drawn black.
+ * @param high:      The height drawn white.
+ * @return:          True if the image was written, else false.
+ */
+static bool writeHeightmap(const std::string& path, const std::vector<int>& heightmap, int width, int low, int high)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    file << "P5\n" << width << " " << width << "\n255\n";
+    for (int height: heightmap)
+    {
+        double shade = (double) (height - low) / std::max(1, high - low);
+        file.put((char) (uint8_t) std::clamp(shade * 255.0, 0.0, 255.0));
+    }
+    return true;
+}
+
+static void printStats(const char* name, const SampleStats& stats)
+{
+    std::cout << name << ": mean " << stats.mean << ", stddev " << stats.stdDev
+              << ", range [" << stats.min << ", " << stats.max << "]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int radius = argc > 1 ? std::max(1, std::stoi(argv[1])) : 8;
+
+    Noise perlin(44, NoiseBackend::PERLIN);
+    Noise simplex(44, NoiseBackend::SIMPLEX);
+    // Walk the sample positions through the noise so every call hits different lattice cells.
+    const __m256 lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    auto position = [&lanes](int iteration, float scale)
+    {
+        return _mm256_mul_ps(_mm256_add_ps(lanes, _mm256_set1_ps((float) (iteration % 4096) * 8.0f)),
+                             _mm256_set1_ps(scale));
+    };
+    SampleStats perlinStats{}, simplex3DStats{}, simplex2DStats{};
+    double perlinNs = benchmarkKernel([&](int iteration) {
+        return perlin._mm256_noise_ps(
+                position(iteration, 0.173f), _mm256_set1_ps((float) (iteration >> 12) * 0.61f), position(iteration, 0.0917f)
+            );
+    }, perlinStats);
+    double simplex3DNs = benchmarkKernel([&](int iteration) {
+        return simplex._mm256_simplex3D_ps(
+                position(iteration, 0.173f), _mm256_set1_ps((float) (iteration >> 12) * 0.61f), position(iteration, 0.0917f)
+            );
+    }, simplex3DStats);
+    double simplex2DNs = benchmarkKernel([&](int iteration) {
+        return simplex._mm256_simplex2D_ps(
+                position(iteration, 0.173f), _mm256_add_ps(position(iteration, 0.0917f), _mm256_set1_ps((float) (iteration >> 12) * 0.61f))
+            );
+    }, simplex2DStats);
+
+    std::cout << "Perlin 3D: " << perlinNs << " ns/sample" << std::endl;
+    std::cout << "Simplex 3D: " << simplex3DNs << " ns/sample (" << perlinNs / simplex3DNs << "x)" << std::endl;
+    std::cout << "Simplex 2D: " << simplex2DNs << " ns/sample (" << perlinNs / simplex2DNs << "x)" << std::endl;
+    printStats("Perlin 3D output", perlinStats);
+    printStats("Simplex 3D output", simplex3DStats);
+    printStats("Simplex 2D output", simplex2DStats);
+
+    // Generate the same area with both backends.
+    int width = ((2 * radius) + 1) * CHUNK_WIDTH;
+    std::vector<int> perlinHeights, simplexHeights;
+    TerrainStats perlinTerrain = generateTerrain(NoiseBackend::PERLIN, radius, perlinHeights);
+    TerrainStats simplexTerrain = generateTerrain(NoiseBackend::SIMPLEX, radius, simplexHeights);
+    for (int backend = 0; backend < NUM_NOISE_BACKENDS; backend++)
+    {
+        const TerrainStats& stats = backend == (int) NoiseBackend::PERLIN ? perlinTerrain : simplexTerrain;
+        std::cout << NOISE_BACKEND_NAMES[backend] << " terrain: " << stats.msPerChunk << " ms/chunk, surface mean "
+                  << stats.surface.mean << " stddev " << stats.surface.stdDev << " range [" << stats.surface.min
+                  << ", " << stats.surface.max << "], solid " << stats.solidFraction * 100.0 << "%, overhangs "
+                  << stats.overhangFraction * 100.0 << "% of columns" << std::endl;
+    }
+    int low = (int) std::min(perlinTerrain.surface.min, simplexTerrain.surface.min);
+    int high = (int) std::max(perlinTerrain.surface.max, simplexTerrain.surface.max);
+    if (!writeHeightmap("noise_perlin.pgm", perlinHeights, width, low, high) ||
+        !writeHeightmap("noise_simplex.pgm", simplexHeights, width, low, high))
+    {
+        return -1;
+    }
+    std::cout << "Wrote noise_perlin.pgm and noise_simplex.pgm." << std::endl;
+
+    // The backends differ in detail, but must generate terrain of the same character.
+    bool equivalent = true;
+    equivalent &= std::abs(perlinTerrain.surface.mean - simplexTerrain.surface.mean) < 2.0;
+    equivalent &= simplexTerrain.surface.stdDev > perlinTerrain.surface.stdDev * 0.5 &&
+                  simplexTerrain.surface.stdDev < perlinTerrain.surface.stdDev * 2.0;
+    equivalent &= std::abs(perlinTerrain.solidFraction - simplexTerrain.solidFraction) < 0.02;
+    equivalent &= simplexTerrain.surface.max < CHUNK_HEIGHT - 1 && simplexTerrain.surface.min > 0;
+    if (!equivalent)
+    {
+        std::cerr << "The simplex terrain differs from the Perlin terrain beyond tolerance." << std::endl;
+        return -1;
+    }
+    return 0;
+}
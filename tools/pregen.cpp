@@ -0,0 +1,227 @@
+//
+// Pre-generates a square of chunks across every core and writes them as region files, so a server does not pay the
+// cost of generating terrain while players explore. Regions already written with the same seed and noise backend are
+// skipped, so an interrupted run resumes where it stopped.
+//
+// Usage: chunkcraft-pregen <output directory> <chunk radius> [--seed <n>] [--noise perlin|simplex]
+//                          [--center <chunk x> <chunk z>] [--threads <n>]
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <deque>
+#include <string>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+
+#include "../src/helpers/arena.hpp"
+#include "../src/helpers/threadPool.hpp"
+#include "../src/craft/worldGeneration/densityField.hpp"
+#include "../src/craft/worldGeneration/chunkColumns.hpp"
+#include "../src/craft/worldGeneration/regionFile.hpp"
+
+using namespace Craft;
+
+/// The number of regions whose chunks may be queued at once, so the workers never idle while a region is written.
+const size_t REGIONS_IN_FLIGHT = 2;
+
+/// A region whose chunks are being generated.
+struct PendingRegion
+{
+    Coordinate2D<int> regionPos{0, 0};
+    /// The encoded columns of each chunk, indexed by the chunk's position within the region.
+    std::vector<std::future<std::vector<uint8_t>>> chunks{};
+};
+
+/**
+ * Find the noise backend with the given name.
+ *
+ * @param name:    The name of the backend, as in NOISE_BACKEND_NAMES.
+ * @param backend: Set to the backend if found.
+ * @return:        True if a backend has the given name, else false.
+ */
+static bool parseNoiseBackend(const std::string& name, NoiseBackend& backend)
+{
+    for (int idx=0; idx<NUM_NOISE_BACKENDS; idx++)
+    {
+        if (name != NOISE_BACKEND_NAMES[idx]) continue;
+        backend = (NoiseBackend) idx;
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <output directory> <chunk radius> [--seed <n>] [--noise perlin|simplex]"
+                  << " [--center <chunk x> <chunk z>] [--threads <n>]" << std::endl;
+        return -1;
+    }
+    std::filesystem::path directory = argv[1];
+    int radius = std::max(0, std::stoi(argv[2]));
+    uint32_t seed = 44;
+    NoiseBackend backend = NoiseBackend::PERLIN;
+    Coordinate2D<int> center{0, 0};
+    size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int arg=3; arg<argc; arg++)
+    {
+        std::string option = argv[arg];
+        if (option == "--seed" && arg + 1 < argc)
+        {
+            seed = (uint32_t) std::stoul(argv[++arg]);
+        }
+        else if (option == "--noise" && arg + 1 < argc && parseNoiseBackend(argv[arg + 1], backend))
+        {
+            arg++;
+        }
+        else if (option == "--center" && arg + 2 < argc)
+        {
+            center = {std::stoi(argv[arg + 1]), std::stoi(argv[arg + 2])};
+            arg += 2;
+        }
+        else if (option == "--threads" && arg + 1 < argc)
+        {
+            numThreads = std::max(1, std::stoi(argv[++arg]));
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return -1;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Failed to create directory: " << directory << " (" << error.message() << ")" << std::endl;
+        return -1;
+    }
+    // Writes interrupted before their rename leave partial files behind.
+    for (const auto& entry: std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() == ".tmp") std::filesystem::remove(entry.path(), error);
+    }
+
+    // Find the regions overlapping the square, skipping those a previous run completed.
+    Coordinate2D<int> minChunk{center.x - radius, center.z - radius};
+    Coordinate2D<int> maxChunk{center.x + radius, center.z + radius};
+    Coordinate2D<int> minRegion = getRegionPos(minChunk);
+    Coordinate2D<int> maxRegion = getRegionPos(maxChunk);
+    std::vector<Coordinate2D<int>> regions{};
+    long totalChunks = 0;
+    long resumedChunks = 0;
+    for (int regionX = minRegion.x; regionX <= maxRegion.x; regionX++)
+    {
+        for (int regionZ = minRegion.z; regionZ <= maxRegion.z; regionZ++)
+        {
+            Coordinate2D<int> regionMin{std::max(minChunk.x, regionX * REGION_WIDTH), std::max(minChunk.z, regionZ * REGION_WIDTH)};
+            Coordinate2D<int> regionMax{
+                std::min(maxChunk.x, ((regionX + 1) * REGION_WIDTH) - 1), std::min(maxChunk.z, ((regionZ + 1) * REGION_WIDTH) - 1)
+            };
+            long regionChunks = (long) (regionMax.x - regionMin.x + 1) * (regionMax.z - regionMin.z + 1);
+            totalChunks += regionChunks;
+
+            // A region is complete if it was generated from the same terrain and stores every chunk in the square.
+            RegionFileHeader existing{};
+            std::vector<RegionChunkEntry> existingChunks{};
+            bool complete = readRegionHeader(getRegionPath(directory, {regionX, regionZ}), existing, &existingChunks) &&
+                            existing.seed == seed && existing.noiseBackend == (uint32_t) backend;
+            for (int chunkX = regionMin.x; complete && chunkX <= regionMax.x; chunkX++)
+            {
+                for (int chunkZ = regionMin.z; complete && chunkZ <= regionMax.z; chunkZ++)
+                {
+                    complete = existingChunks[getRegionChunkIdx({chunkX, chunkZ})].size != 0;
+                }
+            }
+            if (complete)
+            {
+                resumedChunks += regionChunks;
+                continue;
+            }
+            regions.emplace_back(regionX, regionZ);
+        }
+    }
+    std::cout << "Generating " << totalChunks - resumedChunks << " of " << totalChunks << " chunks in "
+              << regions.size() << " regions on " << numThreads << " threads";
+    if (resumedChunks > 0) std::cout << ", resuming after " << resumedChunks << " chunks";
+    std::cout << "." << std::endl;
+
+    DensityField terrain(seed, backend);
+    ThreadPool pool(numThreads);
+    const std::vector<std::string> palette(std::begin(TERRAIN_PALETTE), std::end(TERRAIN_PALETTE));
+    const std::vector<BlockId> paletteIds{AIR_BLOCK_ID, TERRAIN_STONE_IDX, TERRAIN_GRASS_IDX};
+    std::deque<PendingRegion> pending{};
+    size_t nextRegion = 0;
+    long generatedChunks = 0;
+    uint64_t writtenBytes = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (nextRegion < regions.size() || !pending.empty())
+    {
+        // Queue the chunks of the next regions, so workers generate them while the oldest region is written.
+        while (nextRegion < regions.size() && pending.size() < REGIONS_IN_FLIGHT)
+        {
+            PendingRegion& region = pending.emplace_back();
+            region.regionPos = regions[nextRegion++];
+            region.chunks.resize(REGION_CHUNKS);
+            for (int localZ=0; localZ<REGION_WIDTH; localZ++)
+            {
+                for (int localX=0; localX<REGION_WIDTH; localX++)
+                {
+                    Coordinate2D<int> chunkPos{
+                        (region.regionPos.x * REGION_WIDTH) + localX, (region.regionPos.z * REGION_WIDTH) + localZ
+                    };
+                    if (chunkPos.x < minChunk.x || chunkPos.x > maxChunk.x || chunkPos.z < minChunk.z || chunkPos.z > maxChunk.z)
+                    {
+                        continue;
+                    }
+                    region.chunks[(localZ * REGION_WIDTH) + localX] = pool.enqueue([&terrain, &paletteIds, chunkPos]() {
+                        Engine::getWorkerArena().reset();
+                        ChunkOccupancy occupancy{};
+                        terrain.generate(chunkPos, occupancy);
+                        ChunkColumns columns{};
+                        columns.fromTerrain(occupancy, TERRAIN_GRASS_IDX, TERRAIN_STONE_IDX);
+                        std::vector<uint8_t> encoded{};
+                        columns.encode(paletteIds, encoded);
+                        return encoded;
+                    });
+                }
+            }
+        }
+
+        PendingRegion region = std::move(pending.front());
+        pending.pop_front();
+        std::vector<std::vector<uint8_t>> chunks(REGION_CHUNKS);
+        for (int idx=0; idx<REGION_CHUNKS; idx++)
+        {
+            if (!region.chunks[idx].valid()) continue;
+            chunks[idx] = region.chunks[idx].get();
+            writtenBytes += chunks[idx].size();
+            generatedChunks++;
+        }
+        RegionFileHeader header{};
+        header.seed = seed;
+        header.noiseBackend = (uint32_t) backend;
+        header.regionX = region.regionPos.x;
+        header.regionZ = region.regionPos.z;
+        if (!writeRegionFile(getRegionPath(directory, region.regionPos), header, palette, chunks)) return -1;
+
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "Region (" << region.regionPos.x << ", " << region.regionPos.z << ") written, "
+                  << resumedChunks + generatedChunks << "/" << totalChunks << " chunks, "
+                  << (double) generatedChunks / seconds << " chunks/s" << std::endl;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Generated " << generatedChunks << " chunks in " << seconds << " s: "
+              << (generatedChunks > 0 ? (double) generatedChunks / seconds : 0.0) << " chunks/s, "
+              << (generatedChunks > 0 ? (double) generatedChunks / seconds / (double) numThreads : 0.0)
+              << " chunks/s per thread, " << (generatedChunks > 0 ? (double) writtenBytes / (double) generatedChunks : 0.0)
+              << " bytes/chunk (" << (double) writtenBytes / (1024.0 * 1024.0) << " MiB)." << std::endl;
+    return 0;
+}
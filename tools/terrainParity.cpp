@@ -0,0 +1,115 @@
+//
+// Checks that terrain.comp generates the same occupancy as the CPU density field, for both noise backends. Runs on an
+// invisible window, so it works on Mesa's llvmpipe where no GPU is available.
+//
+// Usage: chunkcraft-terrainparity [chunk radius]
+// Run from the build directory, like the game, so the shaders are found.
+//
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <immintrin.h>
+
+#include "../src/setup/window.hpp"
+#include "../src/setup/compute.hpp"
+#include "../src/helpers/arena.hpp"
+#include "../src/craft/worldGeneration/densityField.hpp"
+#include "../src/craft/worldGeneration/gpuTerrain.hpp"
+
+using namespace Craft;
+
+/// The fraction of blocks allowed to differ. Blocks on the isosurface may flip where the GPU fuses differently.
+const double MAX_MISMATCH_FRACTION = 1e-4;
+
+/**
+ * Generate a square of chunks on the GPU and on the CPU, counting the blocks whose occupancy differs.
+ *
+ * @param backend: The noise backend to generate with.
+ * @param radius:  The number of chunks generated on each side of the origin.
+ * @return:        True if the occupancy matches within MAX_MISMATCH_FRACTION, else false.
+ */
+static bool checkBackend(NoiseBackend backend, int radius)
+{
+    DensityField terrain(44, backend);
+    Engine::Compute terrainCompute("src/assets/shader/terrain.comp");
+    if (!terrainCompute.initCompute())
+    {
+        std::cerr << "Failed to initialize terrain compute." << std::endl;
+        return false;
+    }
+    GpuTerrain gpuTerrain(&terrainCompute, &terrain);
+    if (!gpuTerrain.initGpuTerrain()) return false;
+
+    std::vector<Coordinate2D<int>> positions{};
+    for (int chunkX = -radius; chunkX <= radius; chunkX++)
+    {
+        for (int chunkZ = -radius; chunkZ <= radius; chunkZ++)
+        {
+            positions.emplace_back(chunkX, chunkZ);
+        }
+    }
+    long mismatches = 0;
+    std::chrono::high_resolution_clock::duration gpuTime{0}, cpuTime{0};
+    ChunkOccupancy gpuOccupancy{};
+    for (size_t batchStart = 0; batchStart < positions.size(); batchStart += GPU_TERRAIN_BATCH)
+    {
+        std::vector<Coordinate2D<int>> batch(
+                positions.begin() + (long) batchStart,
+                positions.begin() + (long) std::min(positions.size(), batchStart + GPU_TERRAIN_BATCH)
+            );
+        auto start = std::chrono::high_resolution_clock::now();
+        gpuTerrain.dispatch(batch);
+        if (!gpuTerrain.pollBatch(true))
+        {
+            std::cerr << "terrain.comp never finished its batch." << std::endl;
+            return false;
+        }
+        gpuTime += std::chrono::high_resolution_clock::now() - start;
+
+        for (size_t batchIdx = 0; batchIdx < batch.size(); batchIdx++)
+        {
+            gpuTerrain.readOccupancy(batchIdx, gpuOccupancy);
+            Engine::getWorkerArena().reset();
+            ChunkOccupancy cpuOccupancy{};
+            start = std::chrono::high_resolution_clock::now();
+            terrain.generate(batch[batchIdx], cpuOccupancy);
+            cpuTime += std::chrono::high_resolution_clock::now() - start;
+            for (int row = 0; row < CHUNK_HEIGHT * CHUNK_WIDTH; row++)
+            {
+                mismatches += _mm_popcnt_u32(gpuOccupancy.rows[row] ^ cpuOccupancy.rows[row]);
+            }
+        }
+        gpuTerrain.releaseBatch();
+    }
+
+    auto numChunks = (double) positions.size();
+    double mismatchFraction = (double) mismatches / (numChunks * BLOCKS_IN_CHUNK);
+    std::cout << NOISE_BACKEND_NAMES[(int) backend] << ": " << mismatches << " of "
+              << (long) (numChunks * BLOCKS_IN_CHUNK) << " blocks differ, GPU "
+              << std::chrono::duration<double, std::milli>(gpuTime).count() / numChunks << " ms/chunk, CPU "
+              << std::chrono::duration<double, std::milli>(cpuTime).count() / numChunks << " ms/chunk" << std::endl;
+    if (mismatchFraction > MAX_MISMATCH_FRACTION)
+    {
+        std::cerr << "terrain.comp differs from the CPU density field beyond tolerance." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int radius = argc > 1 ? std::max(0, std::stoi(argv[1])) : 2;
+    Engine::Window window(64, 64, "ChunkCraft terrain parity", true);
+    if (!window.initWindow()) return -1;
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+
+    bool matches = true;
+    for (int backend = 0; backend < NUM_NOISE_BACKENDS; backend++)
+    {
+        matches &= checkBackend((NoiseBackend) backend, radius);
+    }
+    return matches ? 0 : -1;
+}
@@ -0,0 +1,160 @@
+//
+// Offline packer for the pre-baked texture bundle loaded by Craft::Textures.
+//
+// Usage (from the build directory, like the game): chunkcraft-texpack [output]
+//
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <stb/stb_image.h>
+#include "nlohmann/json.hpp"
+
+#include "../src/craft/misc/textureBundle.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * Halve an RGBA8 image with a 2x2 box filter.
+ *
+ * @param src:       The pixels of the source level.
+ * @param srcWidth:  The width of the source level.
+ * @param srcHeight: The height of the source level.
+ * @return:          The pixels of the next level.
+ */
+static std::vector<unsigned char> downsample(const std::vector<unsigned char>& src, uint32_t srcWidth, uint32_t srcHeight)
+{
+    uint32_t width = std::max(srcWidth >> 1, 1u);
+    uint32_t height = std::max(srcHeight >> 1, 1u);
+    std::vector<unsigned char> dst(width * height * 4);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        uint32_t y0 = std::min(y * 2, srcHeight - 1), y1 = std::min(y * 2 + 1, srcHeight - 1);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint32_t x0 = std::min(x * 2, srcWidth - 1), x1 = std::min(x * 2 + 1, srcWidth - 1);
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                uint32_t sum = src[(y0 * srcWidth + x0) * 4 + c] + src[(y0 * srcWidth + x1) * 4 + c] +
+                               src[(y1 * srcWidth + x0) * 4 + c] + src[(y1 * srcWidth + x1) * 4 + c];
+                dst[(y * width + x) * 4 + c] = (unsigned char) ((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+int main(int argc, char** argv)
+{
+    std::string outputPath = argc > 1 ? argv[1] : Craft::TEXTURE_BUNDLE_PATH;
+    std::filesystem::path root = std::filesystem::current_path().parent_path();
+
+    std::ifstream mappingFile(root / Craft::TEXTURE_MAPPING_PATH);
+    if (!mappingFile.is_open())
+    {
+        std::cerr << "Failed to open file: " << Craft::TEXTURE_MAPPING_PATH << std::endl;
+        return -1;
+    }
+    json textureMappingJSON = json::parse(mappingFile);
+
+    std::vector<Craft::TextureBundleSource> sources{};
+    std::vector<Craft::TextureBundleMapping> mappings{};
+    // levels[mip][layer] holds the pixels of one layer of one mip level.
+    std::vector<std::vector<std::vector<unsigned char>>> levels{};
+    Craft::TextureBundleHeader header{};
+
+    Craft::TextureBundleSource mappingSource{};
+    Craft::stampBundleSource(Craft::TEXTURE_MAPPING_PATH, mappingSource);
+    sources.push_back(mappingSource);
+
+    uint32_t layer = 0;
+    for (auto iter = textureMappingJSON.begin(); iter != textureMappingJSON.end(); iter++, layer++)
+    {
+        const std::string& filepath = iter.key();
+        int width, height, nrChannels;
+        unsigned char* data = stbi_load((root / filepath).string().c_str(), &width, &height, &nrChannels, STBI_rgb_alpha);
+        if (!data)
+        {
+            std::cerr << "Failed to load texture: " << filepath << std::endl;
+            return -1;
+        }
+        if (layer == 0)
+        {
+            header.width = width;
+            header.height = height;
+            header.numMips = 1;
+            while ((std::max(header.width, header.height) >> header.numMips) > 0) header.numMips++;
+            levels.resize(header.numMips);
+        }
+        else if (header.width != (uint32_t) width || header.height != (uint32_t) height)
+        {
+            std::cerr << "Texture " << filepath << " is " << width << "x" << height << ", expected "
+                      << header.width << "x" << header.height << std::endl;
+            stbi_image_free(data);
+            return -1;
+        }
+
+        std::vector<unsigned char> level(data, data + width * height * 4);
+        stbi_image_free(data);
+        for (uint32_t mip = 0; mip < header.numMips; mip++)
+        {
+            if (mip > 0)
+            {
+                level = downsample(level, std::max(header.width >> (mip - 1), 1u), std::max(header.height >> (mip - 1), 1u));
+            }
+            levels[mip].push_back(level);
+        }
+
+        Craft::TextureBundleSource source{};
+        Craft::stampBundleSource(filepath, source);
+        sources.push_back(source);
+
+        for (auto info = iter.value().begin(); info != iter.value().end(); info++)
+        {
+            for (const auto& blockFaceValue: info.value())
+            {
+                const std::string blockFace = blockFaceValue.get<std::string>();
+                Craft::TextureBundleMapping mapping{};
+                std::strncpy(mapping.blockType, info.key().c_str(), sizeof(mapping.blockType) - 1);
+                mapping.layer = layer;
+                mapping.face = 6;
+                for (uint32_t face = 0; face < 6; face++)
+                {
+                    if (blockFace == Craft::BLOCK_FACE_NAMES[face]) mapping.face = face;
+                }
+                if (mapping.face == 6)
+                {
+                    std::cerr << "Unknown block face " << blockFace << " in " << filepath << std::endl;
+                    return -1;
+                }
+                mappings.push_back(mapping);
+            }
+        }
+    }
+    if (layer == 0)
+    {
+        std::cerr << "No textures found in " << Craft::TEXTURE_MAPPING_PATH << std::endl;
+        return -1;
+    }
+    header.numLayers = layer;
+
+    std::vector<unsigned char> pixels{};
+    for (const auto& level: levels)
+    {
+        for (const auto& layerPixels: level)
+        {
+            pixels.insert(pixels.end(), layerPixels.begin(), layerPixels.end());
+        }
+    }
+    if (!Craft::writeTextureBundle(root / outputPath, header, sources, mappings, pixels))
+    {
+        return -1;
+    }
+    std::cout << "Packed " << header.numLayers << " textures (" << header.width << "x" << header.height << ", "
+              << header.numMips << " mips, " << mappings.size() << " block faces, " << pixels.size() << " bytes) into "
+              << outputPath << std::endl;
+    return 0;
+}